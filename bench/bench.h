@@ -0,0 +1,53 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace bench {
+
+// Keep a result alive so the optimiser cannot drop the work producing it
+inline void doNotOptimize(double value) {
+    asm volatile("" : : "g"(value) : "memory");
+}
+
+// Best-of-`runs` wall time of fn(), in nanoseconds per item
+template <typename Fn>
+double nsPerItem(Fn&& fn, size_t items, int runs) {
+    double best = 0.0;
+    for (int r = 0; r < runs; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        if (r == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    return items > 0 ? best / static_cast<double>(items) : 0.0;
+}
+
+// One result line: name, ns/item, and an optional note
+void report(const std::string& name, double nsPerItem, const std::string& note = "");
+
+// Deterministic random-walk bars with a plausible high/low/volume shape
+std::vector<data::OHLCV> syntheticBars(size_t count, uint64_t seed = 42);
+
+// Suites
+void runIndicatorBenchmarks(size_t bars, int runs);
+void runRollingWindowBenchmarks(size_t bars, int runs);
+void runSignalBenchmarks(size_t bars, int runs);
+void runEnsembleBenchmarks(size_t bars, int runs);
+void runLiveBenchmarks(size_t bars, int runs);
+void runReductionBenchmarks(size_t bars, int runs);
+void runValidationBenchmarks(size_t bars, int runs);
+void runCompressionBenchmarks(size_t bars, int runs);
+void runSchedulerBenchmarks(size_t bars, int runs);
+void runLeaderboardBenchmarks(size_t bars, int runs);
+void runStressBenchmarks(size_t bars, int runs);
+void runSweepBenchmarks(size_t bars, int runs);
+
+} // namespace bench
+} // namespace crypto
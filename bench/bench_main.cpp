@@ -0,0 +1,107 @@
+#include "bench.h"
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+
+namespace crypto {
+namespace bench {
+
+void report(const std::string& name, double nsPerItem, const std::string& note) {
+    std::printf("  %-40s %10.2f ns/bar  %s\n", name.c_str(), nsPerItem, note.c_str());
+}
+
+std::vector<data::OHLCV> syntheticBars(size_t count, uint64_t seed) {
+    // SplitMix64 for reproducible noise without <random> distribution differences
+    auto next = [&seed]() {
+        uint64_t z = (seed += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<double>((z ^ (z >> 31)) >> 11) * 0x1.0p-53;
+    };
+
+    std::vector<data::OHLCV> bars(count);
+    double price = 100.0;
+    for (size_t i = 0; i < count; ++i) {
+        double open = price;
+        price *= std::exp((next() - 0.5) * 0.04);
+        double high = std::max(open, price) * (1.0 + next() * 0.01);
+        double low = std::min(open, price) * (1.0 - next() * 0.01);
+        double volume = 10.0 + next() * 90.0;
+
+        data::OHLCV& bar = bars[i];
+        bar.unix_time = static_cast<int64_t>(1500000000 + i * 86400);
+        bar.open = open;
+        bar.high = high;
+        bar.low = low;
+        bar.close = price;
+        bar.volume_btc = volume;
+        bar.volume_usd = volume * (high + low + price) / 3.0;
+    }
+    return bars;
+}
+
+} // namespace bench
+} // namespace crypto
+
+int main(int argc, char* argv[]) {
+    size_t bars = 1000000;
+    int runs = 5;
+    std::string suite = "all";
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bars" && i + 1 < argc) {
+            bars = std::stoul(argv[++i]);
+        } else if (arg == "--runs" && i + 1 < argc) {
+            runs = std::stoi(argv[++i]);
+        } else if (arg == "--help" || arg == "-h") {
+            std::cout << "Usage: " << argv[0] << " [suite] [--bars N] [--runs N]\n"
+                      << "  suites: all, indicators, rolling, signals, ensemble, live, reduction, validation,\n"
+                      << "          compression, scheduler, leaderboard, stress, sweep\n";
+            return 0;
+        } else {
+            suite = arg;
+        }
+    }
+
+    std::cout << "Benchmarks over " << bars << " bars, best of " << runs << " runs\n";
+
+    if (suite == "all" || suite == "indicators") {
+        crypto::bench::runIndicatorBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "rolling") {
+        crypto::bench::runRollingWindowBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "signals") {
+        crypto::bench::runSignalBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "ensemble") {
+        crypto::bench::runEnsembleBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "live") {
+        crypto::bench::runLiveBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "reduction") {
+        crypto::bench::runReductionBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "validation") {
+        crypto::bench::runValidationBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "compression") {
+        crypto::bench::runCompressionBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "scheduler") {
+        crypto::bench::runSchedulerBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "leaderboard") {
+        crypto::bench::runLeaderboardBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "stress") {
+        crypto::bench::runStressBenchmarks(bars, runs);
+    }
+    if (suite == "all" || suite == "sweep") {
+        crypto::bench::runSweepBenchmarks(bars, runs);
+    }
+    return 0;
+}
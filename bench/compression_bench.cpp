@@ -0,0 +1,157 @@
+#include "bench.h"
+#include "backtester/compressed_backtest.h"
+#include "data/compressed_bars.h"
+#include "strategies/strategy_factory.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// Minute bars as an exchange prints them: the synthetic walk's moves scaled
+// down to minute size around a mean-reverting level near 30000, prices in
+// cents, volume to 1e-4, and quote volume derived from the close as the
+// loader does. (The raw synthetic walk drifts to fractions of a cent over a
+// million bars, which would flatter the codec.)
+std::vector<data::OHLCV> printedBars(size_t count) {
+    std::vector<data::OHLCV> bars = syntheticBars(count);
+    auto cents = [](double value) { return std::round(value * 100.0) / 100.0; };
+    double level = 0.0;
+    double previousClose = 30000.0;
+    for (size_t i = 0; i < bars.size(); ++i) {
+        data::OHLCV& bar = bars[i];
+        double top = std::max(bar.open, bar.close);
+        double bottom = std::min(bar.open, bar.close);
+        double highExcess = (bar.high / top - 1.0) * 0.05;
+        double lowExcess = (1.0 - bar.low / bottom) * 0.05;
+        level = 0.9995 * level + std::log(bar.close / bar.open) * 0.05;
+
+        bar.unix_time = 1500000000 + static_cast<int64_t>(i) * 60;
+        bar.open = previousClose;
+        bar.close = cents(30000.0 * std::exp(level));
+        bar.high = cents(std::max(bar.open, bar.close) * (1.0 + highExcess));
+        bar.low = cents(std::min(bar.open, bar.close) * (1.0 - lowExcess));
+        bar.volume_btc = std::round(bar.volume_btc * 1e4) / 1e4;
+        bar.volume_usd = bar.volume_btc * bar.close;
+        previousClose = bar.close;
+    }
+    return bars;
+}
+
+bool sameBars(const std::vector<data::OHLCV>& a, const std::vector<data::OHLCV>& b) {
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(data::OHLCV)) == 0);
+}
+
+} // namespace
+
+void runCompressionBenchmarks(size_t count, int runs) {
+    std::cout << "\n[compression]\n";
+
+    data::DataLoader loader("");
+    loader.setData(printedBars(count));
+    const auto& bars = loader.getData();
+
+    data::CompressedBars compressed;
+    double ns = nsPerItem([&] { compressed = data::CompressedBars::compress(bars); }, bars.size(), runs);
+    char note[128];
+    std::snprintf(note, sizeof(note), "(%.1f MB -> %.1f MB, %.2f bytes/bar, %.1fx)",
+                  compressed.rawBytes() / 1e6, compressed.bytes() / 1e6,
+                  static_cast<double>(compressed.bytes()) / bars.size(),
+                  static_cast<double>(compressed.rawBytes()) / compressed.bytes());
+    report("compress", ns, note);
+
+    std::vector<data::OHLCV> restored = compressed.decompress();
+    report("decompress", nsPerItem([&] { restored = compressed.decompress(); }, bars.size(), runs),
+           sameBars(bars, restored) ? "(lossless)" : "(MISMATCH vs input)");
+    restored = std::vector<data::OHLCV>();
+
+    // Scan throughput: every column, then closes only, against the raw bars
+    double sum = 0.0;
+    ns = nsPerItem([&] {
+        sum = 0.0;
+        for (const auto& bar : bars) {
+            sum += bar.open + bar.high + bar.low + bar.close + bar.volume_btc + bar.volume_usd;
+        }
+    }, bars.size(), runs);
+    doNotOptimize(sum);
+    report("scan raw, all columns", ns);
+
+    data::BarBlock block;
+    ns = nsPerItem([&] {
+        sum = 0.0;
+        for (size_t b = 0; b < compressed.blockCount(); ++b) {
+            compressed.decodeBlock(b, block);
+            for (size_t i = 0; i < block.count; ++i) {
+                sum += block.open[i] + block.high[i] + block.low[i] + block.close[i] + block.volume[i] + block.volumeUsd[i];
+            }
+        }
+    }, bars.size(), runs);
+    doNotOptimize(sum);
+    report("scan compressed, all columns", ns);
+
+    data::EMAStream ema(20);
+    ns = nsPerItem([&] {
+        ema.reset();
+        for (const auto& bar : bars) {
+            ema.update(bar.close);
+        }
+    }, bars.size(), runs);
+    double rawEma = ema.value();
+    report("EMA(20) raw closes", ns);
+
+    ns = nsPerItem([&] {
+        ema.reset();
+        for (size_t b = 0; b < compressed.blockCount(); ++b) {
+            size_t n = compressed.decodeCloses(b, block.close.data());
+            for (size_t i = 0; i < n; ++i) {
+                ema.update(block.close[i]);
+            }
+        }
+    }, bars.size(), runs);
+    report("EMA(20) compressed closes", ns, ema.value() == rawEma ? "(matches raw)" : "(MISMATCH vs raw)");
+
+    // Backtests from the compressed bars against Strategy::backtest on the raw ones
+    const std::vector<strategies::StrategySpec> specs = {
+        {"sma", {20, 50}},
+        {"rsi", {14, 30, 70}},
+        {"bb", {20, 2.0}}
+    };
+    std::vector<std::shared_ptr<strategies::Strategy>> strategies;
+    for (const auto& spec : specs) {
+        strategies.push_back(strategies::createStrategy(spec));
+        strategies.back()->setVerbose(false);
+        for (const auto& request : strategies.back()->requiredIndicators()) {
+            loader.addIndicator(request);
+        }
+    }
+
+    ns = nsPerItem([&] {
+        for (auto& strategy : strategies) {
+            strategy->backtest(loader);
+        }
+    }, bars.size() * strategies.size(), runs);
+    report("backtest raw (signals + positions)", ns, "(indicators precomputed)");
+
+    std::vector<backtester::CompressedBacktestResult> results;
+    ns = nsPerItem([&] { results = backtester::backtestCompressed(strategies, compressed); },
+                   bars.size() * strategies.size(), runs);
+    bool same = true;
+    for (size_t s = 0; s < strategies.size(); ++s) {
+        double a[backtester::kNumMetricFields];
+        double b[backtester::kNumMetricFields];
+        backtester::metricsToArray(strategies[s]->getMetrics(), a);
+        backtester::metricsToArray(results[s].metrics, b);
+        same = same && std::memcmp(a, b, sizeof(a)) == 0 &&
+               results[s].finalEquity == strategies[s]->getEquityCurve().back();
+    }
+    report("backtest compressed (indicators streamed)", ns,
+           same ? "(metrics match Strategy::backtest)" : "(MISMATCH vs Strategy::backtest)");
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,83 @@
+#include "bench.h"
+#include "strategies/ensemble_strategy.h"
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// and(sma, within(k, rsi)) the direct way: regenerate both components and
+// combine them bar by bar on dense signals
+strategies::SignalEvents perBarCombine(const strategies::StrategySpec& sma, const strategies::StrategySpec& rsi,
+                                       int window, const data::DataLoader& loader) {
+    std::vector<strategies::Signal> trend = strategies::createStrategy(sma)->generateSignals(loader).toDense();
+    std::vector<strategies::Signal> confirm = strategies::createStrategy(rsi)->generateSignals(loader).toDense();
+
+    size_t n = trend.size();
+    strategies::SignalEvents events(n);
+    long lastBuy = -1;
+    long lastSell = -1;
+    for (size_t i = 0; i < n; ++i) {
+        if (confirm[i] == strategies::BUY) lastBuy = static_cast<long>(i);
+        if (confirm[i] == strategies::SELL) lastSell = static_cast<long>(i);
+        long earliest = static_cast<long>(i) - window;
+        if (trend[i] == strategies::BUY && lastBuy >= earliest && lastBuy >= 0) {
+            events.add(i, strategies::BUY);
+        } else if (trend[i] == strategies::SELL && lastSell >= earliest && lastSell >= 0) {
+            events.add(i, strategies::SELL);
+        }
+    }
+    return events;
+}
+
+} // namespace
+
+void runEnsembleBenchmarks(size_t count, int runs) {
+    std::cout << "\n[ensemble]\n";
+
+    const int window = 3;
+    std::vector<strategies::StrategySpec> specs;
+    std::vector<strategies::SignalExpr> expressions;
+    strategies::parseSignalExpression("and(sma(5..50/5, 100..300/50), within(3, rsi(7..21/7, 20..35/5, 65..80/5)))",
+                                      expressions);
+
+    data::DataLoader loader("");
+    loader.setData(syntheticBars(count));
+    for (const auto& expression : expressions) {
+        specs.push_back({"ensemble", {}, expression.toString()});
+        for (const auto& request : strategies::createStrategy(specs.back())->requiredIndicators()) {
+            loader.addIndicator(request);
+        }
+    }
+
+    std::vector<strategies::SignalEvents> direct(expressions.size());
+    double nsDirect = nsPerItem([&] {
+        for (size_t e = 0; e < expressions.size(); ++e) {
+            const auto& children = expressions[e].children;
+            direct[e] = perBarCombine(children[0].spec, children[1].children[0].spec, window, loader);
+        }
+    }, expressions.size() * count, runs);
+
+    std::vector<strategies::SignalEvents> combined(expressions.size());
+    std::shared_ptr<strategies::SignalCache> cache;
+    double nsShared = nsPerItem([&] {
+        cache = std::make_shared<strategies::SignalCache>();
+        for (size_t e = 0; e < expressions.size(); ++e) {
+            combined[e] = strategies::createStrategy(specs[e], cache)->generateSignals(loader);
+        }
+    }, expressions.size() * count, runs);
+
+    bool same = true;
+    for (size_t e = 0; e < expressions.size(); ++e) {
+        same = same && direct[e].toDense() == combined[e].toDense();
+    }
+
+    std::cout << "  " << expressions.size() << " combinations of " << cache->size()
+              << " components, " << cache->getHits() << " cache hits" << std::endl;
+    report("regenerate + per-bar combine", nsDirect);
+    report("shared masks + bit algebra", nsShared, same ? "(matches per-bar combine)" : "(MISMATCH vs per-bar combine)");
+}
+
+} // namespace bench
+} // namespace crypto
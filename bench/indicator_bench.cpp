@@ -0,0 +1,124 @@
+#include "bench.h"
+#include "data/indicators.h"
+#include <algorithm>
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// Batch and streaming forms (and the rescan reference) must agree exactly
+std::string agreement(const std::vector<double>& actual, const std::vector<double>& expected,
+                      const std::string& reference = "streaming") {
+    return actual == expected ? "(matches " + reference + ")" : "(MISMATCH vs " + reference + ")";
+}
+
+// Reference %K that rescans the window at every bar: O(n x window)
+std::vector<double> naiveStochasticK(const data::OHLCVColumns& bars, int period) {
+    std::vector<double> k(bars.size(), 0.0);
+    for (size_t i = period - 1; i < bars.size(); ++i) {
+        double highest = bars.high[i];
+        double lowest = bars.low[i];
+        for (size_t j = i + 1 - period; j < i; ++j) {
+            highest = std::max(highest, bars.high[j]);
+            lowest = std::min(lowest, bars.low[j]);
+        }
+        double range = highest - lowest;
+        k[i] = range > 0.0 ? 100.0 * (bars.close[i] - lowest) / range : 50.0;
+    }
+    return k;
+}
+
+} // namespace
+
+void runIndicatorBenchmarks(size_t count, int runs) {
+    std::cout << "\n[indicators]\n";
+
+    data::OHLCVColumns bars = data::OHLCVColumns::fromBars(syntheticBars(count));
+    size_t n = bars.size();
+
+    // MACD
+    data::MACDSeries macd;
+    double ns = nsPerItem([&] { macd = data::computeMACD(bars.close); }, n, runs);
+    std::vector<double> streamed(n);
+    double nsStream = nsPerItem([&] {
+        data::MACDStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.close[i]).histogram;
+    }, n, runs);
+    report("MACD(12,26,9) batch", ns, agreement(macd.histogram, streamed));
+    report("MACD(12,26,9) streaming", nsStream);
+
+    // ATR
+    std::vector<double> atr;
+    ns = nsPerItem([&] { atr = data::computeATR(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::ATRStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.high[i], bars.low[i], bars.close[i]);
+    }, n, runs);
+    report("ATR(14) batch", ns, agreement(atr, streamed));
+    report("ATR(14) streaming", nsStream);
+
+    // VWAP
+    std::vector<double> vwap;
+    ns = nsPerItem([&] { vwap = data::computeVWAP(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::VWAPStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.close[i], bars.volume[i], bars.volumeUsd[i]);
+    }, n, runs);
+    report("VWAP(20) batch", ns, agreement(vwap, streamed));
+    report("VWAP(20) streaming", nsStream);
+
+    // Stochastic, against a rescanning reference
+    data::StochasticSeries stochastic;
+    ns = nsPerItem([&] { stochastic = data::computeStochastic(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::StochasticStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.high[i], bars.low[i], bars.close[i]).k;
+    }, n, runs);
+    report("Stochastic(14,3) batch", ns, agreement(stochastic.k, streamed));
+    report("Stochastic(14,3) streaming", nsStream);
+    for (int period : {14, 200}) {
+        std::vector<double> naive;
+        double nsNaive = nsPerItem([&] { naive = naiveStochasticK(bars, period); }, n, runs);
+        double nsDeque = nsPerItem([&] { stochastic = data::computeStochastic(bars, period); }, n, runs);
+        std::string label = "Stochastic %K(" + std::to_string(period) + ")";
+        report(label + " rescan", nsNaive);
+        report(label + " monotonic deque", nsDeque, agreement(stochastic.k, naive, "rescan"));
+    }
+
+    // ADX
+    data::ADXSeries adx;
+    ns = nsPerItem([&] { adx = data::computeADX(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::ADXStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.high[i], bars.low[i], bars.close[i]).adx;
+    }, n, runs);
+    report("ADX(14) batch", ns, agreement(adx.adx, streamed));
+    report("ADX(14) streaming", nsStream);
+
+    // Donchian
+    data::DonchianSeries donchian;
+    ns = nsPerItem([&] { donchian = data::computeDonchian(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::DonchianStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.high[i], bars.low[i]).upper;
+    }, n, runs);
+    report("Donchian(20) batch", ns, agreement(donchian.upper, streamed));
+    report("Donchian(20) streaming", nsStream);
+
+    // OBV
+    std::vector<double> obv;
+    ns = nsPerItem([&] { obv = data::computeOBV(bars); }, n, runs);
+    nsStream = nsPerItem([&] {
+        data::OBVStream stream;
+        for (size_t i = 0; i < n; ++i) streamed[i] = stream.update(bars.close[i], bars.volume[i]);
+    }, n, runs);
+    report("OBV batch", ns, agreement(obv, streamed));
+    report("OBV streaming", nsStream);
+
+    doNotOptimize(macd.line.back() + atr.back() + vwap.back() + adx.adx.back() + donchian.lower.back() + obv.back());
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,81 @@
+#include "bench.h"
+#include "backtester/leaderboard.h"
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace crypto {
+namespace bench {
+
+void runLeaderboardBenchmarks(size_t count, int runs) {
+    std::cout << "\n[leaderboard]\n";
+
+    // One metrics record per parameter set of a large sweep
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> sharpe(0.3, 0.4);
+    std::uniform_real_distribution<double> drawdown(5.0, 90.0);
+    std::vector<backtester::PerformanceMetrics> results(count);
+    for (auto& metrics : results) {
+        metrics.sharpeRatio = sharpe(rng);
+        metrics.maxDrawdown = drawdown(rng);
+        metrics.totalReturn = metrics.sharpeRatio * 100.0 - metrics.maxDrawdown * 0.5 + sharpe(rng) * 20.0;
+    }
+    const std::string name = "SMA Crossover 20/50";
+    const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    const size_t topK = 100;
+
+    auto inParallel = [&](auto&& offer) {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (size_t i = t; i < results.size(); i += threads) {
+                    offer(i);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    };
+
+    // Baseline: one mutex-guarded heap every result goes through
+    double ns = nsPerItem([&] {
+        std::mutex mutex;
+        std::vector<std::pair<double, size_t>> heap;
+        auto order = [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+            return a.first > b.first;
+        };
+        inParallel([&](size_t i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            heap.emplace_back(results[i].sharpeRatio, i);
+            std::push_heap(heap.begin(), heap.end(), order);
+            if (heap.size() > topK) {
+                std::pop_heap(heap.begin(), heap.end(), order);
+                heap.pop_back();
+            }
+        });
+        doNotOptimize(heap.front().first);
+    }, count, runs);
+    report("locked heap, top " + std::to_string(topK) + ", " + std::to_string(threads) + " threads", ns, "(ns/result)");
+
+    for (bool pareto : {false, true}) {
+        size_t front = 0;
+        ns = nsPerItem([&] {
+            backtester::Leaderboard board(topK, "Sharpe Ratio", pareto);
+            inParallel([&](size_t i) {
+                board.offer(i, name, results[i]);
+            });
+            board.collect();
+            front = board.paretoFront().size();
+            doNotOptimize(board.snapshot().front().metrics.sharpeRatio);
+        }, count, runs);
+        report(std::string("leaderboard") + (pareto ? " + Pareto" : "") + ", top " + std::to_string(topK) + ", " +
+               std::to_string(threads) + " threads", ns,
+               pareto ? "(ns/result, " + std::to_string(front) + " on the front)" : "(ns/result)");
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,54 @@
+#include "bench.h"
+#include "strategies/strategy_factory.h"
+#include "utils/latency_histogram.h"
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+void runLiveBenchmarks(size_t count, int runs) {
+    std::cout << "\n[live]\n";
+
+    data::DataLoader loader("");
+    loader.setData(syntheticBars(count));
+    const auto& bars = loader.getData();
+
+    const std::vector<strategies::StrategySpec> specs = {
+        {"sma", {20, 50}},
+        {"rsi", {14, 30, 70}},
+        {"bb", {20, 2.0}},
+        {"ensemble", {}, "vote(2, 2*sma(20, 50), rsi(14, 30, 70), bb(20, 2))"}
+    };
+
+    for (const auto& spec : specs) {
+        auto strategy = strategies::createStrategy(spec);
+        for (const auto& request : strategy->requiredIndicators()) {
+            loader.addIndicator(request);
+        }
+        std::vector<strategies::Signal> batch = strategy->generateSignals(loader).toDense();
+
+        std::vector<strategies::Signal> streamed(bars.size());
+        double ns = nsPerItem([&] {
+            auto stream = strategy->createSignalStream();
+            for (size_t i = 0; i < bars.size(); ++i) {
+                streamed[i] = stream->update(bars[i]);
+            }
+        }, bars.size(), runs);
+
+        report(strategies::formatSpec(spec) + " stream", ns,
+               streamed == batch ? "(matches generateSignals)" : "(MISMATCH vs generateSignals)");
+    }
+
+    utils::LatencyHistogram histogram;
+    double ns = nsPerItem([&] {
+        histogram.reset();
+        for (size_t i = 0; i < bars.size(); ++i) {
+            histogram.record(i * 37 % 1000003);
+        }
+    }, bars.size(), runs);
+    doNotOptimize(static_cast<double>(histogram.percentile(0.999)));
+    report("latency histogram record", ns);
+}
+
+} // namespace bench
+} // namespace crypto
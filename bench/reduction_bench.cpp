@@ -0,0 +1,76 @@
+#include "bench.h"
+#include "backtester/performance_metrics.h"
+#include "utils/reduction.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <numeric>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+bool sameBits(double a, double b) {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+} // namespace
+
+void runReductionBenchmarks(size_t count, int runs) {
+    std::cout << "\n[reduction]\n";
+
+    // Returns of a synthetic equity curve: small values of mixed sign
+    std::vector<data::OHLCV> bars = syntheticBars(count);
+    std::vector<double> returns(bars.size() - 1);
+    for (size_t i = 1; i < bars.size(); ++i) {
+        returns[i - 1] = bars[i].close / bars[i - 1].close - 1.0;
+    }
+    const double* r = returns.data();
+    auto term = [r](size_t i) { return r[i]; };
+    size_t n = returns.size();
+
+    double serial = 0.0;
+    double ns = nsPerItem([&] { serial = std::accumulate(returns.begin(), returns.end(), 0.0); }, n, runs);
+    doNotOptimize(serial);
+    report("std::accumulate", ns);
+
+    for (auto mode : {utils::ReductionMode::Fast, utils::ReductionMode::Reproducible}) {
+        const char* name = mode == utils::ReductionMode::Fast ? "fast" : "reproducible";
+        double reference = 0.0;
+        for (size_t threads : {1, 2, 4, 8}) {
+            std::unique_ptr<utils::ThreadPool> pool;
+            if (threads > 1) {
+                pool = std::make_unique<utils::ThreadPool>(threads);
+            }
+            double sum = 0.0;
+            ns = nsPerItem([&] { sum = utils::parallelSum(n, term, mode, pool.get()); }, n, runs);
+            if (threads == 1) {
+                reference = sum;
+            }
+
+            std::string note;
+            if (threads > 1) {
+                note = sameBits(sum, reference) ? "(same bits as 1 thread)" : "(differs from 1 thread)";
+            }
+            report(std::string(name) + " sum, " + std::to_string(threads) + " thread(s)", ns, note);
+        }
+    }
+
+    // Full two-pass statistics, as an auditor would rerun them
+    std::vector<double> equity(bars.size());
+    for (size_t i = 0; i < bars.size(); ++i) {
+        equity[i] = bars[i].close;
+    }
+    utils::ThreadPool pool(4);
+    for (auto mode : {utils::ReductionMode::Fast, utils::ReductionMode::Reproducible}) {
+        backtester::ReturnStatistics stats;
+        ns = nsPerItem([&] { stats = backtester::calculateReturnStatistics(equity, mode, &pool); }, n, runs);
+        doNotOptimize(stats.stdDev);
+        report(std::string(mode == utils::ReductionMode::Fast ? "fast" : "reproducible") +
+               " return statistics, 4 threads", ns);
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "data/rolling_window.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// Keep the O(n x window) references to roughly 2e8 element visits
+size_t naiveBars(size_t bars, int window) {
+    return std::min(bars, std::max<size_t>(1000, 200000000 / static_cast<size_t>(window)));
+}
+
+std::vector<double> rescanMax(const std::vector<double>& values, size_t count, int window) {
+    std::vector<double> out(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t start = i + 1 >= static_cast<size_t>(window) ? i + 1 - window : 0;
+        out[i] = *std::max_element(values.begin() + start, values.begin() + i + 1);
+    }
+    return out;
+}
+
+// Copy the window and partially sort it at every bar
+std::vector<double> rescanQuantile(const std::vector<double>& values, size_t count, int window, double q) {
+    std::vector<double> out(count);
+    std::vector<double> scratch;
+    for (size_t i = 0; i < count; ++i) {
+        size_t start = i + 1 >= static_cast<size_t>(window) ? i + 1 - window : 0;
+        scratch.assign(values.begin() + start, values.begin() + i + 1);
+        double position = q * (scratch.size() - 1);
+        size_t lower = static_cast<size_t>(std::floor(position));
+        std::nth_element(scratch.begin(), scratch.begin() + lower, scratch.end());
+        double low = scratch[lower];
+        double fraction = position - lower;
+        if (fraction > 0.0 && lower + 1 < scratch.size()) {
+            double high = *std::min_element(scratch.begin() + lower + 1, scratch.end());
+            low += fraction * (high - low);
+        }
+        out[i] = low;
+    }
+    return out;
+}
+
+bool samePrefix(const std::vector<double>& a, const std::vector<double>& b, size_t count) {
+    return std::equal(a.begin(), a.begin() + count, b.begin());
+}
+
+} // namespace
+
+void runRollingWindowBenchmarks(size_t count, int runs) {
+    std::cout << "\n[rolling windows]\n";
+
+    std::vector<data::OHLCV> bars = syntheticBars(count);
+    std::vector<double> closes(bars.size());
+    for (size_t i = 0; i < bars.size(); ++i) {
+        closes[i] = bars[i].close;
+    }
+    size_t n = closes.size();
+
+    for (int window : {14, 200, 2000}) {
+        std::string suffix = "(" + std::to_string(window) + ")";
+
+        // Rolling max
+        std::vector<double> deque(n);
+        double nsDeque = nsPerItem([&] {
+            data::RollingExtremum<std::greater<double>> highest(window);
+            for (size_t i = 0; i < n; ++i) deque[i] = highest.push(closes[i]);
+        }, n, runs);
+        size_t naiveCount = naiveBars(n, window);
+        std::vector<double> naive;
+        double nsNaive = nsPerItem([&] { naive = rescanMax(closes, naiveCount, window); }, naiveCount, runs);
+        report("Rolling max" + suffix + " rescan", nsNaive);
+        report("Rolling max" + suffix + " monotonic deque", nsDeque,
+               samePrefix(deque, naive, naiveCount) ? "(matches rescan)" : "(MISMATCH vs rescan)");
+
+        // Rolling median and 90th percentile
+        for (double q : {0.5, 0.9}) {
+            std::string label = (q == 0.5 ? "Rolling median" : "Rolling p90") + suffix;
+            std::vector<double> skiplist(n);
+            double nsSkiplist = nsPerItem([&] {
+                data::RollingQuantile quantile(window, q);
+                for (size_t i = 0; i < n; ++i) skiplist[i] = quantile.push(closes[i]);
+            }, n, runs);
+            naiveCount = naiveBars(n, window * 4);
+            double nsSort = nsPerItem([&] { naive = rescanQuantile(closes, naiveCount, window, q); }, naiveCount, runs);
+            report(label + " copy + nth_element", nsSort);
+            report(label + " indexable skiplist", nsSkiplist,
+                   samePrefix(skiplist, naive, naiveCount) ? "(matches rescan)" : "(MISMATCH vs rescan)");
+        }
+        doNotOptimize(deque.back());
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,92 @@
+#include "bench.h"
+#include "strategies/strategy_factory.h"
+#include "utils/thread_pool.h"
+#include <cstdio>
+#include <iostream>
+#include <thread>
+
+namespace crypto {
+namespace bench {
+
+void runSchedulerBenchmarks(size_t count, int runs) {
+    std::cout << "\n[scheduler]\n";
+
+    data::DataLoader loader("");
+    loader.setData(syntheticBars(count / 10));
+    const size_t bars = loader.getData().size();
+
+    // A sweep whose jobs differ in cost: rare-trading slow crossovers, busy
+    // short RSIs, and Bollinger bands doing a window query per bar
+    std::vector<strategies::StrategySpec> specs;
+    for (int fast = 5; fast <= 50; fast += 5) {
+        specs.push_back({"sma", {static_cast<double>(fast), 200.0}});
+    }
+    for (int period = 2; period <= 14; period += 2) {
+        specs.push_back({"rsi", {static_cast<double>(period), 45.0, 55.0}});
+    }
+    for (int period = 10; period <= 60; period += 10) {
+        specs.push_back({"bb", {static_cast<double>(period), 2.0}});
+    }
+    std::vector<std::shared_ptr<strategies::Strategy>> strategies;
+    for (const auto& spec : specs) {
+        strategies.push_back(strategies::createStrategy(spec));
+        strategies.back()->setVerbose(false);
+    }
+    std::streambuf* saved = std::cout.rdbuf(nullptr);
+    for (const auto& strategy : strategies) {
+        loader.addIndicators(strategy->requiredIndicators());
+    }
+    std::cout.rdbuf(saved);
+
+    const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    const size_t items = bars * strategies.size();
+
+    // Baseline: each thread takes a contiguous slice of the sweep up front
+    double ns = nsPerItem([&] {
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                size_t first = strategies.size() * t / threads;
+                size_t last = strategies.size() * (t + 1) / threads;
+                for (size_t s = first; s < last; ++s) {
+                    strategies[s]->backtest(loader);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }, items, runs);
+    report("static split, " + std::to_string(threads) + " threads", ns);
+
+    utils::ThreadPool pool(threads);
+    pool.resetStats();
+    ns = nsPerItem([&] {
+        for (auto& strategy : strategies) {
+            pool.submit([&strategy, &loader] { strategy->backtest(loader); });
+        }
+        pool.wait();
+    }, items, runs);
+    uint64_t stolen = 0;
+    for (const auto& worker : pool.stats()) {
+        stolen += worker.stolen;
+    }
+    char note[96];
+    std::snprintf(note, sizeof(note), "(%.0f%% utilisation, %llu of %zu tasks stolen)",
+                  pool.utilisation() * 100.0, static_cast<unsigned long long>(stolen),
+                  strategies.size() * static_cast<size_t>(runs));
+    report("work stealing, " + std::to_string(threads) + " threads", ns, note);
+
+    // Scheduling overhead alone: empty tasks
+    const size_t tasks = 100000;
+    ns = nsPerItem([&] {
+        for (size_t t = 0; t < tasks; ++t) {
+            pool.submit([] {});
+        }
+        pool.wait();
+    }, tasks, runs);
+    report("submit + run empty task", ns, "(ns/task)");
+}
+
+} // namespace bench
+} // namespace crypto
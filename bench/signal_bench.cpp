@@ -0,0 +1,71 @@
+#include "bench.h"
+#include "strategies/position_engine.h"
+#include "strategies/sma_strategy.h"
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// The previous engine's shape: visit every bar, carry the position over
+// HOLD bars one at a time (long-flat, fixed size)
+void perBarScan(const std::vector<double>& closes, const std::vector<strategies::Signal>& signals,
+                std::vector<double>& units, std::vector<double>& cash) {
+    size_t n = closes.size();
+    units.assign(n, 0.0);
+    cash.assign(n, 10000.0);
+    double held = 0.0;
+    double money = 10000.0;
+    for (size_t i = 1; i < n; ++i) {
+        if (signals[i] == strategies::BUY && held == 0.0) {
+            double amount = money * 0.95;
+            held = amount / closes[i];
+            money -= amount;
+        } else if (signals[i] == strategies::SELL && held > 0.0) {
+            money += held * closes[i];
+            held = 0.0;
+        }
+        units[i] = held;
+        cash[i] = money;
+    }
+}
+
+} // namespace
+
+void runSignalBenchmarks(size_t count, int runs) {
+    std::cout << "\n[signals]\n";
+
+    data::DataLoader loader("");
+    loader.setData(syntheticBars(count));
+    std::vector<double> closes = loader.getColumns().close;
+    size_t n = closes.size();
+
+    for (auto periods : {std::make_pair(5, 20), std::make_pair(20, 50), std::make_pair(50, 200)}) {
+        loader.addSMA(periods.first);
+        loader.addSMA(periods.second);
+        strategies::SMAStrategy strategy(periods.first, periods.second);
+        strategies::SignalEvents events = strategy.generateSignals(loader);
+        std::vector<strategies::Signal> dense = events.toDense();
+
+        std::string label = "SMA " + std::to_string(periods.first) + "/" + std::to_string(periods.second);
+        std::cout << "  " << label << ": " << events.count() << " events, "
+                  << dense.size() * sizeof(strategies::Signal) << " bytes dense vs "
+                  << events.memoryBytes() << " bytes sparse" << std::endl;
+
+        std::vector<double> units;
+        std::vector<double> cash;
+        double nsDense = nsPerItem([&] { perBarScan(closes, dense, units, cash); }, n, runs);
+
+        strategies::PositionConfig config;
+        strategies::PositionEngine engine(config, 10000.0, 0.95);
+        double nsSparse = nsPerItem([&] { engine.run(closes, events); }, n, runs);
+
+        bool same = engine.getUnits() == units && engine.getCash() == cash;
+        report(label + " per-bar scan", nsDense);
+        report(label + " event jumps", nsSparse, same ? "(matches per-bar scan)" : "(MISMATCH vs per-bar scan)");
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,28 @@
+#include "bench.h"
+#include "data/synthetic_paths.h"
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+void runStressBenchmarks(size_t count, int runs) {
+    std::cout << "\n[stress]\n";
+
+    const auto history = syntheticBars(count);
+    data::PathGenerator generator(history);
+    std::vector<data::OHLCV> path;
+
+    const data::PathModel models[] = {data::PathModel::GBM, data::PathModel::GARCH,
+                                      data::PathModel::RegimeSwitching, data::PathModel::BlockBootstrap};
+    for (data::PathModel model : models) {
+        uint64_t seed = 1;
+        double ns = nsPerItem([&] {
+            generator.generate(model, seed++, count, path);
+            doNotOptimize(path.back().close);
+        }, count, runs);
+        report(std::string("generate ") + data::pathModelName(model), ns);
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,53 @@
+#include "bench.h"
+#include "backtester/distributed_sweep.h"
+#include <cstdio>
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+void runSweepBenchmarks(size_t count, int runs) {
+    std::cout << "\n[sweep]\n";
+
+    data::DataLoader loader("");
+    loader.setData(syntheticBars(count / 10));
+    const size_t bars = loader.getData().size();
+
+    std::vector<strategies::StrategySpec> grid;
+    strategies::parseGrid("sma:5..50/5,50..200/25", grid);
+    const size_t items = bars * grid.size();
+
+    // The same grid clean, then with every third shard's worker crashing on
+    // its first attempt, so the cost of retrying on a fresh worker shows up
+    for (int failEvery : {0, 3}) {
+        backtester::SweepOptions options;
+        options.workers = 4;
+        options.failEveryNthShard = failEvery;
+
+        size_t shards = 0;
+        int retried = 0;
+        size_t failed = 0;
+        std::streambuf* saved = std::cout.rdbuf(nullptr);
+        std::streambuf* savedErr = std::cerr.rdbuf(nullptr);
+        double ns = nsPerItem([&] {
+            backtester::SweepCoordinator coordinator(loader, options);
+            doNotOptimize(static_cast<double>(coordinator.run(grid).size()));
+            shards = coordinator.getShardStats().size();
+            retried = 0;
+            failed = 0;
+            for (const auto& shard : coordinator.getShardStats()) {
+                retried += shard.attempts > 1 ? 1 : 0;
+                failed += shard.failed ? 1 : 0;
+            }
+        }, items, runs);
+        std::cerr.rdbuf(savedErr);
+        std::cout.rdbuf(saved);
+
+        char note[96];
+        std::snprintf(note, sizeof(note), "(%zu shards, %d retried, %zu failed)", shards, retried, failed);
+        report(failEvery == 0 ? "4 workers" : "4 workers, every 3rd shard crashes once", ns, note);
+    }
+}
+
+} // namespace bench
+} // namespace crypto
@@ -0,0 +1,88 @@
+#include "bench.h"
+#include "data/data_validation.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+namespace crypto {
+namespace bench {
+
+namespace {
+
+// Bars with the faults of a real dump: every 1000th bar repeated, every
+// 5000th missing, every 2000th a spike that reverts on the next bar
+std::vector<data::OHLCV> faultyBars(size_t count) {
+    std::vector<data::OHLCV> clean = syntheticBars(count);
+    std::vector<data::OHLCV> bars;
+    bars.reserve(count + count / 1000);
+    for (size_t i = 0; i < clean.size(); ++i) {
+        data::OHLCV bar = clean[i];
+        if (i % 5000 == 4999) {
+            continue;
+        }
+        if (i % 2000 == 1999) {
+            bar.close *= 3.0;
+            bar.high = bar.close;
+        }
+        bars.push_back(bar);
+        if (i % 1000 == 999) {
+            bars.push_back(bar);
+        }
+    }
+    return bars;
+}
+
+} // namespace
+
+void runValidationBenchmarks(size_t count, int runs) {
+    std::cout << "\n[validation]\n";
+
+    std::vector<data::OHLCV> bars = faultyBars(count);
+    std::string path = (std::filesystem::temp_directory_path() / "backtester_validation_bench.csv").string();
+    {
+        std::ofstream file(path);
+        file << data::CsvSchema::kCanonicalHeader << "\n";
+        for (const auto& bar : bars) {
+            file << data::DataLoader::formatBar(bar) << "\n";
+        }
+    }
+
+    // Whole load with validation off, as the baseline the stage is charged against
+    data::ValidationConfig off;
+    off.outliers = data::OutlierAction::Off;
+    double loadNs = nsPerItem([&] {
+        data::DataLoader loader(path);
+        loader.setValidation(off);
+        std::streambuf* saved = std::cout.rdbuf(nullptr);
+        loader.loadData();
+        std::cout.rdbuf(saved);
+    }, bars.size(), runs);
+    report("load, outliers off", loadNs);
+
+    for (auto action : {data::OutlierAction::Off, data::OutlierAction::Flag, data::OutlierAction::Repair}) {
+        data::ValidationConfig config;
+        config.outliers = action;
+        data::ValidationReport result;
+
+        // Each run validates a fresh copy, made outside the timed region
+        double ns = 0.0;
+        for (int r = 0; r < runs; ++r) {
+            std::vector<data::OHLCV> copy = bars;
+            double runNs = nsPerItem([&] { result = data::validateBars(copy, config); }, bars.size(), 1);
+            ns = r == 0 ? runNs : std::min(ns, runNs);
+        }
+
+        const char* name = action == data::OutlierAction::Off ? "off" :
+                           action == data::OutlierAction::Flag ? "flag" : "repair";
+        char note[128];
+        std::snprintf(note, sizeof(note), "(%.1f%% of load; %zu dupes, %zu gaps, %zu outliers)",
+                      100.0 * ns / loadNs, result.duplicates, result.gaps, result.outliers.size());
+        report(std::string("validate, outliers ") + name, ns, note);
+    }
+
+    std::filesystem::remove(path);
+}
+
+} // namespace bench
+} // namespace crypto
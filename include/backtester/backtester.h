@@ -2,26 +2,76 @@
 
 #include "data/data_loader.h"
 #include "strategies/strategy.h"
+#include "backtester/result_store.h"
+#include "backtester/distributed_sweep.h"
 #include <memory>
 #include <vector>
 #include <string>
 
 namespace crypto {
+namespace utils {
+class ThreadPool;
+}
+
 namespace backtester {
 
 class Backtester {
 public:
-    Backtester(const std::string& dataPath);
+    Backtester(const std::string& dataPath, const data::ValidationConfig& validation = data::ValidationConfig());
     ~Backtester() = default;
     
+    // False when the data failed to load; the backtester must not be run then
+    bool isLoaded() const;
+    
     void addStrategy(std::shared_ptr<strategies::Strategy> strategy);
+    
+    // Publish each strategy into a memory-mapped result file as it finishes.
+    // With selectedOnly, nothing is published until publishSelection().
+    void publishResultsTo(const std::string& storePath, bool selectedOnly = false);
+    
+    // Create the store with one slot per selected strategy (e.g. the
+    // leaderboard's selection) and publish them, so only their curves are rebuilt
+    void publishSelection(const std::vector<size_t>& selection);
+    
+    // Persist indicators under `dir` and reuse them on later runs
+    void setIndicatorCache(const std::string& dir);
+    
     void run(double initialCapital = 10000.0, double positionSize = 1.0);
+    
+    // run() in two steps, so strategies can be scheduled individually:
+    // prepare() computes the deduplicated indicators and opens the result
+    // store; runStrategy() may then be called concurrently for distinct indices.
+    // With a pool, indicators are computed as tasks on it, preferring `node`.
+    void prepare(double initialCapital = 10000.0, double positionSize = 1.0,
+                 utils::ThreadPool* pool = nullptr, int node = -1);
+    void runStrategy(size_t index);
+    size_t getStrategyCount() const;
+    std::shared_ptr<strategies::Strategy> getStrategy(size_t index) const;
+    const data::DataLoader& getDataLoader() const;
+    
     void compareStrategies() const;
-    void exportResults(const std::string& outputDir = ".") const;
+    // Per-strategy files are written as tasks on `pool` when given. With a
+    // selection (ascending strategy indices, e.g. Leaderboard::selection())
+    // only those strategies are compared and written.
+    void exportResults(const std::string& outputDir = ".", utils::ThreadPool* pool = nullptr, int node = -1,
+                       const std::vector<size_t>* selection = nullptr) const;
+    
+    // Run every spec of a parameter grid across worker processes
+    std::vector<SweepResult> runSweep(const std::vector<strategies::StrategySpec>& grid,
+                                      const SweepOptions& options);
+    void exportSweepResults(const std::vector<SweepResult>& results, const std::string& outputDir = ".") const;
 
 private:
+    bool exportStrategy(const strategies::Strategy& strategy, const std::string& filename) const;
+    
     data::DataLoader m_dataLoader;
     std::vector<std::shared_ptr<strategies::Strategy>> m_strategies;
+    double m_initialCapital;
+    double m_positionSize;
+    bool m_loaded;
+    std::string m_storePath;
+    bool m_publishSelected = false;
+    ResultStore m_resultStore;
 };
 
 } // namespace backtester
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "backtester/performance_metrics.h"
+#include "data/compressed_bars.h"
+#include "strategies/strategy.h"
+#include <memory>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+struct CompressedBacktestResult {
+    PerformanceMetrics metrics;
+    std::vector<strategies::Trade> trades;
+    double finalEquity = 0.0;
+};
+
+// Backtests every strategy in one pass over a compressed series. Each block
+// is decoded once into a reused BarBlock and fed bar by bar to every
+// strategy's SignalStream, a PositionEngine stepped incrementally and one
+// lane of a shared MetricsAccumulator, so nothing per bar is kept and peak
+// memory is the compressed bars plus one block. Results match
+// Strategy::backtest on the decompressed bars exactly.
+std::vector<CompressedBacktestResult> backtestCompressed(
+    const std::vector<std::shared_ptr<strategies::Strategy>>& strategies,
+    const data::CompressedBars& bars, double initialCapital = 10000.0, double positionSize = 1.0);
+
+} // namespace backtester
+} // namespace crypto
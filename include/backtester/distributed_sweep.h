@@ -0,0 +1,107 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include "strategies/strategy_factory.h"
+#include "backtester/performance_metrics.h"
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+
+namespace crypto {
+namespace backtester {
+
+struct SweepOptions {
+    int workers;              // Worker processes; 0 runs every shard in-process
+    size_t shardSize;         // Specs per shard; 0 picks ~4 shards per worker
+    int maxRetries;           // Re-dispatches of a shard after its worker dies
+    double initialCapital;
+    double positionSize;
+    int failEveryNthShard;    // Fault injection for `backtester_bench sweep`: crash the
+                              // first attempt of every Nth shard
+
+    SweepOptions() :
+        workers(4),
+        shardSize(0),
+        maxRetries(2),
+        initialCapital(10000.0),
+        positionSize(1.0),
+        failEveryNthShard(0) {}
+};
+
+struct SweepResult {
+    strategies::StrategySpec spec;
+    std::string name;
+    PerformanceMetrics metrics;
+};
+
+struct ShardStats {
+    size_t id;
+    std::string type;
+    size_t specs;
+    int attempts;
+    int worker;               // Worker slot that completed the shard, -1 if failed
+    double seconds;           // Wall time measured inside the worker
+    bool failed;
+};
+
+// Backtest `specs` in the calling process; this is what a worker runs per shard
+std::vector<SweepResult> runSpecs(
+    data::DataLoader& data,
+    const std::vector<strategies::StrategySpec>& specs,
+    double initialCapital,
+    double positionSize
+);
+
+// Splits a parameter grid into shards and runs them on forked worker
+// processes connected over Unix socket pairs. Workers are forked after the
+// dataset is loaded, so they share its pages copy-on-write instead of each
+// re-reading the file. Shards are dispatched largest-estimated-cost first,
+// with per-strategy-type cost re-estimated from measured shard times, and a
+// shard whose worker dies is retried on a freshly spawned worker.
+class SweepCoordinator {
+public:
+    SweepCoordinator(data::DataLoader& data, const SweepOptions& options);
+    ~SweepCoordinator();
+
+    std::vector<SweepResult> run(const std::vector<strategies::StrategySpec>& grid);
+
+    const std::vector<ShardStats>& getShardStats() const;
+    void printSummary() const;
+
+private:
+    struct Shard {
+        std::string type;
+        std::vector<size_t> specIndices;
+        int attempts = 0;
+        bool done = false;
+    };
+
+    struct Worker {
+        pid_t pid = -1;
+        int fd = -1;
+        int shard = -1;        // Shard in flight, -1 when idle
+        std::string buffer;    // Partial reply
+    };
+
+    void buildShards(const std::vector<strategies::StrategySpec>& grid);
+    bool spawnWorker(size_t slot);
+    void stopWorker(size_t slot, bool kill);
+    bool dispatch(size_t slot, const std::vector<strategies::StrategySpec>& grid);
+    bool collect(size_t slot, std::vector<SweepResult>& results);
+    void handleFailure(size_t slot);
+    int nextShard() const;
+    double estimatedCost(const Shard& shard) const;
+
+    data::DataLoader& m_data;
+    SweepOptions m_options;
+    std::vector<Shard> m_shards;
+    std::vector<int> m_pending;
+    std::vector<Worker> m_workers;
+    std::vector<ShardStats> m_stats;
+    std::map<std::string, double> m_costPerSpec;   // Measured seconds per spec, by type
+    std::vector<std::vector<SweepResult>> m_shardResults;
+};
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+
+namespace crypto {
+namespace backtester {
+
+struct GoldenOptions {
+    std::string goldenDir;       // Where golden outputs and budgets live
+    std::string dataPath;        // Historical dataset, e.g. data/btc_historical.csv
+    double tolerance;            // Relative tolerance (absolute near zero)
+    double budgetHeadroom;       // Recorded budget = measured ns/bar x headroom
+    int timingRuns;              // Best-of-N timing per stage
+
+    GoldenOptions() :
+        goldenDir("data/golden"),
+        dataPath("data/btc_historical.csv"),
+        tolerance(1e-9),
+        budgetHeadroom(3.0),
+        timingRuns(5) {}
+};
+
+// Run the reference strategies (SMA 20/50, SMA 50/200, RSI 14 30/70,
+// Bollinger 20/2) on the historical dataset and on deterministic synthetic
+// series, and write metrics, equity curves and per-stage ns/bar budgets.
+bool recordGolden(const GoldenOptions& options);
+
+// Re-run the same scenarios and compare against the recorded outputs.
+// Fails on any metric or equity value outside tolerance, on disagreement
+// between Strategy::backtest and calculateMetrics, and on any stage slower
+// than its recorded ns/bar budget.
+bool verifyGolden(const GoldenOptions& options);
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "backtester/performance_metrics.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+struct LeaderboardEntry {
+    size_t id;                  // Caller's index, e.g. the strategy index
+    std::string name;
+    PerformanceMetrics metrics;
+};
+
+// Concurrent top-K of a sweep by one metric, plus the Pareto front over
+// total return, max drawdown and Sharpe ratio.
+//
+// Each thread offers into its own heap and front, touched by no other
+// thread, and merges them into the shared board every kMergeEvery offers.
+// Once the shared board is full its K-th score is published atomically, so
+// most offers are rejected by one relaxed load. snapshot() shows the board
+// as of the last merges, which is what a live view reads while the sweep
+// runs; collect() merges every thread's leftovers once offering is done.
+class Leaderboard {
+public:
+    static constexpr size_t kMergeEvery = 64;
+
+    // `metric` is one of kMetricNames; drawdown, volatility and drawdown
+    // duration rank lowest first, every other metric highest first. A topK
+    // of 0 keeps only the Pareto front.
+    Leaderboard(size_t topK, const std::string& metric = "Sharpe Ratio", bool pareto = true);
+
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    // False for an unknown metric name
+    static bool findMetric(const std::string& name, int& field);
+
+    // Thread-safe; entries with a NaN score are ignored
+    void offer(size_t id, const std::string& name, const PerformanceMetrics& metrics);
+
+    // Merge every thread's pending entries; call once no thread is offering
+    void collect();
+
+    // Best first
+    std::vector<LeaderboardEntry> snapshot() const;
+    // By total return, highest first
+    std::vector<LeaderboardEntry> paretoFront() const;
+
+    // Ids of the top K and the Pareto front, ascending and without repeats
+    std::vector<size_t> selection() const;
+
+    size_t offered() const;
+    const std::string& metricName() const;
+
+    void print(std::ostream& out, size_t rows = 0) const;
+
+    // Written to a temporary file and renamed, so a reader never sees a
+    // partial board
+    bool writeCsv(const std::string& path) const;
+
+private:
+    struct Slot {
+        std::vector<LeaderboardEntry> heap;     // Worst of the slot's best K on top
+        std::vector<LeaderboardEntry> front;
+        std::vector<LeaderboardEntry> known;    // Shared front as of the last merge
+        size_t pending = 0;
+    };
+
+    Slot& localSlot();
+    double score(const PerformanceMetrics& metrics) const;
+    // Heap order: true when a ranks better than b, so the worst is on top
+    bool better(const LeaderboardEntry& a, const LeaderboardEntry& b) const;
+    void pushTopK(std::vector<LeaderboardEntry>& heap, LeaderboardEntry entry) const;
+    static bool dominated(const std::vector<LeaderboardEntry>& front, const PerformanceMetrics& metrics);
+    static void addToFront(std::vector<LeaderboardEntry>& front, const LeaderboardEntry& entry);
+    void mergeLocked(Slot& slot);
+    void printRows(std::ostream& out, const std::vector<LeaderboardEntry>& rows, bool ranked) const;
+
+    size_t m_topK;
+    int m_field;
+    bool m_lowerIsBetter;
+    bool m_pareto;
+    uint64_t m_boardId;                         // Tells this board's thread slots from a previous one's
+
+    mutable std::mutex m_mutex;                 // Guards the shared board and slot registration
+    std::deque<Slot> m_slots;                   // Stable addresses
+    std::vector<LeaderboardEntry> m_heap;
+    std::vector<LeaderboardEntry> m_front;
+    std::atomic<double> m_cutoff;               // K-th best score once the board is full
+    std::atomic<bool> m_full;
+    std::atomic<size_t> m_offered;
+};
+
+} // namespace backtester
+} // namespace crypto
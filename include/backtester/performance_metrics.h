@@ -1,41 +1,148 @@
 #pragma once
 
+#include "utils/reduction.h"
 #include <vector>
 #include <string>
+#include <cstddef>
 
 namespace crypto {
 namespace backtester {
 
+// Rolling windows (in bars) tracked by the metrics accumulator
+constexpr int kNumRollingWindows = 3;
+constexpr int kRollingWindows[kNumRollingWindows] = {30, 90, 365};
+
 struct PerformanceMetrics {
     double totalReturn;
     double annualReturn;
     double sharpeRatio;
+    double sortinoRatio;
+    double calmarRatio;
+    double volatility;          // Annualized, in percent
     double maxDrawdown;
+    int maxDrawdownDuration;    // Longest time under water, in bars
+    double exposure;            // Percent of bars holding a position
     double winRate;
     int totalTrades;
-    
-    PerformanceMetrics() : 
-        totalReturn(0.0), 
-        annualReturn(0.0), 
-        sharpeRatio(0.0), 
-        maxDrawdown(0.0), 
-        winRate(0.0), 
-        totalTrades(0) {}
+
+    // Sharpe ratio and annualized volatility over the trailing 30/90/365 bars
+    double rollingSharpe[kNumRollingWindows];
+    double rollingVolatility[kNumRollingWindows];
+
+    PerformanceMetrics() :
+        totalReturn(0.0),
+        annualReturn(0.0),
+        sharpeRatio(0.0),
+        sortinoRatio(0.0),
+        calmarRatio(0.0),
+        volatility(0.0),
+        maxDrawdown(0.0),
+        maxDrawdownDuration(0),
+        exposure(0.0),
+        winRate(0.0),
+        totalTrades(0),
+        rollingSharpe{0.0, 0.0, 0.0},
+        rollingVolatility{0.0, 0.0, 0.0} {}
+};
+
+// Flat view of every metric, in a fixed order shared by the result store,
+// sweep workers and exporters
+constexpr int kNumMetricFields = 17;
+extern const char* const kMetricNames[kNumMetricFields];
+void metricsToArray(const PerformanceMetrics& metrics, double* values);
+PerformanceMetrics metricsFromArray(const double* values);
+
+// Streaming metrics accumulator, O(1) per bar with no stored return series.
+//
+// State is laid out structure-of-arrays over `lanes` independent equity
+// curves so a single update() is a branch-free loop across lanes that the
+// compiler can vectorise. Single-curve engines simply use one lane.
+class MetricsAccumulator {
+public:
+    MetricsAccumulator(double initialCapital, size_t lanes = 1,
+                       double periodsPerYear = 365.0, double sharpePeriods = 252.0);
+
+    void reset(double initialCapital);
+    size_t lanes() const;
+
+    // Feed the next bar for every lane. `inPosition` may be null.
+    void update(const double* equity, const unsigned char* inPosition = nullptr);
+
+    // Single-lane convenience
+    void update(double equity, bool inPosition);
+
+    // Record a closed trade's profit for a lane
+    void addTrade(double profit, size_t lane = 0);
+
+    PerformanceMetrics finalize(size_t lane = 0) const;
+
+private:
+    size_t m_lanes;
+    double m_initialCapital;
+    double m_periodsPerYear;
+    double m_sharpePeriods;
+    size_t m_bars;
+    size_t m_returns;
+
+    // Per-lane state
+    std::vector<double> m_prevEquity;
+    std::vector<double> m_meanReturn;
+    std::vector<double> m_m2;
+    std::vector<double> m_downsideSq;
+    std::vector<double> m_peak;
+    std::vector<double> m_maxDrawdown;
+    std::vector<double> m_underwater;
+    std::vector<double> m_maxUnderwater;
+    std::vector<double> m_inPositionBars;
+    std::vector<int> m_trades;
+    std::vector<int> m_winningTrades;
+
+    // Rolling windows: one ring of the last 365 returns shared by all windows,
+    // stored [slot][lane]; finalize() reduces each window from it
+    size_t m_ringHead;
+    std::vector<double> m_ring;
 };
 
-// Calculate performance metrics from equity curve
+// Calculate performance metrics from equity curve. `inPosition` flags the
+// bars that held a position, one per equity value; without it exposure is
+// unknown and reported as NaN.
 PerformanceMetrics calculateMetrics(
-    const std::vector<double>& equityCurve, 
+    const std::vector<double>& equityCurve,
     const std::vector<std::pair<double, double>>& trades,
     double initialCapital,
+    int daysInPeriod,
+    const std::vector<unsigned char>& inPosition = {}
+);
+
+// Calculate metrics for many equity curves of equal length in one pass
+// (exposure is NaN, as there are no position flags)
+std::vector<PerformanceMetrics> calculateMetricsBatch(
+    const std::vector<std::vector<double>>& equityCurves,
+    double initialCapital,
     int daysInPeriod
 );
 
-// Calculate drawdown from equity curve
-std::vector<double> calculateDrawdown(const std::vector<double>& equityCurve);
+// Drawdown (negative percent) at each bar. The peak starts at initialCapital,
+// as in MetricsAccumulator, so a curve that opens with a loss is under water.
+std::vector<double> calculateDrawdown(const std::vector<double>& equityCurve, double initialCapital);
+
+// Calculate Sharpe ratio (two-pass mean and variance; reproducible sums by default)
+double calculateSharpeRatio(const std::vector<double>& returns, double riskFreeRate = 0.0,
+                            utils::ReductionMode mode = utils::ReductionMode::Reproducible);
+
+// Population statistics of an equity curve's bar returns, reduced in
+// parallel over `pool`. In reproducible mode the result is bit-identical
+// for any thread count, so audits can rerun on different machines.
+struct ReturnStatistics {
+    size_t count = 0;
+    double mean = 0.0;
+    double stdDev = 0.0;
+    double downsideDev = 0.0;     // Root mean square of negative returns
+};
 
-// Calculate Sharpe ratio
-double calculateSharpeRatio(const std::vector<double>& returns, double riskFreeRate = 0.0);
+ReturnStatistics calculateReturnStatistics(const std::vector<double>& equityCurve,
+                                           utils::ReductionMode mode = utils::ReductionMode::Reproducible,
+                                           utils::ThreadPool* pool = nullptr);
 
 } // namespace backtester
-} // namespace crypto
\ No newline at end of file
+} // namespace crypto
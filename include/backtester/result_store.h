@@ -0,0 +1,97 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include "strategies/strategy.h"
+#include "backtester/performance_metrics.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+// Trade columns stored per strategy, in file order (all 8-byte values;
+// indices and direction are int64, everything else is double)
+constexpr int kNumTradeColumns = 7;
+extern const char* const kTradeColumnNames[kNumTradeColumns];
+
+// Fixed 256-byte header at the start of a result file. All offsets are in
+// bytes from the start of the file; every section is 8-byte aligned.
+struct ResultStoreHeader {
+    char magic[8];                     // "CTSBRES" + NUL
+    uint32_t version;
+    uint32_t metricsFields;
+    uint64_t capacity;                 // Strategy slots
+    uint64_t bars;                     // Length of every equity curve
+    uint64_t maxTrades;                // Trade rows per slot
+    uint64_t nameOffset;               // capacity x 64-byte names
+    uint64_t stateOffset;              // capacity x uint64 (0 = empty, 1 = ready)
+    uint64_t metricsOffset;            // capacity x metricsFields doubles (kMetricNames order)
+    uint64_t tradeCountOffset;         // capacity x uint64
+    uint64_t timestampOffset;          // bars x int64 unix time
+    uint64_t closeOffset;              // bars x double
+    uint64_t equityOffset;             // capacity x bars doubles
+    uint64_t tradesOffset;             // capacity x kNumTradeColumns x maxTrades
+    uint64_t fileSize;
+    uint64_t published;                // Slots made ready so far (atomic)
+    uint8_t reserved[136];
+};
+
+static_assert(sizeof(ResultStoreHeader) == 256, "result store header must stay 256 bytes");
+
+// Memory-mapped result file. The writer publishes each strategy as soon as
+// its backtest finishes; other processes can map the same file read-only and
+// read any slot whose state is ready without copying.
+class ResultStore {
+public:
+    static constexpr size_t kNameLength = 64;
+
+    ResultStore() = default;
+    ~ResultStore();
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    // Writer: create a store sized for `capacity` strategies, replacing any
+    // store at `path` by rename (readers of the old one keep their mapping)
+    bool create(const std::string& path, size_t capacity,
+                const std::vector<data::OHLCV>& priceData, size_t maxTrades);
+
+    // Reader: map an existing store read-only
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    // Copy a finished strategy into `slot` and mark it ready
+    bool publish(size_t slot, const strategies::Strategy& strategy);
+
+    size_t capacity() const;
+    size_t bars() const;
+    size_t published() const;
+    bool isReady(size_t slot) const;
+
+    // Zero-copy views into the mapping (valid while the store is open)
+    std::string name(size_t slot) const;
+    const double* metrics(size_t slot) const;
+    const double* equity(size_t slot) const;
+    size_t tradeCount(size_t slot) const;
+
+private:
+    template<typename T>
+    T* section(uint64_t offset) const {
+        return reinterpret_cast<T*>(m_base + offset);
+    }
+
+    ResultStoreHeader* header() const;
+    std::atomic<uint64_t>* slotState(size_t slot) const;
+    std::atomic<uint64_t>* publishedCount() const;
+
+    int m_fd = -1;
+    uint8_t* m_base = nullptr;
+    size_t m_size = 0;
+    bool m_writable = false;
+};
+
+} // namespace backtester
+} // namespace crypto
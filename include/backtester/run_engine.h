@@ -0,0 +1,56 @@
+#pragma once
+
+#include "backtester/backtester.h"
+#include "backtester/leaderboard.h"
+#include "backtester/run_spec.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+// Executes a RunSpec as a pipeline over datasets: load -> indicators ->
+// backtest -> export, each stage on its own thread and joined by bounded
+// queues. Each distinct dataset is loaded once with its deduplicated
+// indicator set. Indicators, backtests and exports all run as tasks on one
+// shared work-stealing pool, which reports per-worker utilisation at the end.
+// With outputs.topK set, results stream into a per-dataset Leaderboard that
+// is rewritten to leaderboard.csv while the backtests run, and only its top
+// K and Pareto front are reported and exported.
+class RunEngine {
+public:
+    explicit RunEngine(const RunSpec& spec);
+
+    bool run();
+
+private:
+    struct DatasetJob {
+        size_t index;
+        int node;                                      // NUMA node holding its bars
+        std::unique_ptr<Backtester> backtester;
+        std::unique_ptr<Leaderboard> leaderboard;     // With outputs.topK
+    };
+
+    struct StageStats {
+        std::string name;
+        std::vector<std::pair<double, double>> busy;   // Seconds since start
+        double inputWait = 0.0;                        // Starved on an empty queue
+        double outputWait = 0.0;                       // Blocked on a full queue
+    };
+
+    void printPlan() const;
+    void printPipelineReport(double wallSeconds, size_t depth) const;
+    std::string outputDirFor(size_t dataset) const;
+    double elapsed() const;
+
+    RunSpec m_spec;
+    std::vector<DatasetSpec> m_datasets;     // Unique by path and name (checked by loadRunSpec)
+    std::vector<StageStats> m_stages;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "data/data_validation.h"
+#include "strategies/strategy_factory.h"
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+struct DatasetSpec {
+    std::string name;
+    std::string path;
+};
+
+// Declarative description of a run: what to load, what to test, how to
+// execute it and where results go. See configs/default.json.
+struct RunSpec {
+    std::vector<DatasetSpec> datasets;
+    std::vector<strategies::StrategySpec> strategies;   // Grids already expanded
+
+    // Execution
+    double initialCapital;
+    double positionSize;
+    size_t threads;                  // 0 = one per hardware thread
+    size_t queueDepth;               // Datasets buffered between pipeline stages
+    strategies::PositionConfig position;
+    data::ValidationConfig validation;
+    std::string indicatorCache;      // Empty = recompute every run
+    bool lazyResults;                // Keep metrics and signals; replay curves for outputs
+
+    // Outputs
+    std::string outputDir;
+    bool exportCsv;
+    bool resultStore;                // Publish strategy_results.bin per dataset
+    bool compare;                    // Print the comparison table
+    size_t topK;                     // Rank into a leaderboard and export only its best; 0 = off
+    std::string rankBy;              // Leaderboard metric, one of kMetricNames
+    bool pareto;                     // Also keep and export the return/drawdown/Sharpe Pareto front
+
+    RunSpec() :
+        initialCapital(10000.0),
+        positionSize(1.0),
+        threads(0),
+        queueDepth(2),
+        lazyResults(false),
+        outputDir("."),
+        exportCsv(true),
+        resultStore(false),
+        compare(true),
+        topK(0),
+        rankBy("Sharpe Ratio"),
+        pareto(true) {}
+};
+
+// Parse a JSON run spec. Each strategy entry has a "type" and "params";
+// a param may be a number or a "start..end/step" range string, in which case
+// every valid combination is added. An optional "position" section sets
+// the mode (long, longshort), sizing (fixed, voltarget, kelly), leverage
+// and pyramiding for every strategy, and an optional "validation" section
+// the interval, outlier window, threshold and action applied when loading.
+bool loadRunSpec(const std::string& path, RunSpec& spec);
+
+// The built-in experiment: SMA 20/50, SMA 50/200, RSI 14 30/70 and
+// Bollinger 20/2 on one dataset with $10,000 and 95% position size
+RunSpec defaultRunSpec(const std::string& dataPath);
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "backtester/performance_metrics.h"
+#include "data/synthetic_paths.h"
+#include "strategies/position_engine.h"
+#include "strategies/strategy_factory.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace backtester {
+
+struct StressOptions {
+    std::vector<data::PathModel> models;
+    size_t paths = 1000;                    // Per model
+    size_t bars = 0;                        // Per path; 0 = as many as the history
+    uint64_t seed = 42;
+    double blockSize = 20.0;                // Mean bootstrap block, in bars
+    size_t threads = 0;                     // 0 = one per hardware thread
+    double initialCapital = 10000.0;
+    double positionSize = 1.0;
+    strategies::PositionConfig position;
+};
+
+// Summary statistics of one metric over every path of a model
+struct MetricDistribution {
+    double mean = 0.0;
+    double stdDev = 0.0;
+    double p5 = 0.0;
+    double p25 = 0.0;
+    double p50 = 0.0;
+    double p75 = 0.0;
+    double p95 = 0.0;
+};
+
+// Runs strategies over thousands of synthetic paths shaped like a history
+// and reports the distribution of each metric.
+//
+// Every path is one task on a work-stealing pool that generates the bars,
+// computes the indicators the strategies need, backtests each strategy with
+// lazy results and keeps only the metrics; the path is freed before the task
+// ends, so nothing is ever written to disk and memory stays at one path per
+// worker. Paths are seeded by (seed, model, index), so results do not depend
+// on the thread count.
+class StressTester {
+public:
+    StressTester(const std::vector<data::OHLCV>& history, const StressOptions& options);
+
+    void run(const std::vector<strategies::StrategySpec>& specs);
+
+    // After run(): metrics of strategy `s` on path `path` of model `m`
+    const PerformanceMetrics& metrics(size_t model, size_t path, size_t s) const;
+    MetricDistribution distribution(size_t model, size_t s, int field) const;
+
+    // Share of paths on which the strategy lost money
+    double lossProbability(size_t model, size_t s) const;
+
+    void printSummary(std::ostream& out) const;
+
+    // stress_summary.csv (a distribution per model, strategy and metric) and
+    // stress_paths.csv (every path's metrics)
+    bool exportResults(const std::string& outputDir = ".") const;
+
+private:
+    const std::vector<data::OHLCV>& m_history;
+    StressOptions m_options;
+    data::PathGenerator m_generator;
+    std::vector<std::string> m_names;
+    std::vector<PerformanceMetrics> m_historical;   // Per strategy, on the history itself
+    std::vector<std::vector<PerformanceMetrics>> m_results;   // [model][path x strategies + s]
+};
+
+} // namespace backtester
+} // namespace crypto
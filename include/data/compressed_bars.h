@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+struct OHLCV;
+
+// Values per independently decodable block. 1024 bars of all seven columns
+// decode into 56 KB, which stays in L2 while a kernel consumes it.
+constexpr size_t kCompressedBlockSize = 1024;
+
+// A column of epoch timestamps stored as delta-of-deltas with Gorilla's
+// variable-length codes: a bar on the usual spacing costs one bit.
+class CompressedTimeColumn {
+public:
+    void encode(const int64_t* values, size_t count);
+
+    size_t size() const { return m_count; }
+    size_t bytes() const;
+
+    // Decodes block `block` into out[0..n); returns n
+    size_t decodeBlock(size_t block, int64_t* out) const;
+
+private:
+    std::vector<uint64_t> m_words;
+    std::vector<uint64_t> m_blockStart;   // Bit offset of each block
+    size_t m_count = 0;
+};
+
+// A column of doubles, compressed losslessly block by block. A block whose
+// values are all exact decimals with up to 8 places (prices and sizes as
+// exchanges print them) is stored as zigzag deltas of the scaled integers,
+// bit-packed in groups of 64 at each group's own width; any other block
+// falls back to Gorilla XOR coding against the previous value. Either way
+// decoding returns the identical bits.
+class CompressedColumn {
+public:
+    // Deltas are taken from the previous value, or with `previous` from
+    // previous[i - 1] (e.g. opens against the preceding close); decodeBlock
+    // must then get that block of `previous` decoded
+    void encode(const double* values, size_t count, const double* previous = nullptr);
+
+    size_t size() const { return m_count; }
+    size_t bytes() const;
+
+    size_t decodeBlock(size_t block, double* out, const double* previous = nullptr) const;
+
+private:
+    std::vector<uint64_t> m_words;
+    std::vector<uint64_t> m_blockStart;
+    size_t m_count = 0;
+};
+
+// One decoded block, structure-of-arrays. Buffers are allocated once and
+// reused for every block.
+struct BarBlock {
+    size_t first = 0;            // Index of the block's first bar in the series
+    size_t count = 0;
+    std::vector<int64_t> time;
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;
+    std::vector<double> volumeUsd;
+
+    BarBlock();
+    OHLCV bar(size_t i) const;
+};
+
+// Compressed column store for very long histories. Holds a bar series in a
+// fraction of the 56 bytes per bar of std::vector<OHLCV>, and is scanned by
+// decoding one block at a time into a BarBlock rather than expanding it.
+class CompressedBars {
+public:
+    static CompressedBars compress(const std::vector<OHLCV>& bars);
+
+    size_t size() const { return m_count; }
+    size_t blockCount() const { return (m_count + kCompressedBlockSize - 1) / kCompressedBlockSize; }
+
+    // Compressed footprint, and what the same bars take uncompressed
+    size_t bytes() const;
+    size_t rawBytes() const;
+
+    void decodeBlock(size_t block, BarBlock& out) const;
+
+    // Only the closes of a block, for kernels that need nothing else
+    size_t decodeCloses(size_t block, double* out) const;
+
+    std::vector<OHLCV> decompress() const;
+
+private:
+    size_t m_count = 0;
+    CompressedTimeColumn m_time;
+    CompressedColumn m_open;
+    CompressedColumn m_high;
+    CompressedColumn m_low;
+    CompressedColumn m_close;
+    CompressedColumn m_volume;
+    CompressedColumn m_volumeUsd;
+    std::vector<bool> m_derivedUsd;      // Per block: volume_usd == volume_btc x close
+};
+
+} // namespace data
+} // namespace crypto
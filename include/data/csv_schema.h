@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+struct OHLCV;
+
+// Column positions of an OHLCV CSV file, detected from its header rather
+// than assumed. -1 marks a column the file does not have.
+struct CsvSchema {
+    int time = -1;              // Epoch seconds/ms/us/ns or an ISO-8601 date
+    int open = -1;
+    int high = -1;
+    int low = -1;
+    int close = -1;
+    int volume = -1;            // Base currency
+    int volumeUsd = -1;         // Quote currency; volume * close when absent
+    size_t skipLines = 0;       // Banner and header lines before the first row
+
+    // Sniff the layout from the first lines of a file. Headers are matched
+    // by name (case, spaces, '_' and quotes ignored) after any banner lines;
+    // a file whose first row is already numeric is read as exchange klines
+    // (open time, open, high, low, close, volume, close time, quote volume).
+    static bool detect(const std::vector<std::string_view>& lines, CsvSchema& schema);
+
+    // Layout written by DataLoader::formatBar
+    static constexpr const char* kCanonicalHeader = "unix,open,high,low,close,volume,volume_usd";
+    static CsvSchema canonical();
+
+    // False for malformed rows (missing time or prices)
+    bool parseRow(std::string_view line, OHLCV& bar) const;
+
+    std::string describe() const;
+};
+
+// Seconds since the epoch (UTC) from "2024-01-31", "2024/01/31",
+// "2024-01-31 13:45[:30[.250]]", "2024-01-31T13:45:30Z", "+hh:mm" offsets,
+// "2024-01-31 01-PM", or epoch seconds, milliseconds, microseconds or
+// nanoseconds (told apart by magnitude). Sub-second parts are truncated.
+bool parseTimestamp(std::string_view text, int64_t& seconds);
+
+// "YYYY-MM-DD", with " HH:MM:SS" unless the time is midnight
+std::string formatTimestamp(int64_t seconds);
+
+} // namespace data
+} // namespace crypto
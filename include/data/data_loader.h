@@ -1,17 +1,26 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <map>
+#include <mutex>
+#include "data/csv_schema.h"
+#include "data/data_validation.h"
+#include "data/prefix_sum_index.h"
+#include "data/indicator_cache.h"
+#include "data/indicators.h"
 
 namespace crypto {
+namespace utils {
+class ThreadPool;
+}
+
 namespace data {
 
 // Structure to hold OHLCV data
 struct OHLCV {
-    long unix_time;
-    std::string date;
-    std::string symbol;
+    int64_t unix_time;          // Seconds since the epoch (UTC); see formatTimestamp
     double open;
     double high;
     double low;
@@ -20,13 +29,80 @@ struct OHLCV {
     double volume_usd;
 };
 
+// Indicator a strategy needs materialised before generating signals
+enum class IndicatorKind {
+    SMA,
+    EMA,
+    RSI,
+    BollingerBands,
+    MACD,           // period = fast, param = slow, param2 = signal
+    ATR,
+    VWAP,
+    Stochastic,     // period = %K, param = %D
+    ADX,
+    Donchian,
+    OBV
+};
+
+struct IndicatorRequest {
+    IndicatorKind kind;
+    int period;
+    double param;   // Band width for Bollinger Bands, see IndicatorKind for others
+    double param2 = 0.0;
+    
+    bool operator<(const IndicatorRequest& other) const {
+        if (kind != other.kind) return kind < other.kind;
+        if (period != other.period) return period < other.period;
+        if (param != other.param) return param < other.param;
+        return param2 < other.param2;
+    }
+};
+
+// First bar at which output `output` of `request` is defined; earlier bars
+// are warmup. Stored series hold NaN there, so a warmup value can never pass
+// for a real one (the kernels in indicators.h still return 0.0).
+size_t indicatorValidFrom(const IndicatorRequest& request, size_t output = 0);
+
+// Key of the Bollinger Bands of `period` and width `stdDev` (param2 unused)
+IndicatorRequest bollingerKey(int period, double stdDev);
+
+// A stored series and the first bar it is valid from
+struct IndicatorSeries {
+    const std::vector<double>* values = nullptr;
+    size_t validFrom = 0;
+};
+
 class DataLoader {
 public:
     DataLoader(const std::string& filePath);
     ~DataLoader() = default;
     
+    // Reads the file, or every .csv file in the directory (in parallel), with
+    // columns mapped from each file's header (see CsvSchema), then runs the
+    // validation stage (see validateBars): bars are sorted by time, a repeated
+    // timestamp keeps the bar read from the later file, and gaps, invalid
+    // bars and bad prints are reported. Replaces any data loaded before.
     bool loadData();
+    
+    // Options for the validation stage of later loadData calls
+    void setValidation(const ValidationConfig& config);
+    const ValidationReport& getValidationReport() const;
+    
+    // One row in the canonical layout (CsvSchema::kCanonicalHeader) <-> OHLCV;
+    // parseBar returns false for headers and malformed rows
+    static bool parseBar(const std::string& line, OHLCV& bar);
+    static std::string formatBar(const OHLCV& bar);
+    
+    // Use in-memory bars (e.g. synthetic series) instead of reading the file
+    void setData(std::vector<OHLCV> data);
     const std::vector<OHLCV>& getData() const;
+    
+    // Reuse indicator series persisted by earlier runs on the same data
+    // (empty dir disables the cache)
+    void setIndicatorCache(const std::string& dir);
+    
+    // Log each indicator as it is calculated or loaded (default on)
+    void setVerbose(bool verbose);
     std::pair<std::string, std::string> getDateRange() const;
     
     // Technical indicators
@@ -34,24 +110,74 @@ public:
     void addEMA(int period);
     void addRSI(int period);
     void addBollingerBands(int period, double stdDev);
+    void addIndicator(const IndicatorRequest& request);
+    
+    // Compute several indicators as tasks on `pool` (serially without one),
+    // preferring workers on NUMA node `node`. A Bollinger request and an SMA
+    // of the same period may both compute the SMA; the first stored wins.
+    void addIndicators(const std::vector<IndicatorRequest>& requests, utils::ThreadPool* pool = nullptr, int node = -1);
     
     // Get indicators
     std::vector<double> getSMA(int period) const;
     std::vector<double> getEMA(int period) const;
     std::vector<double> getRSI(int period) const;
-    std::vector<double> getBollingerUpper(int period) const;
-    std::vector<double> getBollingerLower(int period) const;
+    std::vector<double> getBollingerUpper(int period, double stdDev) const;
+    std::vector<double> getBollingerLower(int period, double stdDev) const;
+    
+    // Library indicators (MACD, ATR, VWAP, Stochastic, ADX, Donchian, OBV).
+    // Outputs: MACD line/signal/histogram, Stochastic %K/%D, ADX adx/+DI/-DI,
+    // Donchian upper/middle/lower; the others have one
+    std::vector<double> getIndicator(const IndicatorRequest& request, size_t output = 0) const;
+    
+    // Stored series for any computed indicator without copying, or nullptr.
+    // Bollinger outputs are upper/lower. Stays valid until the data is reloaded.
+    const std::vector<double>* findIndicator(const IndicatorRequest& request, size_t output = 0) const;
+    IndicatorSeries findSeries(const IndicatorRequest& request, size_t output = 0) const;
+    
+    // First bar at which every output of every request is valid: signal
+    // loops start there and need no per-bar warmup checks. The data size
+    // when the data is too short for some request.
+    size_t commonValidStart(const std::vector<IndicatorRequest>& requests) const;
+    const OHLCVColumns& getColumns() const;
+    
+    // O(1) window queries on closes for any (period, index), whether or not
+    // the full indicator vector was materialised. Return 0.0 when not enough data.
+    const PrefixSumIndex& getCloseIndex() const;
+    double getSMAAt(int period, size_t index) const;
+    double getStdDevAt(int period, size_t index) const;
+    double getBollingerUpperAt(int period, double stdDev, size_t index) const;
+    double getBollingerLowerAt(int period, double stdDev, size_t index) const;
 
 private:
+    void buildCloseIndex();
+    void addLibraryIndicator(const IndicatorRequest& request);
+    bool hasSeries(const std::map<int, std::vector<double>>& series, int period) const;
+    bool hasBands(const IndicatorRequest& key) const;
+    bool hasLibrarySeries(const IndicatorRequest& request) const;
+    bool loadCached(const std::string& key, std::vector<double>& series);
+    void storeCached(const std::string& key, const std::vector<double>& series);
+    
     std::string m_filePath;
     std::vector<OHLCV> m_data;
+    OHLCVColumns m_columns;
+    PrefixSumIndex m_closeIndex;
+    IndicatorCache m_cache;
+    uint64_t m_datasetHash;
+    bool m_datasetHashed;
+    ValidationConfig m_validation;
+    ValidationReport m_validationReport;
+    bool m_verbose;
     
     // Store calculated indicators
     std::map<int, std::vector<double>> m_sma;
     std::map<int, std::vector<double>> m_ema;
     std::map<int, std::vector<double>> m_rsi;
-    std::map<int, std::vector<double>> m_bollingerUpper;
-    std::map<int, std::vector<double>> m_bollingerLower;
+    // Bands keyed by period and width (bollingerKey)
+    std::map<IndicatorRequest, std::vector<double>> m_bollingerUpper;
+    std::map<IndicatorRequest, std::vector<double>> m_bollingerLower;
+    std::map<IndicatorRequest, std::vector<std::vector<double>>> m_library;
+    // Guards the maps above (and their log lines) while addIndicators runs
+    mutable std::mutex m_indicatorMutex;
 };
 
 } // namespace data
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+struct OHLCV;
+
+enum class OutlierAction {
+    Off,
+    Flag,           // Report outliers, leave the bars alone
+    Repair          // Replace an outlier close with the geometric mean of its neighbours
+};
+
+struct ValidationConfig {
+    int64_t interval = 0;           // Expected seconds between bars; 0 infers the median spacing
+    size_t window = 256;            // Returns per robust-scale block
+    double threshold = 8.0;         // Outlier beyond threshold * 1.4826 * MAD of returns
+    OutlierAction outliers = OutlierAction::Flag;
+};
+
+// A bad print as found (before any repair)
+struct OutlierBar {
+    size_t index;                   // Position after deduplication
+    int64_t time;
+    double close;
+};
+
+struct ValidationReport {
+    size_t bars = 0;
+    size_t duplicates = 0;          // Bars dropped for a repeated timestamp
+    int64_t interval = 0;           // Expected or inferred spacing, seconds
+    size_t gaps = 0;                // Spacings longer than the interval
+    size_t missingBars = 0;         // Bars the gaps would have held
+    size_t misaligned = 0;          // Spacings that are not a multiple of the interval
+    size_t largestGap = 0;          // Missing bars in the longest gap
+    int64_t largestGapStart = 0;    // Time of the bar before it
+    size_t invalid = 0;             // Non-finite or non-positive prices, or high/low not bracketing open/close
+    size_t repairedInvalid = 0;     // Of those, high/low widened to bracket open/close
+    std::vector<OutlierBar> outliers;
+    size_t repaired = 0;
+
+    bool clean() const;
+    void print(std::ostream& out) const;
+};
+
+// The stage run by DataLoader::loadData right after parsing: sort by time,
+// drop repeated timestamps (the later bar wins), then measure gaps against
+// the expected interval, count malformed bars and filter bad prints.
+//
+// A bad print is a close whose return into and out of the bar both exceed
+// the threshold in opposite directions, i.e. a spike that immediately
+// reverts. Returns are scaled by the median and MAD of the preceding block
+// of `window` returns (estimated from 64 of them), so the check is O(1) per
+// bar amortised and a spike never inflates its own yardstick.
+ValidationReport validateBars(std::vector<OHLCV>& bars, const ValidationConfig& config = ValidationConfig());
+
+// "off", "flag" or "repair"
+bool parseOutlierAction(const std::string& text, OutlierAction& action);
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+struct OHLCV;
+
+// On-disk cache of computed indicator series. Entries live under
+// <dir>/<dataset hash>/<indicator key>.bin, so a changed dataset never
+// matches a stale entry. Files are written to a temporary name and renamed,
+// making concurrent writers (sweep workers, parallel runs) safe.
+class IndicatorCache {
+public:
+    IndicatorCache() = default;
+    explicit IndicatorCache(const std::string& dir);
+
+    bool enabled() const;
+    const std::string& getDir() const;
+
+    // FNV-1a over every numeric field of every bar
+    static uint64_t hashDataset(const std::vector<OHLCV>& data);
+
+    // e.g. "rsi-14", "bb-upper-20-2"
+    static std::string makeKey(const std::string& name, int period, double param = 0.0);
+
+    // Read the entry into `series` (a copy, not a mapping); false on miss or mismatch
+    bool load(uint64_t datasetHash, const std::string& key, std::vector<double>& series) const;
+    bool store(uint64_t datasetHash, const std::string& key, const std::vector<double>& series) const;
+
+private:
+    std::string entryPath(uint64_t datasetHash, const std::string& key) const;
+
+    std::string m_dir;
+};
+
+} // namespace data
+} // namespace crypto
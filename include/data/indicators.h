@@ -0,0 +1,240 @@
+#pragma once
+
+#include "data/rolling_window.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+struct OHLCV;
+
+// Column-wise copy of the bars the indicator kernels read, so batch passes
+// stream through contiguous doubles instead of the full OHLCV records
+struct OHLCVColumns {
+    std::vector<double> open;
+    std::vector<double> high;
+    std::vector<double> low;
+    std::vector<double> close;
+    std::vector<double> volume;      // Base currency (volume_btc)
+    std::vector<double> volumeUsd;
+
+    static OHLCVColumns fromBars(const std::vector<OHLCV>& bars);
+    size_t size() const { return close.size(); }
+};
+
+// Every indicator comes in two forms. The streaming form takes one bar at a
+// time in O(1) (live feeds, incremental runs); the batch kernel runs the same
+// recurrence over a whole series in one pass, so both agree exactly.
+// Values are 0.0 until an indicator has enough data (DataLoader stores NaN
+// there instead, see indicatorValidFrom).
+
+// EMA seeded with the SMA of the first `period` values
+class EMAStream {
+public:
+    explicit EMAStream(int period);
+    double update(double value);
+    double value() const { return m_value; }
+    bool ready() const { return m_count >= m_period; }
+    void reset();
+
+private:
+    int m_period;
+    int m_count;
+    double m_sum;
+    double m_multiplier;
+    double m_value;
+};
+
+// Simple moving average over a ring of the last `period` values
+class SMAStream {
+public:
+    explicit SMAStream(int period);
+    double update(double value);
+    double value() const { return m_value; }
+    bool ready() const { return m_count >= m_period; }
+    void reset();
+
+private:
+    int m_period;
+    int m_count;
+    size_t m_head;
+    double m_sum;
+    double m_value;
+    std::vector<double> m_ring;
+};
+
+struct MACDValue {
+    double line;         // EMA(fast) - EMA(slow)
+    double signal;       // EMA(signal) of the line
+    double histogram;    // line - signal
+};
+
+class MACDStream {
+public:
+    MACDStream(int fast = 12, int slow = 26, int signal = 9);
+    MACDValue update(double close);
+    bool ready() const { return m_signal.ready(); }
+    void reset();
+
+private:
+    EMAStream m_fast;
+    EMAStream m_slow;
+    EMAStream m_signal;
+    MACDValue m_value;
+};
+
+// Wilder-smoothed average true range
+class ATRStream {
+public:
+    explicit ATRStream(int period = 14);
+    double update(double high, double low, double close);
+    double value() const { return m_value; }
+    bool ready() const { return m_count >= m_period; }
+    void reset();
+
+private:
+    int m_period;
+    int m_count;
+    double m_prevClose;
+    double m_sum;
+    double m_value;
+};
+
+// Rolling volume-weighted average price: sum(volume_usd) / sum(volume)
+// over the window, falling back to the close when the window has no volume
+class VWAPStream {
+public:
+    explicit VWAPStream(int period = 20);
+    double update(double close, double volume, double volumeUsd);
+    double value() const { return m_value; }
+    bool ready() const { return m_count >= m_period; }
+    void reset();
+
+private:
+    int m_period;
+    int m_count;
+    size_t m_head;
+    double m_volume;
+    double m_volumeUsd;
+    double m_value;
+    std::vector<double> m_volumeRing;
+    std::vector<double> m_volumeUsdRing;
+};
+
+struct StochasticValue {
+    double k;            // 100 x (close - lowest low) / (highest high - lowest low)
+    double d;            // SMA(dPeriod) of %K
+};
+
+class StochasticStream {
+public:
+    StochasticStream(int kPeriod = 14, int dPeriod = 3);
+    StochasticValue update(double high, double low, double close);
+    bool ready() const { return m_d.ready(); }
+    void reset();
+
+private:
+    RollingExtremum<std::greater<double>> m_highest;
+    RollingExtremum<std::less<double>> m_lowest;
+    SMAStream m_d;
+    StochasticValue m_value;
+};
+
+struct ADXValue {
+    double adx;
+    double plusDI;
+    double minusDI;
+};
+
+// Wilder's directional movement index
+class ADXStream {
+public:
+    explicit ADXStream(int period = 14);
+    ADXValue update(double high, double low, double close);
+    bool ready() const { return m_dxCount >= m_period; }
+    void reset();
+
+private:
+    int m_period;
+    int m_count;             // Bars seen
+    int m_dxCount;           // DX values seen
+    double m_prevHigh;
+    double m_prevLow;
+    double m_prevClose;
+    double m_trSum;          // Wilder-smoothed sums
+    double m_plusSum;
+    double m_minusSum;
+    double m_dxSum;
+    ADXValue m_value;
+};
+
+struct DonchianValue {
+    double upper;            // Highest high
+    double middle;
+    double lower;            // Lowest low
+};
+
+class DonchianStream {
+public:
+    explicit DonchianStream(int period = 20);
+    DonchianValue update(double high, double low);
+    bool ready() const { return m_highest.ready(); }
+    void reset();
+
+private:
+    RollingExtremum<std::greater<double>> m_highest;
+    RollingExtremum<std::less<double>> m_lowest;
+    DonchianValue m_value;
+};
+
+// On-balance volume; defined from the first bar
+class OBVStream {
+public:
+    OBVStream();
+    double update(double close, double volume);
+    double value() const { return m_value; }
+    void reset();
+
+private:
+    bool m_started;
+    double m_prevClose;
+    double m_value;
+};
+
+// Batch kernels
+struct MACDSeries {
+    std::vector<double> line;
+    std::vector<double> signal;
+    std::vector<double> histogram;
+};
+
+struct StochasticSeries {
+    std::vector<double> k;
+    std::vector<double> d;
+};
+
+struct ADXSeries {
+    std::vector<double> adx;
+    std::vector<double> plusDI;
+    std::vector<double> minusDI;
+};
+
+struct DonchianSeries {
+    std::vector<double> upper;
+    std::vector<double> middle;
+    std::vector<double> lower;
+};
+
+std::vector<double> computeEMA(const std::vector<double>& values, int period);
+MACDSeries computeMACD(const std::vector<double>& close, int fast = 12, int slow = 26, int signal = 9);
+std::vector<double> computeATR(const OHLCVColumns& bars, int period = 14);
+std::vector<double> computeVWAP(const OHLCVColumns& bars, int period = 20);
+StochasticSeries computeStochastic(const OHLCVColumns& bars, int kPeriod = 14, int dPeriod = 3);
+ADXSeries computeADX(const OHLCVColumns& bars, int period = 14);
+DonchianSeries computeDonchian(const OHLCVColumns& bars, int period = 20);
+std::vector<double> computeOBV(const OHLCVColumns& bars);
+
+} // namespace data
+} // namespace crypto
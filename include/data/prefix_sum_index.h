@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+namespace crypto {
+namespace data {
+
+// Prefix sums of a series and of its squares, answering the sum, mean,
+// variance and standard deviation of any trailing window in O(1).
+//
+// Prefixes are kept as double-double (hi + lo) values and squares are split
+// exactly with fma, so a window query loses at most a few ulps relative to
+// the window itself rather than to the (much larger) running total.
+class PrefixSumIndex {
+public:
+    PrefixSumIndex() = default;
+
+    void build(const std::vector<double>& values);
+
+    // Extend by one value; gives the same prefixes as build() over the
+    // whole series, so streaming queries match batch ones bit for bit
+    void append(double value);
+
+    size_t size() const;
+    bool empty() const;
+
+    // True if a window of `period` values ends at `index` (inclusive)
+    bool hasWindow(int period, size_t index) const;
+
+    // Window statistics over values[index - period + 1 .. index].
+    // All return 0.0 when the window is not available.
+    double windowSum(int period, size_t index) const;
+    double windowMean(int period, size_t index) const;
+    double windowVariance(int period, size_t index) const;  // population variance
+    double windowStdDev(int period, size_t index) const;
+
+private:
+    // Prefix k holds the sum of the first k values (k = 0..n)
+    std::vector<double> m_sumHi;
+    std::vector<double> m_sumLo;
+    std::vector<double> m_sqHi;
+    std::vector<double> m_sqLo;
+};
+
+} // namespace data
+} // namespace crypto
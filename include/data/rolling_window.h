@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+// Fixed-capacity ring buffer, allocated once. Used as the storage of the
+// rolling-window structures below so that pushing a bar never allocates.
+template <typename T>
+class RingBuffer {
+public:
+    explicit RingBuffer(size_t capacity = 1) : m_items(capacity > 0 ? capacity : 1), m_head(0), m_size(0) {}
+
+    size_t capacity() const { return m_items.size(); }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_items.size(); }
+    void clear() { m_head = 0; m_size = 0; }
+
+    // Element i counted from the front (oldest)
+    T& operator[](size_t i) { return m_items[wrap(m_head + i)]; }
+    const T& operator[](size_t i) const { return m_items[wrap(m_head + i)]; }
+    T& front() { return m_items[m_head]; }
+    const T& front() const { return m_items[m_head]; }
+    T& back() { return (*this)[m_size - 1]; }
+    const T& back() const { return (*this)[m_size - 1]; }
+
+    // Callers keep size() <= capacity(); a full buffer overwrites its oldest item
+    void push_back(const T& item) {
+        if (full()) {
+            m_items[m_head] = item;
+            m_head = wrap(m_head + 1);
+        } else {
+            m_items[wrap(m_head + m_size)] = item;
+            ++m_size;
+        }
+    }
+    void pop_front() { m_head = wrap(m_head + 1); --m_size; }
+    void pop_back() { --m_size; }
+
+private:
+    size_t wrap(size_t i) const { return i >= m_items.size() ? i - m_items.size() : i; }
+
+    std::vector<T> m_items;
+    size_t m_head;
+    size_t m_size;
+};
+
+// Rolling maximum (Better = std::greater) or minimum (std::less) over the
+// last `period` values in amortised O(1): the deque keeps only values that
+// can still become the extremum, front first. It never holds more than
+// `period` entries, so it lives in a preallocated ring.
+template <typename Better>
+class RollingExtremum {
+public:
+    explicit RollingExtremum(int period = 1)
+        : m_period(period > 0 ? period : 1), m_count(0), m_window(period > 0 ? period : 1) {}
+
+    void reset() {
+        m_window.clear();
+        m_count = 0;
+    }
+
+    // Add the next value and return the extremum of the current window
+    double push(double value) {
+        // Drop the front if it leaves the window with this value
+        if (!m_window.empty() && m_window.front().index + m_period <= m_count) {
+            m_window.pop_front();
+        }
+
+        Better better;
+        while (!m_window.empty() && !better(m_window.back().value, value)) {
+            m_window.pop_back();
+        }
+        m_window.push_back({m_count, value});
+        ++m_count;
+        return m_window.front().value;
+    }
+
+    double value() const { return m_window.empty() ? 0.0 : m_window.front().value; }
+    bool ready() const { return m_count >= static_cast<size_t>(m_period); }
+    int period() const { return m_period; }
+
+private:
+    struct Entry {
+        size_t index;     // Sequence number of the value
+        double value;
+    };
+
+    int m_period;
+    size_t m_count;
+    RingBuffer<Entry> m_window;
+};
+
+// Sorted multiset with O(log n) insert, erase and select-by-rank: a skiplist
+// whose links also record how many elements they skip. Nodes come from a
+// pool sized at construction, so steady-state updates do not allocate.
+class IndexableSkiplist {
+public:
+    explicit IndexableSkiplist(size_t capacity);
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    void clear();
+
+    // Insert fails (returns false) when the pool is exhausted
+    bool insert(double value);
+    // Remove one element equal to `value`; false if absent
+    bool erase(double value);
+    // The element with `rank` smaller elements before it (0-based)
+    double select(size_t rank) const;
+
+private:
+    static constexpr int32_t kNil = -1;
+
+    int randomLevel();
+    double nodeValue(int32_t node) const;
+    int32_t& next(int32_t node, int level) { return m_next[node * m_maxLevels + level]; }
+    int32_t next(int32_t node, int level) const { return m_next[node * m_maxLevels + level]; }
+    size_t& width(int32_t node, int level) { return m_width[node * m_maxLevels + level]; }
+    size_t width(int32_t node, int level) const { return m_width[node * m_maxLevels + level]; }
+
+    size_t m_capacity;
+    int m_maxLevels;
+    size_t m_size;
+    uint64_t m_rng;
+
+    // Node 0 is the head; per-node arrays are [node][level]
+    std::vector<double> m_values;
+    std::vector<int> m_levels;
+    std::vector<int32_t> m_next;
+    std::vector<size_t> m_width;
+    std::vector<int32_t> m_free;
+
+    // Scratch for the search path
+    std::vector<int32_t> m_chain;
+    std::vector<size_t> m_steps;
+};
+
+// Rolling median or any other percentile over the last `period` values in
+// O(log period) per bar. Quantiles interpolate linearly between the two
+// nearest ranks, like numpy.percentile. Values must not be NaN.
+class RollingQuantile {
+public:
+    explicit RollingQuantile(int period, double quantile = 0.5);
+
+    // Add the next value and return the configured quantile of the window
+    double push(double value);
+
+    // Any quantile in [0, 1] of the current window (0.0 when empty)
+    double quantile(double q) const;
+    double value() const { return m_value; }
+
+    bool ready() const { return m_window.full(); }
+    size_t size() const { return m_window.size(); }
+    int period() const { return m_period; }
+    void reset();
+
+private:
+    int m_period;
+    double m_quantile;
+    double m_value;
+    RingBuffer<double> m_window;
+    IndexableSkiplist m_sorted;
+};
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace data {
+
+// Price processes for synthetic scenarios
+enum class PathModel {
+    GBM,              // Constant drift and volatility
+    GARCH,            // GARCH(1,1) volatility clustering with Student-t shocks
+    RegimeSwitching,  // Two-state Markov chain between calm and stressed markets
+    BlockBootstrap    // Resampled blocks of historical bars
+};
+
+bool parsePathModel(const std::string& name, PathModel& model);
+const char* pathModelName(PathModel model);
+
+// Parameters fitted to a history of per-bar log returns
+struct PathCalibration {
+    double drift = 0.0;               // Mean log return per bar
+    double volatility = 0.0;          // Its standard deviation
+
+    double garchAlpha = 0.08;
+    double garchBeta = 0.90;
+    double garchOmega = 0.0;          // Long-run variance x (1 - alpha - beta)
+    double tailDof = 5.0;             // Student-t degrees of freedom of GARCH shocks
+
+    // Regimes split at the 80th percentile of 30-bar realised volatility
+    double calmDrift = 0.0;
+    double calmVolatility = 0.0;
+    double stressDrift = 0.0;
+    double stressVolatility = 0.0;
+    double calmStay = 0.99;           // P(calm -> calm)
+    double stressStay = 0.95;         // P(stress -> stress)
+
+    double blockSize = 20.0;          // Mean bootstrap block, in bars
+};
+
+// Generates synthetic bar series shaped like a history. Closes follow the
+// chosen model; wicks and volumes are borrowed from randomly drawn historical
+// bars, so highs and lows stay consistent with each bar's open and close.
+// Bootstrapped paths take whole bars (return, gap, wicks and volume) from
+// blocks of consecutive history with geometric lengths (stationary bootstrap).
+//
+// A path depends only on (model, seed), never on which thread generates it.
+// The history must outlive the generator.
+class PathGenerator {
+public:
+    explicit PathGenerator(const std::vector<OHLCV>& history, double blockSize = 20.0);
+
+    const PathCalibration& calibration() const;
+
+    // `bars` bars (0 = as many as the history) starting from the history's
+    // first close and timestamps; `out` is resized and overwritten
+    void generate(PathModel model, uint64_t seed, size_t bars, std::vector<OHLCV>& out) const;
+
+private:
+    struct Shape {
+        double gap;          // Open over the previous close
+        double upperWick;    // High over max(open, close)
+        double lowerWick;    // Low over min(open, close)
+        double volume;
+    };
+
+    const std::vector<OHLCV>& m_history;
+    std::vector<double> m_returns;   // Log close-to-close, m_returns[i] ends at bar i + 1
+    std::vector<Shape> m_shapes;     // Of bars 1..n-1
+    PathCalibration m_calibration;
+};
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace live {
+
+using Clock = std::chrono::steady_clock;
+
+// A bar and the moment it was read off the feed
+struct FeedBar {
+    data::OHLCV bar;
+    Clock::time_point received;
+};
+
+// Source of live bars, oldest first. The column layout is sniffed from the
+// stream's header as for data files (see CsvSchema); lines that are not bars
+// are skipped.
+class BarFeed {
+public:
+    virtual ~BarFeed() = default;
+
+    // Blocks until the next bar; false at the end of the feed
+    virtual bool next(FeedBar& out) = 0;
+    virtual std::string describe() const = 0;
+};
+
+// Follows a file as lines are appended (like tail -f), from its first line.
+// The feed ends once the file has not grown for idleSeconds.
+class TailFeed : public BarFeed {
+public:
+    TailFeed(const std::string& path, double idleSeconds = 2.0);
+    ~TailFeed() override;
+
+    bool open();
+    bool next(FeedBar& out) override;
+    std::string describe() const override;
+
+private:
+    std::string m_path;
+    double m_idleSeconds;
+    int m_fd;
+    std::string m_pending;
+    data::CsvSchema m_schema;
+    bool m_detected;
+};
+
+// Reads bars from a TCP connection until the peer closes it
+class SocketFeed : public BarFeed {
+public:
+    SocketFeed(const std::string& host, int port);
+    ~SocketFeed() override;
+
+    bool connect();
+    bool next(FeedBar& out) override;
+    std::string describe() const override;
+
+private:
+    std::string m_host;
+    int m_port;
+    int m_fd;
+    std::string m_pending;
+    data::CsvSchema m_schema;
+    bool m_detected;
+};
+
+// Stand-in exchange: streams a header and then bars over TCP to one client,
+// paced at barsPerSecond (0 sends as fast as the client reads)
+class ReplayServer {
+public:
+    ReplayServer(std::vector<data::OHLCV> bars, double barsPerSecond);
+    ~ReplayServer();
+
+    // Bind 127.0.0.1:port; port 0 picks a free one, see getPort()
+    bool listen(int port);
+    int getPort() const;
+
+    // Accept one client, send every bar, then close the connection
+    bool serve();
+
+private:
+    std::vector<data::OHLCV> m_bars;
+    double m_barsPerSecond;
+    int m_listenFd;
+    int m_port;
+};
+
+} // namespace live
+} // namespace crypto
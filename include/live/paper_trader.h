@@ -0,0 +1,65 @@
+#pragma once
+
+#include "live/bar_feed.h"
+#include "live/simulated_broker.h"
+#include "strategies/strategy.h"
+#include "utils/bounded_queue.h"
+#include "utils/latency_histogram.h"
+#include <memory>
+#include <vector>
+
+namespace crypto {
+namespace live {
+
+struct PaperConfig {
+    double initialCapital = 10000.0;
+    double positionSize = 0.95;
+    double slippageBps = 0.0;
+    double feeBps = 0.0;
+    size_t queueDepth = 4096;     // Bars buffered between feed and decisions
+    std::vector<int> cpus;        // Feed, decision and broker threads, in that order
+    bool compareBacktest = true;  // Backtest the received bars afterwards
+};
+
+// Runs strategies against a live feed on three threads joined by bounded
+// queues: the feed thread reads bars, the decision thread steps every
+// strategy's SignalStream and emits orders, and the broker thread fills
+// them. Latencies are measured from the moment a bar was read off the feed.
+class PaperTrader {
+public:
+    PaperTrader(const PaperConfig& config, std::vector<std::shared_ptr<strategies::Strategy>> strategies);
+
+    bool run(BarFeed& feed);
+    void printReport() const;
+
+    const utils::LatencyHistogram& getDecisionLatency() const;
+    const utils::LatencyHistogram& getFillLatency() const;
+
+private:
+    // Everything the broker needs from one bar
+    struct BarDecisions {
+        double close;
+        std::vector<Order> orders;
+    };
+
+    void feedLoop(BarFeed& feed, utils::BoundedQueue<FeedBar>& bars);
+    void decisionLoop(utils::BoundedQueue<FeedBar>& bars, utils::BoundedQueue<BarDecisions>& decisions);
+    void brokerLoop(utils::BoundedQueue<BarDecisions>& decisions);
+    void pin(size_t role, const char* name);
+    void runBacktestComparison();
+
+    PaperConfig m_config;
+    std::vector<std::shared_ptr<strategies::Strategy>> m_strategies;
+    SimulatedBroker m_broker;
+    std::vector<data::OHLCV> m_bars;          // Everything received, for the comparison
+    std::vector<size_t> m_orders;             // Per strategy
+    std::vector<double> m_backtestEquity;     // Per strategy, empty if not compared
+    utils::LatencyHistogram m_decisionLatency;
+    utils::LatencyHistogram m_fillLatency;
+    std::vector<std::string> m_pinning;
+    std::string m_source;
+    double m_seconds;
+};
+
+} // namespace live
+} // namespace crypto
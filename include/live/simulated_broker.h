@@ -0,0 +1,73 @@
+#pragma once
+
+#include "live/bar_feed.h"
+#include "strategies/position_engine.h"
+#include "strategies/signal_events.h"
+#include <cstddef>
+#include <vector>
+
+namespace crypto {
+namespace live {
+
+// Market order from one strategy's account, priced off the bar that
+// triggered it
+struct Order {
+    size_t account;
+    strategies::Signal side;
+    size_t barIndex;
+    double price;                 // Close of the triggering bar
+    Clock::time_point received;   // When that bar arrived
+};
+
+struct Fill {
+    size_t account;
+    strategies::Signal side;
+    size_t barIndex;
+    double price;                 // After slippage
+    double units;
+    double fee;
+};
+
+// Paper broker holding one long-flat account per strategy. A BUY invests
+// positionSize of the account's cash, a SELL closes the position; orders
+// that do neither (BUY while long, SELL while flat) are rejected. Fills are
+// immediate at the order price moved against the trader by slippageBps,
+// with feeBps of the notional charged on both sides.
+class SimulatedBroker {
+public:
+    SimulatedBroker(size_t accounts, double initialCapital, double positionSize,
+                    double slippageBps = 0.0, double feeBps = 0.0);
+
+    // False if rejected
+    bool submit(const Order& order, Fill& fill);
+
+    // Latest close, used to value open positions
+    void mark(double close);
+
+    double getEquity(size_t account) const;
+    const std::vector<strategies::Trade>& getTrades(size_t account) const;
+    size_t getFillCount(size_t account) const;
+    size_t getRejectCount(size_t account) const;
+    size_t getAccountCount() const;
+
+private:
+    struct Account {
+        double cash;
+        double units;
+        size_t entryIndex;
+        double entryPrice;
+        double entryCost;         // Cash spent including the fee
+        size_t fills;
+        size_t rejects;
+        std::vector<strategies::Trade> trades;
+    };
+
+    std::vector<Account> m_accounts;
+    double m_positionSize;
+    double m_slippage;
+    double m_fee;
+    double m_mark;
+};
+
+} // namespace live
+} // namespace crypto
@@ -10,7 +10,9 @@ public:
     BollingerBandsStrategy(int period, double stdDev);
     ~BollingerBandsStrategy() = default;
     
-    std::vector<Signal> generateSignals(const data::DataLoader& data) override;
+    SignalEvents generateSignals(const data::DataLoader& data) override;
+    std::vector<data::IndicatorRequest> requiredIndicators() const override;
+    std::unique_ptr<SignalStream> createSignalStream() const override;
 
 private:
     int m_period;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "strategies/signal_algebra.h"
+#include "strategies/strategy.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace crypto {
+namespace strategies {
+
+// Component signals for one dataset, shared by every ensemble built over it,
+// so a component used in thousands of combinations is generated once
+class SignalCache {
+public:
+    // Signals of a component strategy, generated on first use
+    std::shared_ptr<const SignalMask> get(const StrategySpec& spec, const data::DataLoader& data);
+
+    size_t size() const;
+    size_t getHits() const;
+    size_t getMisses() const;
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<const SignalMask>> m_masks;   // By formatSpec
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+};
+
+// Combines component strategies with a SignalExpr evaluated on bit masks
+class EnsembleStrategy : public Strategy {
+public:
+    EnsembleStrategy(const SignalExpr& expression, std::shared_ptr<SignalCache> cache);
+    ~EnsembleStrategy() = default;
+
+    SignalEvents generateSignals(const data::DataLoader& data) override;
+    std::vector<data::IndicatorRequest> requiredIndicators() const override;
+    std::unique_ptr<SignalStream> createSignalStream() const override;
+
+private:
+    SignalMask evaluate(const SignalExpr& node, const data::DataLoader& data);
+
+    SignalExpr m_expression;
+    std::shared_ptr<SignalCache> m_cache;
+};
+
+} // namespace strategies
+} // namespace crypto
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "data/prefix_sum_index.h"
+#include "strategies/signal_events.h"
+#include <cstddef>
+#include <vector>
+
+namespace crypto {
+namespace strategies {
+
+struct Trade {
+    size_t entryIndex;         // First entry of the position
+    size_t exitIndex;
+    double entryPrice;         // Average entry price when pyramided
+    double exitPrice;
+    double profit;
+    double profitPercent;
+    int direction;             // 1 = long, -1 = short
+};
+
+enum class PositionMode {
+    LongOnly,                  // BUY opens/adds, SELL closes
+    LongShort                  // BUY and SELL reverse an opposite position
+};
+
+enum class SizingRule {
+    Fixed,                     // positionSize x equity per position
+    VolatilityTarget,          // Scaled by targetVolatility / realised volatility
+    Kelly                      // Scaled by kellyFraction x Kelly fraction of closed trades
+};
+
+struct PositionConfig {
+    PositionMode mode;
+    SizingRule sizing;
+    double leverage;           // Cap on gross exposure as a multiple of equity
+    int maxEntries;            // Pyramiding: entries per position (1 = none)
+    double targetVolatility;   // Annualised, for VolatilityTarget
+    int volatilityWindow;      // Bars of log returns for realised volatility
+    double periodsPerYear;
+    double kellyFraction;      // 0.5 = half Kelly
+    int kellyMinTrades;        // Closed trades before Kelly sizing kicks in
+
+    // Defaults reproduce the long-flat engine: one full-size long position
+    PositionConfig() :
+        mode(PositionMode::LongOnly),
+        sizing(SizingRule::Fixed),
+        leverage(1.0),
+        maxEntries(1),
+        targetVolatility(0.2),
+        volatilityWindow(20),
+        periodsPerYear(365.0),
+        kellyFraction(0.5),
+        kellyMinTrades(10) {}
+};
+
+// Turns a signal series into positions. The event pass jumps from signal to
+// signal, filling the flat stretches between them in bulk, and records units
+// held and cash after every bar; the equity curve is then the branch-free
+// product cash + units x close, so sizing rules, shorts and pyramiding add
+// no cost to the per-bar loop.
+class PositionEngine {
+public:
+    PositionEngine(const PositionConfig& config, double initialCapital, double positionSize);
+
+    // Event pass over the signals (bar 0 is never traded)
+    void run(const std::vector<double>& closes, const SignalEvents& signals);
+
+    // equity[i] = cash[i] + units[i] x closes[i]
+    void markToMarket(const std::vector<double>& closes, std::vector<double>& equity) const;
+
+    // Incremental form of run() for bars that arrive one at a time: reset(),
+    // then step() once per bar in order. The decisions are the same, but no
+    // unit or cash history is kept; equity is cash() + heldUnits() x close.
+    void reset();
+    void step(size_t index, double close, Signal signal);
+    double heldUnits() const { return m_held; }
+    double cash() const { return m_cash; }
+
+    const std::vector<double>& getUnits() const { return m_units; }
+    const std::vector<double>& getCash() const { return m_cashCurve; }
+    const std::vector<Trade>& getTrades() const { return m_trades; }
+    int getBuyCount() const { return m_buys; }
+    int getSellCount() const { return m_sells; }
+
+private:
+    void act(size_t index, double price, Signal signal);
+    bool open(int direction, size_t index, double price);
+    void close(size_t index, double price);
+    double sizingScale(size_t index) const;
+
+    PositionConfig m_config;
+    double m_initialCapital;
+    double m_positionSize;
+
+    // Open position
+    double m_cash;
+    double m_held;             // Signed units
+    double m_costBasis;        // Sum of units x entry price
+    int m_entries;
+    size_t m_firstEntryIndex;
+    double m_firstEntryPrice;
+
+    // Closed-trade statistics for Kelly sizing
+    int m_wins;
+    double m_winSum;
+    double m_lossSum;
+
+    data::PrefixSumIndex m_returns;   // Log returns, for VolatilityTarget
+    double m_prevClose;               // Last close seen by step()
+
+    std::vector<double> m_units;
+    std::vector<double> m_cashCurve;
+    std::vector<Trade> m_trades;
+    int m_buys;
+    int m_sells;
+};
+
+} // namespace strategies
+} // namespace crypto
@@ -10,7 +10,9 @@ public:
     RSIStrategy(int period, double oversold, double overbought);
     ~RSIStrategy() = default;
     
-    std::vector<Signal> generateSignals(const data::DataLoader& data) override;
+    SignalEvents generateSignals(const data::DataLoader& data) override;
+    std::vector<data::IndicatorRequest> requiredIndicators() const override;
+    std::unique_ptr<SignalStream> createSignalStream() const override;
 
 private:
     int m_period;
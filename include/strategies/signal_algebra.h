@@ -0,0 +1,81 @@
+#pragma once
+
+#include "strategies/signal_events.h"
+#include "strategies/strategy_factory.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace strategies {
+
+// Signals as two bitsets, one bit per bar for BUY and one for SELL, so that
+// combining strategies is a handful of word-wide operations per 64 bars
+class SignalMask {
+public:
+    explicit SignalMask(size_t length = 0);
+
+    static SignalMask fromEvents(const SignalEvents& events);
+    // Bars with both bits set are treated as conflicting and dropped
+    SignalEvents toEvents() const;
+
+    size_t length() const { return m_length; }
+    size_t words() const { return m_buy.size(); }
+
+    std::vector<uint64_t>& buy() { return m_buy; }
+    std::vector<uint64_t>& sell() { return m_sell; }
+    const std::vector<uint64_t>& buy() const { return m_buy; }
+    const std::vector<uint64_t>& sell() const { return m_sell; }
+
+private:
+    size_t m_length;
+    std::vector<uint64_t> m_buy;
+    std::vector<uint64_t> m_sell;
+};
+
+// Both fire on the same bar
+SignalMask maskAnd(const SignalMask& a, const SignalMask& b);
+// Either fires; opposite signals on the same bar cancel
+SignalMask maskOr(const SignalMask& a, const SignalMask& b);
+// BUY <-> SELL
+SignalMask maskNot(const SignalMask& a);
+// Keep each signal alive for `bars` more bars, e.g. and(x, within(3, y))
+// takes x's signals that y confirmed on the same bar or up to 3 bars before
+SignalMask maskWithin(const SignalMask& a, int bars);
+// Weighted vote: BUY where the weights of components signalling BUY sum to
+// at least `threshold` (likewise SELL). Counts are kept bit-sliced, so each
+// component costs a few operations per 64 bars.
+SignalMask maskVote(const std::vector<const SignalMask*>& masks, const std::vector<int>& weights, int threshold);
+
+// Expression over strategy signals:
+//   sma(20, 50)  rsi(14, 30, 70)  bb(20, 2)        strategy leaves
+//   and(a, b, ...)  or(a, b, ...)  not(a)  within(k, a)
+//   vote(threshold, [weight*]a, [weight*]b, ...)
+struct SignalExpr {
+    enum class Op {
+        Leaf,
+        And,
+        Or,
+        Not,
+        Within,
+        Vote
+    };
+
+    Op op = Op::Leaf;
+    StrategySpec spec;              // Leaf
+    int window = 0;                 // Within
+    int threshold = 0;              // Vote
+    std::vector<int> weights;       // Vote, one per child
+    std::vector<SignalExpr> children;
+
+    // Canonical text; parses back to the same expression
+    std::string toString() const;
+    void collectLeaves(std::vector<StrategySpec>& leaves) const;
+};
+
+// Parse an expression. Leaf parameters may be ranges ("sma(5..50/5, 200)"),
+// in which case every combination of leaf parameters is returned.
+bool parseSignalExpression(const std::string& text, std::vector<SignalExpr>& expressions);
+
+} // namespace strategies
+} // namespace crypto
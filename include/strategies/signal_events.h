@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crypto {
+namespace strategies {
+
+enum Signal {
+    HOLD = 0,
+    BUY = 1,
+    SELL = -1
+};
+
+// Sparse signal series: the bar index and direction of every BUY/SELL, in
+// bar order, over a series of `length` bars where every other bar is HOLD.
+// Crossover strategies fire on a few percent of bars at most, so this takes
+// 5 bytes per event instead of 4 bytes per bar, and consumers jump from
+// event to event instead of scanning.
+class SignalEvents {
+public:
+    explicit SignalEvents(size_t length = 0) : m_length(length) {}
+
+    // Events must be added in increasing bar order; HOLD is ignored
+    void add(size_t index, Signal signal) {
+        if (signal != HOLD) {
+            m_indices.push_back(static_cast<uint32_t>(index));
+            m_signals.push_back(static_cast<int8_t>(signal));
+        }
+    }
+
+    size_t length() const { return m_length; }
+    size_t count() const { return m_indices.size(); }
+    size_t indexAt(size_t event) const { return m_indices[event]; }
+    Signal signalAt(size_t event) const { return static_cast<Signal>(m_signals[event]); }
+
+    // Signal on bar `index` (binary search)
+    Signal at(size_t index) const;
+
+    // Conversions to and from one Signal per bar
+    std::vector<Signal> toDense() const;
+    static SignalEvents fromDense(const std::vector<Signal>& signals);
+
+    size_t memoryBytes() const {
+        return m_indices.capacity() * sizeof(uint32_t) + m_signals.capacity() * sizeof(int8_t);
+    }
+
+private:
+    size_t m_length;
+    std::vector<uint32_t> m_indices;
+    std::vector<int8_t> m_signals;
+};
+
+} // namespace strategies
+} // namespace crypto
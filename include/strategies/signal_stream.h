@@ -0,0 +1,19 @@
+#pragma once
+
+#include "data/data_loader.h"
+#include "strategies/signal_events.h"
+
+namespace crypto {
+namespace strategies {
+
+// Incremental form of a strategy's generateSignals for live bars: one bar
+// in, that bar's signal out. Fed a series bar by bar it emits exactly the
+// events generateSignals produces for the whole series.
+class SignalStream {
+public:
+    virtual ~SignalStream() = default;
+    virtual Signal update(const data::OHLCV& bar) = 0;
+};
+
+} // namespace strategies
+} // namespace crypto
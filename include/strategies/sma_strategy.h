@@ -10,7 +10,9 @@ public:
     SMAStrategy(int shortPeriod, int longPeriod);
     ~SMAStrategy() = default;
     
-    std::vector<Signal> generateSignals(const data::DataLoader& data) override;
+    SignalEvents generateSignals(const data::DataLoader& data) override;
+    std::vector<data::IndicatorRequest> requiredIndicators() const override;
+    std::unique_ptr<SignalStream> createSignalStream() const override;
 
 private:
     int m_shortPeriod;
@@ -1,35 +1,51 @@
 #pragma once
 
 #include "data/data_loader.h"
+#include "backtester/performance_metrics.h"
+#include "strategies/position_engine.h"
+#include "strategies/signal_stream.h"
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
 namespace crypto {
 namespace strategies {
 
-enum Signal {
-    HOLD = 0,
-    BUY = 1,
-    SELL = -1
-};
-
-struct Trade {
-    size_t entryIndex;
-    size_t exitIndex;
-    double entryPrice;
-    double exitPrice;
-    double profit;
-    double profitPercent;
-};
-
 class Strategy {
 public:
     Strategy(const std::string& name);
     virtual ~Strategy() = default;
     
-    virtual std::vector<Signal> generateSignals(const data::DataLoader& data) = 0;
+    virtual SignalEvents generateSignals(const data::DataLoader& data) = 0;
+    
+    // Indicators that must be added to the DataLoader before generateSignals
+    virtual std::vector<data::IndicatorRequest> requiredIndicators() const = 0;
+    
+    // Fresh incremental signal state for paper trading
+    virtual std::unique_ptr<SignalStream> createSignalStream() const = 0;
     virtual void backtest(const data::DataLoader& data, double initialCapital = 10000.0, double positionSize = 1.0);
     
+    // Generate and keep the signals for `data` unless already held; backtest()
+    // calls this, so calling it first only moves the work (e.g. for timing)
+    void prepareSignals(const data::DataLoader& data);
+    
+    // Print progress and a performance summary from backtest (default on)
+    void setVerbose(bool verbose);
+    
+    // Lazy results keep only the metrics and the sparse signal events after
+    // backtest(). getEquityCurve() and getTrades() then rebuild both on first
+    // use by replaying the events against the bars, which requires the
+    // DataLoader given to backtest() to still hold the same data.
+    // releaseResults() drops a rebuilt curve and trade list again.
+    void setLazyResults(bool lazy);
+    bool hasLazyResults() const;
+    void releaseResults();
+    
+    // Shorts, leverage, pyramiding and sizing; positionSize still comes from backtest()
+    void setPositionConfig(const PositionConfig& config);
+    const PositionConfig& getPositionConfig() const;
+    
     // Performance metrics
     double getTotalReturn() const;
     double getAnnualReturn() const;
@@ -37,6 +53,12 @@ public:
     double getMaxDrawdown() const;
     double getWinRate() const;
     int getTotalTrades() const;
+    double getSortinoRatio() const;
+    double getCalmarRatio() const;
+    double getVolatility() const;
+    int getMaxDrawdownDuration() const;
+    double getExposure() const;
+    const backtester::PerformanceMetrics& getMetrics() const;
     
     // Get backtest results
     const std::vector<double>& getEquityCurve() const;
@@ -44,18 +66,26 @@ public:
     const std::string& getName() const;
 
 protected:
+    // Rebuild the equity curve and trades of a lazy backtest if not yet done
+    void materializeResults() const;
+    
     std::string m_name;
-    std::vector<Signal> m_signals;
-    std::vector<double> m_equityCurve;
-    std::vector<Trade> m_trades;
+    bool m_verbose;
+    PositionConfig m_positionConfig;
+    SignalEvents m_signals;
+    mutable std::vector<double> m_equityCurve;
+    mutable std::vector<Trade> m_trades;
+    
+    // Lazy results: what a replay needs, and whether it has run
+    bool m_lazyResults;
+    const data::DataLoader* m_replayData;
+    double m_replayCapital;
+    double m_replayPositionSize;
+    mutable bool m_materialized;
+    mutable std::mutex m_replayMutex;
     
     // Performance metrics
-    double m_totalReturn;
-    double m_annualReturn;
-    double m_sharpeRatio;
-    double m_maxDrawdown;
-    double m_winRate;
-    int m_totalTrades;
+    backtester::PerformanceMetrics m_metrics;
 };
 
 } // namespace strategies
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "strategies/strategy.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace strategies {
+
+class SignalCache;
+
+// A strategy type plus its constructor parameters, e.g. {"sma", {20, 50}}.
+// Supported types: sma (short, long), rsi (period, oversold, overbought),
+// bb (period, stdDev), and ensemble, which has no params but an expression
+// over the others (see signal_algebra.h).
+struct StrategySpec {
+    std::string type;
+    std::vector<double> params;
+    std::string expression{};     // Ensembles only
+};
+
+// Build a strategy from a spec; returns nullptr for unknown or invalid specs
+std::shared_ptr<Strategy> createStrategy(const StrategySpec& spec);
+// Ensembles built with the same cache share component signals; the cache
+// must only be used with one dataset
+std::shared_ptr<Strategy> createStrategy(const StrategySpec& spec, std::shared_ptr<SignalCache> cache);
+
+// Whether a spec describes a usable strategy (e.g. SMA short < long)
+bool isValidSpec(const StrategySpec& spec);
+
+// "sma 20 50" or "ensemble and(sma(20, 50), rsi(14, 30, 70))" <-> StrategySpec
+std::string formatSpec(const StrategySpec& spec);
+bool parseSpec(const std::string& text, StrategySpec& spec);
+
+// Expand a grid such as "sma:5..50/5,50..200/25" or "rsi:14,20..35/5,65..80/5"
+// into every valid parameter combination. Each comma-separated field is a
+// single value or an inclusive start..end/step range. "ensemble:<expression>"
+// expands ranges inside the expression's strategy leaves.
+bool parseGrid(const std::string& grid, std::vector<StrategySpec>& specs);
+
+} // namespace strategies
+} // namespace crypto
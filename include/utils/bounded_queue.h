@@ -0,0 +1,86 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+namespace crypto {
+namespace utils {
+
+// Multi-producer, multi-consumer FIFO with a fixed capacity. push() blocks
+// while the queue is full, which is how a slow consumer applies
+// backpressure to the stage feeding it. Both sides accumulate the time they
+// spent blocked.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : m_capacity(capacity > 0 ? capacity : 1), m_closed(false) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Returns false if the queue was closed before the item could be added
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto start = std::chrono::steady_clock::now();
+        m_notFull.wait(lock, [this] { return m_closed || m_items.size() < m_capacity; });
+        m_pushWait += std::chrono::steady_clock::now() - start;
+        if (m_closed) {
+            return false;
+        }
+        m_items.push_back(std::move(item));
+        m_notEmpty.notify_one();
+        return true;
+    }
+
+    // Returns false once the queue is closed and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        auto start = std::chrono::steady_clock::now();
+        m_notEmpty.wait(lock, [this] { return m_closed || !m_items.empty(); });
+        m_popWait += std::chrono::steady_clock::now() - start;
+        if (m_items.empty()) {
+            return false;
+        }
+        item = std::move(m_items.front());
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return true;
+    }
+
+    // No more pushes; consumers drain what is left
+    void close() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+        m_notFull.notify_all();
+    }
+
+    size_t capacity() const { return m_capacity; }
+
+    // Seconds producers spent blocked on a full queue (backpressure) and
+    // consumers spent blocked on an empty one (starvation)
+    double pushWaitSeconds() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::chrono::duration<double>(m_pushWait).count();
+    }
+    double popWaitSeconds() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::chrono::duration<double>(m_popWait).count();
+    }
+
+private:
+    size_t m_capacity;
+    bool m_closed;
+    std::deque<T> m_items;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+    std::chrono::steady_clock::duration m_pushWait{};
+    std::chrono::steady_clock::duration m_popWait{};
+};
+
+} // namespace utils
+} // namespace crypto
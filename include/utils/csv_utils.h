@@ -13,6 +13,9 @@ std::vector<std::vector<std::string>> readCSV(const std::string& filename, char
 // Write data to CSV file
 bool writeCSV(const std::string& filename, const std::vector<std::vector<std::string>>& data, char delimiter = ',');
 
+// Quote a field if it contains a comma or quote (ensemble names do)
+std::string csvField(const std::string& text);
+
 // Write map to CSV file
 template<typename KeyType, typename ValueType>
 bool writeMapToCSV(const std::string& filename, const std::map<KeyType, ValueType>& data, const std::string& keyHeader, const std::string& valueHeader);
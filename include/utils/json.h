@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crypto {
+namespace utils {
+
+// Minimal JSON document model for configuration files
+class JsonValue {
+public:
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    JsonValue() = default;
+
+    Type type() const { return m_type; }
+    bool isNull() const { return m_type == Type::Null; }
+    bool isBool() const { return m_type == Type::Bool; }
+    bool isNumber() const { return m_type == Type::Number; }
+    bool isString() const { return m_type == Type::String; }
+    bool isArray() const { return m_type == Type::Array; }
+    bool isObject() const { return m_type == Type::Object; }
+
+    // Typed access; return `fallback` (or an empty value) on type mismatch
+    bool asBool(bool fallback = false) const;
+    double asNumber(double fallback = 0.0) const;
+    std::string asString(const std::string& fallback = "") const;
+    const std::vector<JsonValue>& asArray() const;
+    const std::vector<std::pair<std::string, JsonValue>>& asObject() const;
+
+    // Object member lookup; missing keys yield a null value
+    bool has(const std::string& key) const;
+    const JsonValue& operator[](const std::string& key) const;
+
+    // Parse a complete document; on failure `error` says where
+    static bool parse(const std::string& text, JsonValue& value, std::string& error);
+
+private:
+    friend class JsonParser;
+
+    Type m_type = Type::Null;
+    bool m_bool = false;
+    double m_number = 0.0;
+    std::string m_string;
+    std::vector<JsonValue> m_array;
+    std::vector<std::pair<std::string, JsonValue>> m_object;
+};
+
+// Read and parse a JSON file, reporting errors to std::cerr
+bool readJsonFile(const std::string& filename, JsonValue& value);
+
+} // namespace utils
+} // namespace crypto
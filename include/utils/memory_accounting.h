@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace crypto {
+namespace utils {
+
+// Components heap allocations are charged to. Code opens a MemoryScope for
+// its component; anything allocated outside one is Other.
+enum class MemoryTag : uint8_t {
+    Other,
+    Bars,           // Loaded rows, their CSV text, columns and the close index
+    Indicators,     // Indicator series
+    Signals,        // Signal events and ensemble bitsets
+    Equity,         // Equity curves and the position engine's per-bar state
+    Trades          // Closed-trade records
+};
+constexpr int kNumMemoryTags = 6;
+
+const char* memoryTagName(MemoryTag tag);
+
+// Charges this thread's allocations to `tag` until destroyed. An allocation
+// stays charged to its tag when another component frees it.
+class MemoryScope {
+public:
+    explicit MemoryScope(MemoryTag tag);
+    ~MemoryScope();
+
+    MemoryScope(const MemoryScope&) = delete;
+    MemoryScope& operator=(const MemoryScope&) = delete;
+
+private:
+    MemoryTag m_previous;
+};
+
+struct MemoryCounters {
+    int64_t liveBytes = 0;
+    int64_t peakBytes = 0;          // Highest liveBytes seen
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;    // Total ever requested
+};
+
+// Accounting is off until enabled; allocations made before then are never
+// counted, including when they are freed later
+void enableMemoryAccounting();
+bool memoryAccountingEnabled();
+MemoryCounters memoryCounters(MemoryTag tag);
+
+// The replacement operator new/delete (src/utils/allocation_hooks.cpp) is
+// linked into the command-line tool only; elsewhere counters stay zero
+bool allocationHooksLinked();
+void setAllocationHooksLinked();
+
+// Used by those operators: malloc with a small header recording the size
+// and tag. trackedAllocate returns null when out of memory.
+void* trackedAllocate(size_t size) noexcept;
+void trackedFree(void* pointer) noexcept;
+
+// Resident set size now and at its peak (VmRSS / VmHWM); 0 where unavailable
+size_t currentRssBytes();
+size_t peakRssBytes();
+
+// Record the first time the run reaches `name`: seconds since startup,
+// resident set and heap in use. Later calls with the same name are ignored.
+void markMilestone(const std::string& name);
+
+void printMemoryReport(std::ostream& out);
+bool writeMemoryReport(const std::string& path);   // JSON
+
+} // namespace utils
+} // namespace crypto
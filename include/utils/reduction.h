@@ -0,0 +1,131 @@
+#pragma once
+
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace crypto {
+namespace utils {
+
+enum class ReductionMode {
+    Fast,           // One chunk per thread, partials added as they finish
+    Reproducible    // Fixed blocks, compensated, combined in block order
+};
+
+// Values per block in reproducible mode. Part of the result's definition:
+// changing it changes the last bits of every reproducible sum.
+constexpr size_t kReductionBlock = 4096;
+
+// Neumaier-compensated running sum: carries the rounding error of every
+// addition, so the result is (nearly) independent of term order and
+// magnitude differences
+struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void add(double x) {
+        double t = sum + x;
+        compensation += std::abs(sum) >= std::abs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void add(const CompensatedSum& other) {
+        add(other.sum);
+        compensation += other.compensation;
+    }
+
+    double value() const { return sum + compensation; }
+};
+
+// Sum of term(i) for i in [0, count), split across `pool` when given.
+//
+// Fast mode sums count/threads terms per thread with four independent
+// accumulators and adds the partials in completion order, so the last bits
+// depend on thread count and scheduling. Reproducible mode sums fixed
+// kReductionBlock-term blocks with compensation and combines them in block
+// order: the same bits for any thread count, pool or none.
+template <typename Term>
+double parallelSum(size_t count, Term term, ReductionMode mode, ThreadPool* pool = nullptr) {
+    if (count == 0) {
+        return 0.0;
+    }
+    size_t threads = pool ? pool->size() : 1;
+
+    if (mode == ReductionMode::Fast) {
+        size_t chunk = (count + threads - 1) / threads;
+        double total = 0.0;
+        std::mutex mutex;
+        auto sumChunk = [&](size_t begin, size_t end) {
+            double lanes[4] = {0.0, 0.0, 0.0, 0.0};
+            size_t i = begin;
+            for (; i + 4 <= end; i += 4) {
+                lanes[0] += term(i);
+                lanes[1] += term(i + 1);
+                lanes[2] += term(i + 2);
+                lanes[3] += term(i + 3);
+            }
+            for (; i < end; ++i) {
+                lanes[0] += term(i);
+            }
+            double partial = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            std::lock_guard<std::mutex> lock(mutex);
+            total += partial;
+        };
+        if (!pool || threads == 1) {
+            sumChunk(0, count);
+            return total;
+        }
+        for (size_t begin = 0; begin < count; begin += chunk) {
+            size_t end = std::min(count, begin + chunk);
+            pool->submit([&sumChunk, begin, end] { sumChunk(begin, end); });
+        }
+        pool->wait();
+        return total;
+    }
+
+    size_t blocks = (count + kReductionBlock - 1) / kReductionBlock;
+    std::vector<CompensatedSum> partials(blocks);
+    auto sumBlocks = [&](size_t first, size_t stride) {
+        for (size_t b = first; b < blocks; b += stride) {
+            // Four fixed lanes per block: independent dependency chains,
+            // and still one defined order whatever the hardware
+            size_t end = std::min(count, (b + 1) * kReductionBlock);
+            CompensatedSum lanes[4];
+            size_t i = b * kReductionBlock;
+            for (; i + 4 <= end; i += 4) {
+                lanes[0].add(term(i));
+                lanes[1].add(term(i + 1));
+                lanes[2].add(term(i + 2));
+                lanes[3].add(term(i + 3));
+            }
+            for (; i < end; ++i) {
+                lanes[0].add(term(i));
+            }
+            lanes[0].add(lanes[1]);
+            lanes[2].add(lanes[3]);
+            lanes[0].add(lanes[2]);
+            partials[b] = lanes[0];
+        }
+    };
+    if (!pool || threads == 1 || blocks == 1) {
+        sumBlocks(0, 1);
+    } else {
+        size_t tasks = std::min(threads, blocks);
+        for (size_t t = 0; t < tasks; ++t) {
+            pool->submit([&sumBlocks, t, tasks] { sumBlocks(t, tasks); });
+        }
+        pool->wait();
+    }
+
+    CompensatedSum total;
+    for (const auto& partial : partials) {
+        total.add(partial);
+    }
+    return total.value();
+}
+
+} // namespace utils
+} // namespace crypto
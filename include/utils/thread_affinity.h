@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace crypto {
+namespace utils {
+
+// Pin the calling thread to one CPU. Linux only; returns false elsewhere or
+// when the CPU is not available to this process.
+bool pinCurrentThread(int cpu);
+
+// Pin the calling thread to a set of CPUs, e.g. every CPU of one NUMA node
+bool pinCurrentThread(const std::vector<int>& cpus);
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+// NUMA nodes with CPUs, from /sys/devices/system/node; one node holding
+// every hardware thread when the topology is unknown (or not Linux)
+const std::vector<NumaNode>& numaNodes();
+
+// Parse "0,2,3" or "0-3" style CPU lists
+bool parseCpuList(const std::string& text, std::vector<int>& cpus);
+
+} // namespace utils
+} // namespace crypto
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+namespace crypto {
+namespace utils {
+
+// Per-worker counters since construction or the last resetStats()
+struct WorkerStats {
+    int node = 0;
+    uint64_t tasks = 0;
+    uint64_t stolen = 0;        // Of those, taken from another worker's deque
+    double busySeconds = 0.0;
+};
+
+// Fixed-size pool of worker threads with work stealing.
+//
+// Every worker owns a deque: it pushes and pops its own tasks at the back,
+// and when that runs dry it steals the oldest task from the front of
+// another's, trying workers on its own NUMA node first. Tasks submitted
+// from outside the pool are dealt round-robin. Backtests differ a lot in
+// cost, so idle workers keep pulling the tail of a sweep instead of
+// waiting on whoever drew the expensive jobs.
+//
+// On a machine with several NUMA nodes, workers are spread over the nodes
+// and pinned to their node's CPUs; submit(task, node) queues a task on that
+// node, so it runs next to data first touched there (see numaNodes()).
+class ThreadPool {
+public:
+    // 0 threads means one per hardware thread
+    explicit ThreadPool(size_t threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+
+    // Queue on a worker of NUMA node `node` (index into numaNodes());
+    // other nodes still steal it once they run out of work
+    void submit(std::function<void()> task, int node);
+
+    // Block until every submitted task has finished
+    void wait();
+
+    size_t size() const;
+    size_t nodeCount() const;
+
+    std::vector<WorkerStats> stats() const;
+    void resetStats();
+
+    // Busy time over worker time since construction or resetStats()
+    double utilisation() const;
+    void printStats(std::ostream& out) const;
+
+private:
+    struct Worker {
+        int node = 0;
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+        std::atomic<uint64_t> tasksRun{0};
+        std::atomic<uint64_t> stolen{0};
+        std::atomic<uint64_t> busyNs{0};
+    };
+
+    void push(size_t worker, std::function<void()> task);
+    bool popLocal(size_t worker, std::function<void()>& task);
+    bool steal(size_t thief, std::function<void()>& task);
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<std::vector<size_t>> m_nodeWorkers;   // Worker indices per node
+    std::vector<std::thread> m_threads;
+    std::atomic<size_t> m_nextWorker;
+    std::atomic<size_t> m_queued;                     // Tasks waiting in deques
+    std::atomic<size_t> m_pending;                    // Queued or running
+
+    std::mutex m_mutex;                               // Guards sleeping and waiting
+    std::condition_variable m_taskReady;
+    std::condition_variable m_idle;
+    bool m_stopping;
+    std::chrono::steady_clock::time_point m_statsStart;
+};
+
+// Tasks submitted through a group can be waited for apart from the rest of
+// the pool, so pipeline stages sharing one pool do not wait on each other
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void submit(std::function<void()> task, int node = -1);
+    void wait();
+
+    // wait() for at most `timeout`; true once every task has finished
+    bool waitFor(std::chrono::milliseconds timeout);
+
+private:
+    ThreadPool& m_pool;
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    size_t m_pending;
+};
+
+} // namespace utils
+} // namespace crypto
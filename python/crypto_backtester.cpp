@@ -0,0 +1,754 @@
+// crypto_backtester: Python bindings for the C++ engine.
+//
+// Prices, indicators, equity curves and trades come back as read-only
+// arrays that point straight at the engine's std::vectors (buffer protocol,
+// so numpy.asarray() and memoryview() wrap them without copying; with NumPy
+// installed they are returned as ndarrays directly). Each array keeps its
+// owner alive, and an owner refuses to reload or re-run while arrays into
+// it exist, so a view can never outlive or dangle into its buffer.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "backtester/backtester.h"
+#include "data/data_loader.h"
+#include "data/indicators.h"
+#include "strategies/strategy_factory.h"
+#include "utils/thread_pool.h"
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using crypto::data::DataLoader;
+using crypto::data::IndicatorKind;
+using crypto::data::IndicatorRequest;
+
+// Cast a typed C function to a CPython slot type. Going through void(*)(void)
+// marks the conversion as intended (-Wcast-function-type); CPython calls the
+// function with a PyObject* that really is our object type.
+template <typename Slot, typename Function>
+Slot slot(Function function) {
+    return reinterpret_cast<Slot>(reinterpret_cast<void (*)(void)>(function));
+}
+
+// Array: a strided, read-only view of C++ memory
+
+struct ArrayObject {
+    PyObject_HEAD
+    PyObject* owner;                    // Keeps the viewed buffer alive
+    Py_ssize_t* ownerViews;             // Owner's live-array count
+    std::vector<double>* storage;       // Values owned by the array itself
+    const char* data;
+    Py_ssize_t length;
+    Py_ssize_t stride;
+    Py_ssize_t itemsize;
+    const char* format;
+};
+
+void arrayDealloc(ArrayObject* self) {
+    if (self->ownerViews) {
+        --*self->ownerViews;
+    }
+    Py_XDECREF(self->owner);
+    delete self->storage;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+int arrayGetBuffer(ArrayObject* self, Py_buffer* view, int flags) {
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "engine arrays are read-only");
+        return -1;
+    }
+    if (self->stride != self->itemsize && (flags & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "array is strided");
+        return -1;
+    }
+    view->obj = reinterpret_cast<PyObject*>(self);
+    Py_INCREF(view->obj);
+    view->buf = const_cast<char*>(self->data);
+    view->len = self->length * self->itemsize;
+    view->readonly = 1;
+    view->itemsize = self->itemsize;
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>(self->format) : nullptr;
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? &self->length : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &self->stride : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+Py_ssize_t arrayLength(ArrayObject* self) {
+    return self->length;
+}
+
+PyObject* arrayItem(ArrayObject* self, Py_ssize_t index) {
+    if (index < 0 || index >= self->length) {
+        PyErr_SetString(PyExc_IndexError, "index out of range");
+        return nullptr;
+    }
+    const char* item = self->data + index * self->stride;
+    switch (self->format[0]) {
+        case 'd': return PyFloat_FromDouble(*reinterpret_cast<const double*>(item));
+        case 'q': return PyLong_FromLongLong(*reinterpret_cast<const long long*>(item));
+        case 'Q': return PyLong_FromUnsignedLongLong(*reinterpret_cast<const unsigned long long*>(item));
+        case 'i': return PyLong_FromLong(*reinterpret_cast<const int*>(item));
+    }
+    PyErr_SetString(PyExc_TypeError, "unsupported item type");
+    return nullptr;
+}
+
+PyObject* arrayRepr(ArrayObject* self) {
+    return PyUnicode_FromFormat("<crypto_backtester.Array of %zd '%s'>", self->length, self->format);
+}
+
+PyBufferProcs kArrayBuffer = {slot<getbufferproc>(arrayGetBuffer), nullptr};
+
+PySequenceMethods kArraySequence = {
+    slot<lenfunc>(arrayLength), nullptr, nullptr,
+    slot<ssizeargfunc>(arrayItem), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+PyTypeObject ArrayType{};
+
+// numpy.asarray when NumPy is importable, otherwise None
+PyObject* numpyAsarray() {
+    static PyObject* asarray = nullptr;
+    if (!asarray) {
+        PyObject* numpy = PyImport_ImportModule("numpy");
+        if (numpy) {
+            asarray = PyObject_GetAttrString(numpy, "asarray");
+            Py_DECREF(numpy);
+        }
+        if (!asarray) {
+            PyErr_Clear();
+            asarray = Py_None;
+            Py_INCREF(asarray);
+        }
+    }
+    return asarray;
+}
+
+// Hand an Array to Python, as a zero-copy ndarray when NumPy is present
+PyObject* publish(ArrayObject* array) {
+    if (!array) {
+        return nullptr;
+    }
+    PyObject* asarray = numpyAsarray();
+    if (asarray == Py_None) {
+        return reinterpret_cast<PyObject*>(array);
+    }
+    PyObject* ndarray = PyObject_CallOneArg(asarray, reinterpret_cast<PyObject*>(array));
+    Py_DECREF(array);
+    return ndarray;
+}
+
+// View `length` items of `itemsize` bytes, `stride` bytes apart, owned by `owner`
+PyObject* makeView(PyObject* owner, Py_ssize_t* ownerViews, const void* data, size_t length,
+                   size_t stride, size_t itemsize, const char* format) {
+    ArrayObject* array = PyObject_New(ArrayObject, &ArrayType);
+    if (!array) {
+        return nullptr;
+    }
+    Py_INCREF(owner);
+    array->owner = owner;
+    array->ownerViews = ownerViews;
+    ++*ownerViews;
+    array->storage = nullptr;
+    array->data = static_cast<const char*>(data);
+    array->length = static_cast<Py_ssize_t>(length);
+    array->stride = static_cast<Py_ssize_t>(stride);
+    array->itemsize = static_cast<Py_ssize_t>(itemsize);
+    array->format = format;
+    return publish(array);
+}
+
+PyObject* viewOf(PyObject* owner, Py_ssize_t* ownerViews, const std::vector<double>& values) {
+    return makeView(owner, ownerViews, values.data(), values.size(), sizeof(double), sizeof(double), "d");
+}
+
+// Array that takes over a freshly computed vector
+PyObject* ownedArray(std::vector<double>&& values) {
+    ArrayObject* array = PyObject_New(ArrayObject, &ArrayType);
+    if (!array) {
+        return nullptr;
+    }
+    array->owner = nullptr;
+    array->ownerViews = nullptr;
+    array->storage = new std::vector<double>(std::move(values));
+    array->data = reinterpret_cast<const char*>(array->storage->data());
+    array->length = static_cast<Py_ssize_t>(array->storage->size());
+    array->stride = sizeof(double);
+    array->itemsize = sizeof(double);
+    array->format = "d";
+    return publish(array);
+}
+
+// Copy any 1-D float64 buffer into a vector (inputs are copied, outputs are not)
+bool readDoubles(PyObject* object, std::vector<double>& values) {
+    Py_buffer buffer;
+    if (PyObject_GetBuffer(object, &buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {
+        return false;
+    }
+    bool ok = buffer.format && std::string(buffer.format) == "d" && buffer.ndim == 1;
+    if (ok) {
+        const double* data = static_cast<const double*>(buffer.buf);
+        values.assign(data, data + buffer.len / sizeof(double));
+    } else {
+        PyErr_SetString(PyExc_TypeError, "expected a 1-D float64 buffer");
+    }
+    PyBuffer_Release(&buffer);
+    return ok;
+}
+
+int setItem(PyObject* dict, const char* key, PyObject* value) {
+    if (!value) {
+        return -1;
+    }
+    int status = PyDict_SetItemString(dict, key, value);
+    Py_DECREF(value);
+    return status;
+}
+
+// Shared helpers for anything holding a DataLoader
+
+bool parseKind(const char* name, IndicatorKind& kind) {
+    static const std::pair<const char*, IndicatorKind> kinds[] = {
+        {"sma", IndicatorKind::SMA}, {"ema", IndicatorKind::EMA}, {"rsi", IndicatorKind::RSI},
+        {"bb", IndicatorKind::BollingerBands}, {"macd", IndicatorKind::MACD}, {"atr", IndicatorKind::ATR},
+        {"vwap", IndicatorKind::VWAP}, {"stochastic", IndicatorKind::Stochastic}, {"adx", IndicatorKind::ADX},
+        {"donchian", IndicatorKind::Donchian}, {"obv", IndicatorKind::OBV}
+    };
+    for (const auto& entry : kinds) {
+        if (std::string(name) == entry.first) {
+            kind = entry.second;
+            return true;
+        }
+    }
+    PyErr_Format(PyExc_ValueError, "unknown indicator '%s'", name);
+    return false;
+}
+
+// OHLCV columns plus the unix time read in place from the bar records
+PyObject* pricesOf(PyObject* owner, Py_ssize_t* views, const DataLoader& loader) {
+    const auto& columns = loader.getColumns();
+    const auto& bars = loader.getData();
+
+    PyObject* dict = PyDict_New();
+    if (!dict ||
+        setItem(dict, "time", makeView(owner, views, bars.empty() ? nullptr : &bars[0].unix_time, bars.size(),
+                                       sizeof(crypto::data::OHLCV), sizeof(int64_t), "q")) ||
+        setItem(dict, "open", viewOf(owner, views, columns.open)) ||
+        setItem(dict, "high", viewOf(owner, views, columns.high)) ||
+        setItem(dict, "low", viewOf(owner, views, columns.low)) ||
+        setItem(dict, "close", viewOf(owner, views, columns.close)) ||
+        setItem(dict, "volume", viewOf(owner, views, columns.volume)) ||
+        setItem(dict, "volume_usd", viewOf(owner, views, columns.volumeUsd))) {
+        Py_XDECREF(dict);
+        return nullptr;
+    }
+    return dict;
+}
+
+bool parseRequest(PyObject* args, PyObject* kwargs, IndicatorRequest& request, Py_ssize_t* output) {
+    static const char* keywords[] = {"kind", "period", "param", "param2", "output", nullptr};
+    const char* kind = nullptr;
+    request.param = 0.0;
+    request.param2 = 0.0;
+    Py_ssize_t unusedOutput = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "si|ddn", const_cast<char**>(keywords), &kind,
+                                     &request.period, &request.param, &request.param2,
+                                     output ? output : &unusedOutput)) {
+        return false;
+    }
+    return parseKind(kind, request.kind);
+}
+
+PyObject* indicatorView(PyObject* owner, Py_ssize_t* views, const DataLoader& loader,
+                        const IndicatorRequest& request, Py_ssize_t output) {
+    const std::vector<double>* series = loader.findIndicator(request, static_cast<size_t>(output));
+    if (!series) {
+        PyErr_SetString(PyExc_KeyError, "indicator not computed (or no such output)");
+        return nullptr;
+    }
+    return viewOf(owner, views, *series);
+}
+
+// DataLoader
+
+struct LoaderObject {
+    PyObject_HEAD
+    DataLoader* loader;
+    Py_ssize_t views;
+};
+
+int loaderInit(LoaderObject* self, PyObject* args, PyObject*) {
+    const char* path = "";
+    if (!PyArg_ParseTuple(args, "|s", &path)) {
+        return -1;
+    }
+    if (self->views > 0) {
+        PyErr_SetString(PyExc_RuntimeError, "arrays into this loader are still alive");
+        return -1;
+    }
+    delete self->loader;
+    self->loader = new DataLoader(path);
+    return 0;
+}
+
+// A loader whose __init__ never ran holds no DataLoader
+bool hasLoader(LoaderObject* self) {
+    if (!self->loader) {
+        PyErr_SetString(PyExc_RuntimeError, "DataLoader is not initialized");
+        return false;
+    }
+    return true;
+}
+
+void loaderDealloc(LoaderObject* self) {
+    delete self->loader;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+PyObject* loaderLoad(LoaderObject* self, PyObject*) {
+    if (!hasLoader(self)) {
+        return nullptr;
+    }
+    if (self->views > 0) {
+        PyErr_SetString(PyExc_RuntimeError, "arrays into this loader are still alive; drop them before reloading");
+        return nullptr;
+    }
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    ok = self->loader->loadData();
+    Py_END_ALLOW_THREADS
+    if (!ok) {
+        PyErr_SetString(PyExc_OSError, "could not load data");
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+Py_ssize_t loaderLength(LoaderObject* self) {
+    if (!hasLoader(self)) {
+        return -1;
+    }
+    return static_cast<Py_ssize_t>(self->loader->getData().size());
+}
+
+PyObject* loaderPrices(LoaderObject* self, PyObject*) {
+    if (!hasLoader(self)) {
+        return nullptr;
+    }
+    return pricesOf(reinterpret_cast<PyObject*>(self), &self->views, *self->loader);
+}
+
+PyObject* loaderAddIndicator(LoaderObject* self, PyObject* args, PyObject* kwargs) {
+    IndicatorRequest request;
+    if (!hasLoader(self) || !parseRequest(args, kwargs, request, nullptr)) {
+        return nullptr;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    self->loader->addIndicator(request);
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
+
+// Computed on first use; adding indicators never moves existing series
+PyObject* loaderIndicator(LoaderObject* self, PyObject* args, PyObject* kwargs) {
+    IndicatorRequest request;
+    Py_ssize_t output = 0;
+    if (!hasLoader(self) || !parseRequest(args, kwargs, request, &output)) {
+        return nullptr;
+    }
+    if (!self->loader->findIndicator(request, static_cast<size_t>(output))) {
+        Py_BEGIN_ALLOW_THREADS
+        self->loader->addIndicator(request);
+        Py_END_ALLOW_THREADS
+    }
+    return indicatorView(reinterpret_cast<PyObject*>(self), &self->views, *self->loader, request, output);
+}
+
+PyMethodDef kLoaderMethods[] = {
+    {"load", slot<PyCFunction>(loaderLoad), METH_NOARGS, "Read the CSV file"},
+    {"prices", slot<PyCFunction>(loaderPrices), METH_NOARGS,
+     "Dict of zero-copy price columns: time, open, high, low, close, volume, volume_usd"},
+    {"add_indicator", slot<PyCFunction>(loaderAddIndicator), METH_VARARGS | METH_KEYWORDS,
+     "add_indicator(kind, period, param=0, param2=0)"},
+    {"indicator", slot<PyCFunction>(loaderIndicator), METH_VARARGS | METH_KEYWORDS,
+     "indicator(kind, period, param=0, param2=0, output=0): zero-copy view, computed if needed"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PySequenceMethods kLoaderSequence = {
+    slot<lenfunc>(loaderLength), nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+PyTypeObject LoaderType{};
+
+// Backtester
+
+struct BacktesterObject {
+    PyObject_HEAD
+    crypto::backtester::Backtester* backtester;
+    Py_ssize_t views;
+};
+
+int backtesterInit(BacktesterObject* self, PyObject* args, PyObject*) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path)) {
+        return -1;
+    }
+    // Report a missing file as FileNotFoundError rather than a generic load failure
+    if (!std::filesystem::exists(path)) {
+        PyErr_Format(PyExc_FileNotFoundError, "data file not found: %s", path);
+        return -1;
+    }
+    if (self->views > 0) {
+        PyErr_SetString(PyExc_RuntimeError, "arrays into this backtester are still alive");
+        return -1;
+    }
+    delete self->backtester;
+    self->backtester = nullptr;
+    std::string dataPath(path);
+    Py_BEGIN_ALLOW_THREADS
+    self->backtester = new crypto::backtester::Backtester(dataPath);
+    Py_END_ALLOW_THREADS
+    if (!self->backtester->isLoaded()) {
+        delete self->backtester;
+        self->backtester = nullptr;
+        PyErr_Format(PyExc_ValueError, "failed to load data from %s", path);
+        return -1;
+    }
+    return 0;
+}
+
+// A backtester whose __init__ failed (or never ran) holds no engine
+bool hasBacktester(BacktesterObject* self) {
+    if (!self->backtester) {
+        PyErr_SetString(PyExc_RuntimeError, "Backtester is not initialized");
+        return false;
+    }
+    return true;
+}
+
+void backtesterDealloc(BacktesterObject* self) {
+    delete self->backtester;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+// "sma 20 50", "ensemble and(...)" or a grid such as "sma:5..50/5,50..200/25"
+PyObject* backtesterAddStrategy(BacktesterObject* self, PyObject* args) {
+    const char* text = nullptr;
+    if (!hasBacktester(self) || !PyArg_ParseTuple(args, "s", &text)) {
+        return nullptr;
+    }
+
+    std::vector<crypto::strategies::StrategySpec> specs;
+    crypto::strategies::StrategySpec spec;
+    std::string line(text);
+    size_t colon = line.find(':');
+    bool isGrid = colon != std::string::npos && line.find(' ') > colon;
+    if (isGrid ? !crypto::strategies::parseGrid(line, specs) : !crypto::strategies::parseSpec(line, spec)) {
+        PyErr_Format(PyExc_ValueError, "invalid strategy '%s'", text);
+        return nullptr;
+    }
+    if (!isGrid) {
+        specs.push_back(spec);
+    }
+
+    for (const auto& entry : specs) {
+        auto strategy = crypto::strategies::createStrategy(entry);
+        if (!strategy) {
+            PyErr_Format(PyExc_ValueError, "invalid strategy parameters '%s'",
+                         crypto::strategies::formatSpec(entry).c_str());
+            return nullptr;
+        }
+        self->backtester->addStrategy(strategy);
+    }
+    return PyLong_FromSize_t(specs.size());
+}
+
+PyObject* backtesterSetIndicatorCache(BacktesterObject* self, PyObject* args) {
+    const char* dir = nullptr;
+    if (!hasBacktester(self) || !PyArg_ParseTuple(args, "s", &dir)) {
+        return nullptr;
+    }
+    self->backtester->setIndicatorCache(dir);
+    Py_RETURN_NONE;
+}
+
+PyObject* backtesterRun(BacktesterObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"initial_capital", "position_size", "threads", "verbose", nullptr};
+    double initialCapital = 10000.0;
+    double positionSize = 0.95;
+    Py_ssize_t threads = 1;
+    int verbose = 0;
+    if (!hasBacktester(self) ||
+        !PyArg_ParseTupleAndKeywords(args, kwargs, "|ddnp", const_cast<char**>(keywords),
+                                     &initialCapital, &positionSize, &threads, &verbose)) {
+        return nullptr;
+    }
+    if (self->views > 0) {
+        PyErr_SetString(PyExc_RuntimeError, "arrays into this backtester are still alive; drop them before re-running");
+        return nullptr;
+    }
+
+    crypto::backtester::Backtester* backtester = self->backtester;
+    size_t count = backtester->getStrategyCount();
+    for (size_t s = 0; s < count; ++s) {
+        backtester->getStrategy(s)->setVerbose(verbose != 0);
+    }
+
+    // The whole run happens without the GIL
+    Py_BEGIN_ALLOW_THREADS
+    backtester->prepare(initialCapital, positionSize);
+    if (threads == 1) {
+        for (size_t s = 0; s < count; ++s) {
+            backtester->runStrategy(s);
+        }
+    } else {
+        crypto::utils::ThreadPool pool(static_cast<size_t>(threads > 0 ? threads : 0));
+        for (size_t s = 0; s < count; ++s) {
+            pool.submit([backtester, s] { backtester->runStrategy(s); });
+        }
+        pool.wait();
+    }
+    Py_END_ALLOW_THREADS
+    Py_RETURN_NONE;
+}
+
+bool checkIndex(BacktesterObject* self, Py_ssize_t index) {
+    if (!hasBacktester(self)) {
+        return false;
+    }
+    if (index < 0 || static_cast<size_t>(index) >= self->backtester->getStrategyCount()) {
+        PyErr_SetString(PyExc_IndexError, "strategy index out of range");
+        return false;
+    }
+    return true;
+}
+
+PyObject* backtesterStrategies(BacktesterObject* self, PyObject*) {
+    if (!hasBacktester(self)) {
+        return nullptr;
+    }
+    size_t count = self->backtester->getStrategyCount();
+    PyObject* names = PyList_New(static_cast<Py_ssize_t>(count));
+    for (size_t s = 0; names && s < count; ++s) {
+        PyList_SET_ITEM(names, s, PyUnicode_FromString(self->backtester->getStrategy(s)->getName().c_str()));
+    }
+    return names;
+}
+
+PyObject* backtesterEquity(BacktesterObject* self, PyObject* args) {
+    Py_ssize_t index = 0;
+    if (!PyArg_ParseTuple(args, "n", &index) || !checkIndex(self, index)) {
+        return nullptr;
+    }
+    const auto& equity = self->backtester->getStrategy(index)->getEquityCurve();
+    return viewOf(reinterpret_cast<PyObject*>(self), &self->views, equity);
+}
+
+// Trade fields as strided views over the Trade records
+PyObject* backtesterTrades(BacktesterObject* self, PyObject* args) {
+    using crypto::strategies::Trade;
+    Py_ssize_t index = 0;
+    if (!PyArg_ParseTuple(args, "n", &index) || !checkIndex(self, index)) {
+        return nullptr;
+    }
+    static_assert(sizeof(size_t) == sizeof(unsigned long long), "index views assume a 64-bit size_t");
+
+    const auto& trades = self->backtester->getStrategy(index)->getTrades();
+    PyObject* owner = reinterpret_cast<PyObject*>(self);
+    const char* base = trades.empty() ? nullptr : reinterpret_cast<const char*>(trades.data());
+    size_t n = trades.size();
+    auto field = [&](size_t offset, size_t size, const char* format) {
+        return makeView(owner, &self->views, base ? base + offset : nullptr, n, sizeof(Trade), size, format);
+    };
+
+    PyObject* dict = PyDict_New();
+    if (!dict ||
+        setItem(dict, "entry_index", field(offsetof(Trade, entryIndex), sizeof(size_t), "Q")) ||
+        setItem(dict, "exit_index", field(offsetof(Trade, exitIndex), sizeof(size_t), "Q")) ||
+        setItem(dict, "entry_price", field(offsetof(Trade, entryPrice), sizeof(double), "d")) ||
+        setItem(dict, "exit_price", field(offsetof(Trade, exitPrice), sizeof(double), "d")) ||
+        setItem(dict, "profit", field(offsetof(Trade, profit), sizeof(double), "d")) ||
+        setItem(dict, "profit_percent", field(offsetof(Trade, profitPercent), sizeof(double), "d")) ||
+        setItem(dict, "direction", field(offsetof(Trade, direction), sizeof(int), "i"))) {
+        Py_XDECREF(dict);
+        return nullptr;
+    }
+    return dict;
+}
+
+PyObject* backtesterMetrics(BacktesterObject* self, PyObject* args) {
+    Py_ssize_t index = 0;
+    if (!PyArg_ParseTuple(args, "n", &index) || !checkIndex(self, index)) {
+        return nullptr;
+    }
+    double values[crypto::backtester::kNumMetricFields];
+    crypto::backtester::metricsToArray(self->backtester->getStrategy(index)->getMetrics(), values);
+
+    PyObject* dict = PyDict_New();
+    for (int f = 0; dict && f < crypto::backtester::kNumMetricFields; ++f) {
+        if (setItem(dict, crypto::backtester::kMetricNames[f], PyFloat_FromDouble(values[f]))) {
+            Py_DECREF(dict);
+            return nullptr;
+        }
+    }
+    return dict;
+}
+
+PyObject* backtesterPrices(BacktesterObject* self, PyObject*) {
+    if (!hasBacktester(self)) {
+        return nullptr;
+    }
+    return pricesOf(reinterpret_cast<PyObject*>(self), &self->views, self->backtester->getDataLoader());
+}
+
+PyObject* backtesterIndicator(BacktesterObject* self, PyObject* args, PyObject* kwargs) {
+    IndicatorRequest request;
+    Py_ssize_t output = 0;
+    if (!hasBacktester(self) || !parseRequest(args, kwargs, request, &output)) {
+        return nullptr;
+    }
+    return indicatorView(reinterpret_cast<PyObject*>(self), &self->views,
+                         self->backtester->getDataLoader(), request, output);
+}
+
+PyMethodDef kBacktesterMethods[] = {
+    {"add_strategy", slot<PyCFunction>(backtesterAddStrategy), METH_VARARGS,
+     "add_strategy(spec): 'sma 20 50', 'ensemble <expr>' or a grid 'sma:5..50/5,50..200/25'"},
+    {"set_indicator_cache", slot<PyCFunction>(backtesterSetIndicatorCache), METH_VARARGS,
+     "Persist indicators under a directory"},
+    {"run", slot<PyCFunction>(backtesterRun), METH_VARARGS | METH_KEYWORDS,
+     "run(initial_capital=10000, position_size=0.95, threads=1, verbose=False), without the GIL"},
+    {"strategies", slot<PyCFunction>(backtesterStrategies), METH_NOARGS, "Strategy names"},
+    {"equity", slot<PyCFunction>(backtesterEquity), METH_VARARGS, "Zero-copy equity curve"},
+    {"trades", slot<PyCFunction>(backtesterTrades), METH_VARARGS, "Dict of zero-copy trade fields"},
+    {"metrics", slot<PyCFunction>(backtesterMetrics), METH_VARARGS, "Dict of performance metrics"},
+    {"prices", slot<PyCFunction>(backtesterPrices), METH_NOARGS, "Dict of zero-copy price columns"},
+    {"indicator", slot<PyCFunction>(backtesterIndicator), METH_VARARGS | METH_KEYWORDS,
+     "indicator(kind, period, param=0, param2=0, output=0): zero-copy view of a computed indicator"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyTypeObject BacktesterType{};
+
+// Indicator functions on arbitrary float64 series
+
+PyObject* moduleEMA(PyObject*, PyObject* args) {
+    PyObject* input = nullptr;
+    int period = 0;
+    std::vector<double> values;
+    if (!PyArg_ParseTuple(args, "Oi", &input, &period) || !readDoubles(input, values)) {
+        return nullptr;
+    }
+    std::vector<double> ema;
+    Py_BEGIN_ALLOW_THREADS
+    ema = crypto::data::computeEMA(values, period);
+    Py_END_ALLOW_THREADS
+    return ownedArray(std::move(ema));
+}
+
+PyObject* moduleMACD(PyObject*, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = {"close", "fast", "slow", "signal", nullptr};
+    PyObject* input = nullptr;
+    int fast = 12;
+    int slow = 26;
+    int signal = 9;
+    std::vector<double> values;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iii", const_cast<char**>(keywords),
+                                     &input, &fast, &slow, &signal) || !readDoubles(input, values)) {
+        return nullptr;
+    }
+    crypto::data::MACDSeries macd;
+    Py_BEGIN_ALLOW_THREADS
+    macd = crypto::data::computeMACD(values, fast, slow, signal);
+    Py_END_ALLOW_THREADS
+
+    PyObject* dict = PyDict_New();
+    if (!dict ||
+        setItem(dict, "line", ownedArray(std::move(macd.line))) ||
+        setItem(dict, "signal", ownedArray(std::move(macd.signal))) ||
+        setItem(dict, "histogram", ownedArray(std::move(macd.histogram)))) {
+        Py_XDECREF(dict);
+        return nullptr;
+    }
+    return dict;
+}
+
+PyMethodDef kModuleMethods[] = {
+    {"ema", slot<PyCFunction>(moduleEMA), METH_VARARGS, "ema(values, period): SMA-seeded EMA of a float64 series"},
+    {"macd", slot<PyCFunction>(moduleMACD), METH_VARARGS | METH_KEYWORDS,
+     "macd(close, fast=12, slow=26, signal=9): dict of line, signal, histogram"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef kModule = {
+    PyModuleDef_HEAD_INIT, "crypto_backtester",
+    "Zero-copy access to the C++ backtesting engine", -1, kModuleMethods, nullptr, nullptr, nullptr, nullptr
+};
+
+// The type objects start zeroed; give each the reference a static type
+// normally gets from PyVarObject_HEAD_INIT before readying it
+bool addType(PyObject* module, PyTypeObject* type, const char* name) {
+    Py_SET_REFCNT(type, 1);
+    if (PyType_Ready(type) < 0) {
+        return false;
+    }
+    Py_INCREF(type);
+    if (PyModule_AddObject(module, name, reinterpret_cast<PyObject*>(type)) < 0) {
+        Py_DECREF(type);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+PyMODINIT_FUNC PyInit_crypto_backtester() {
+    ArrayType.tp_name = "crypto_backtester.Array";
+    ArrayType.tp_basicsize = sizeof(ArrayObject);
+    ArrayType.tp_flags = Py_TPFLAGS_DEFAULT;
+    ArrayType.tp_doc = "Read-only view of engine memory (buffer protocol)";
+    ArrayType.tp_dealloc = slot<destructor>(arrayDealloc);
+    ArrayType.tp_as_buffer = &kArrayBuffer;
+    ArrayType.tp_as_sequence = &kArraySequence;
+    ArrayType.tp_repr = slot<reprfunc>(arrayRepr);
+
+    LoaderType.tp_name = "crypto_backtester.DataLoader";
+    LoaderType.tp_basicsize = sizeof(LoaderObject);
+    LoaderType.tp_flags = Py_TPFLAGS_DEFAULT;
+    LoaderType.tp_doc = "DataLoader(path=''): CSV bars and indicators";
+    LoaderType.tp_new = PyType_GenericNew;
+    LoaderType.tp_init = slot<initproc>(loaderInit);
+    LoaderType.tp_dealloc = slot<destructor>(loaderDealloc);
+    LoaderType.tp_methods = kLoaderMethods;
+    LoaderType.tp_as_sequence = &kLoaderSequence;
+
+    BacktesterType.tp_name = "crypto_backtester.Backtester";
+    BacktesterType.tp_basicsize = sizeof(BacktesterObject);
+    BacktesterType.tp_flags = Py_TPFLAGS_DEFAULT;
+    BacktesterType.tp_doc = "Backtester(path): strategies over one dataset";
+    BacktesterType.tp_new = PyType_GenericNew;
+    BacktesterType.tp_init = slot<initproc>(backtesterInit);
+    BacktesterType.tp_dealloc = slot<destructor>(backtesterDealloc);
+    BacktesterType.tp_methods = kBacktesterMethods;
+
+    PyObject* module = PyModule_Create(&kModule);
+    if (!module) {
+        return nullptr;
+    }
+    if (!addType(module, &ArrayType, "Array") || !addType(module, &LoaderType, "DataLoader") ||
+        !addType(module, &BacktesterType, "Backtester")) {
+        Py_DECREF(module);
+        return nullptr;
+    }
+    return module;
+}
@@ -5,6 +5,9 @@ Visualize the backtesting results generated by the C++ backtester.
 
 import os
 import glob
+import mmap
+import struct
+import numpy as np
 import pandas as pd
 import matplotlib.pyplot as plt
 import matplotlib.dates as mdates
@@ -31,6 +34,51 @@ def load_strategy_data():
     
     return strategies
 
+# Layout of the memory-mapped result file written by Backtester::publishResultsTo
+# (see include/backtester/result_store.h)
+STORE_HEADER = struct.Struct('<8sII12QQ')
+STORE_NAME_LENGTH = 64
+STORE_METRICS = ['Total Return', 'Annual Return', 'Sharpe Ratio', 'Sortino Ratio', 'Calmar Ratio',
+                 'Volatility', 'Max Drawdown', 'Max Drawdown Duration', 'Exposure', 'Win Rate',
+                 'Total Trades', 'Rolling Sharpe 30', 'Rolling Sharpe 90', 'Rolling Sharpe 365',
+                 'Rolling Volatility 30', 'Rolling Volatility 90', 'Rolling Volatility 365']
+
+def load_strategy_store(path="strategy_results.bin"):
+    """Load finished strategies from the result store without copying.
+
+    Equity curves are NumPy views onto the shared mapping, so this can be called
+    while the backtester is still running; only slots marked ready are returned.
+    """
+    with open(path, 'rb') as f:
+        buf = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+    (magic, version, fields, capacity, bars, max_trades, name_off, state_off, metrics_off,
+     trade_count_off, timestamp_off, close_off, equity_off, trades_off, file_size,
+     published) = STORE_HEADER.unpack_from(buf, 0)
+
+    if magic != b'CTSBRES\0' or version != 2:
+        raise ValueError(f"{path} is not a result store")
+
+    state = np.frombuffer(buf, dtype='<u8', count=capacity, offset=state_off)
+    metrics = np.frombuffer(buf, dtype='<f8', count=capacity * fields, offset=metrics_off).reshape(capacity, fields)
+    timestamps = np.frombuffer(buf, dtype='<i8', count=bars, offset=timestamp_off)
+    closes = np.frombuffer(buf, dtype='<f8', count=bars, offset=close_off)
+    equity = np.frombuffer(buf, dtype='<f8', count=capacity * bars, offset=equity_off).reshape(capacity, bars)
+    dates = pd.to_datetime(timestamps, unit='s')
+
+    strategies = []
+    rows = []
+    for slot in np.flatnonzero(state == 1):
+        raw = buf[name_off + slot * STORE_NAME_LENGTH:name_off + (slot + 1) * STORE_NAME_LENGTH]
+        name = raw.split(b'\0', 1)[0].decode()
+        df = pd.DataFrame({'Date': dates, 'Close': closes, 'Equity': equity[slot]}, copy=False)
+        strategies.append((name, df))
+        rows.append([name] + list(metrics[slot]))
+        print(f"Loaded {bars} records for {name} from {path}")
+
+    summary = pd.DataFrame(rows, columns=['Strategy'] + STORE_METRICS[:fields])
+    return strategies, summary
+
 def plot_comparison(strategies):
     """Plot a comparison of all strategy equity curves."""
     plt.figure(figsize=(12, 8))
@@ -119,7 +167,10 @@ def plot_performance_metrics():
 
 if __name__ == "__main__":
     print("Loading strategy data...")
-    strategies = load_strategy_data()
+    if os.path.exists("strategy_results.bin"):
+        strategies, _ = load_strategy_store("strategy_results.bin")
+    else:
+        strategies = load_strategy_data()
     
     if not strategies:
         print("No strategy data found. Make sure to run the backtester first.")
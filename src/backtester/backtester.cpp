@@ -1,45 +1,118 @@
 #include "backtester/backtester.h"
+#include "backtester/leaderboard.h"
+#include "utils/csv_utils.h"
+#include "utils/memory_accounting.h"
+#include "utils/thread_pool.h"
 #include <iostream>
 #include <iomanip>
 #include <fstream>
 #include <algorithm>
+#include <set>
 
 namespace crypto {
 namespace backtester {
 
-Backtester::Backtester(const std::string& dataPath) : m_dataLoader(dataPath) {
-    if (!m_dataLoader.loadData()) {
-        std::cerr << "Failed to load data from " << dataPath << ". Exiting..." << std::endl;
-        exit(1);
+Backtester::Backtester(const std::string& dataPath, const data::ValidationConfig& validation) 
+    : m_dataLoader(dataPath), m_initialCapital(10000.0), m_positionSize(1.0), m_loaded(false) {
+    m_dataLoader.setValidation(validation);
+    m_loaded = m_dataLoader.loadData();
+    if (!m_loaded) {
+        std::cerr << "Failed to load data from " << dataPath << std::endl;
     }
 }
 
+bool Backtester::isLoaded() const {
+    return m_loaded;
+}
+
 void Backtester::addStrategy(std::shared_ptr<strategies::Strategy> strategy) {
     m_strategies.push_back(strategy);
     std::cout << "Added strategy: " << strategy->getName() << std::endl;
 }
 
+void Backtester::publishResultsTo(const std::string& storePath, bool selectedOnly) {
+    m_storePath = storePath;
+    m_publishSelected = selectedOnly;
+}
+
+void Backtester::publishSelection(const std::vector<size_t>& selection) {
+    if (m_storePath.empty()) {
+        return;
+    }
+    const auto& priceData = m_dataLoader.getData();
+    if (!m_resultStore.create(m_storePath, selection.size(), priceData, priceData.size())) {
+        return;
+    }
+    for (size_t slot = 0; slot < selection.size(); ++slot) {
+        m_resultStore.publish(slot, *m_strategies[selection[slot]]);
+        m_strategies[selection[slot]]->releaseResults();
+    }
+    std::cout << "Published " << selection.size() << " selected strategies to " << m_storePath << std::endl;
+}
+
+void Backtester::setIndicatorCache(const std::string& dir) {
+    m_dataLoader.setIndicatorCache(dir);
+}
+
 void Backtester::run(double initialCapital, double positionSize) {
+    prepare(initialCapital, positionSize);
+    
+    for (size_t i = 0; i < m_strategies.size(); ++i) {
+        runStrategy(i);
+    }
+}
+
+void Backtester::prepare(double initialCapital, double positionSize, utils::ThreadPool* pool, int node) {
+    m_initialCapital = initialCapital;
+    m_positionSize = positionSize;
+    
     std::cout << "\nPreparing indicators for backtesting..." << std::endl;
     
-    // Calculate all indicators that might be needed by strategies
-    m_dataLoader.addSMA(20);
-    m_dataLoader.addSMA(50);
-    m_dataLoader.addSMA(200);
-    m_dataLoader.addEMA(12);
-    m_dataLoader.addEMA(26);
-    m_dataLoader.addRSI(14);
-    m_dataLoader.addBollingerBands(20, 2.0);
+    // Calculate each indicator the strategies need, once
+    std::set<data::IndicatorRequest> indicators;
+    for (const auto& strategy : m_strategies) {
+        for (const auto& request : strategy->requiredIndicators()) {
+            indicators.insert(request);
+        }
+    }
+    m_dataLoader.addIndicators(std::vector<data::IndicatorRequest>(indicators.begin(), indicators.end()), pool, node);
+    utils::markMilestone("indicators ready");
     
     std::cout << "\nRunning backtests with initial capital: $" << initialCapital 
               << ", position size: " << (positionSize * 100) << "%" << std::endl;
     
-    // Run backtest for each strategy
-    for (auto& strategy : m_strategies) {
-        strategy->backtest(m_dataLoader, initialCapital, positionSize);
+    // Size the result store for every strategy; a trade needs at least one bar
+    if (!m_storePath.empty() && !m_publishSelected) {
+        const auto& priceData = m_dataLoader.getData();
+        if (m_resultStore.create(m_storePath, m_strategies.size(), priceData, priceData.size())) {
+            std::cout << "Publishing results to " << m_storePath << std::endl;
+        }
+    }
+}
+
+void Backtester::runStrategy(size_t index) {
+    m_strategies[index]->backtest(m_dataLoader, m_initialCapital, m_positionSize);
+    
+    // Each strategy owns its slot, so concurrent publishes do not overlap
+    if (m_resultStore.isOpen()) {
+        m_resultStore.publish(index, *m_strategies[index]);
+        // A lazy curve rebuilt for the store is not kept around
+        m_strategies[index]->releaseResults();
     }
 }
 
+size_t Backtester::getStrategyCount() const {
+    return m_strategies.size();
+}
+
+std::shared_ptr<strategies::Strategy> Backtester::getStrategy(size_t index) const {
+    return m_strategies.at(index);
+}
+
+const data::DataLoader& Backtester::getDataLoader() const {
+    return m_dataLoader;
+}
+
 void Backtester::compareStrategies() const {
     if (m_strategies.empty()) {
         std::cerr << "No strategies to compare." << std::endl;
@@ -53,11 +126,13 @@ void Backtester::compareStrategies() const {
               << std::right << std::setw(15) << "Total Return" 
               << std::setw(15) << "Annual Return" 
               << std::setw(15) << "Sharpe Ratio" 
+              << std::setw(15) << "Sortino Ratio" 
               << std::setw(15) << "Max Drawdown" 
               << std::setw(15) << "Win Rate" 
+              << std::setw(15) << "Exposure" 
               << std::setw(15) << "Total Trades" << std::endl;
     
-    std::cout << std::string(105, '-') << std::endl;
+    std::cout << std::string(135, '-') << std::endl;
     
     // Data
     for (const auto& strategy : m_strategies) {
@@ -65,13 +140,25 @@ void Backtester::compareStrategies() const {
                   << std::right << std::setw(15) << std::fixed << std::setprecision(2) << strategy->getTotalReturn() << "%" 
                   << std::setw(15) << strategy->getAnnualReturn() << "%" 
                   << std::setw(15) << std::setprecision(2) << strategy->getSharpeRatio() 
+                  << std::setw(15) << std::setprecision(2) << strategy->getSortinoRatio() 
                   << std::setw(15) << std::setprecision(2) << strategy->getMaxDrawdown() << "%" 
                   << std::setw(15) << std::setprecision(2) << strategy->getWinRate() << "%" 
+                  << std::setw(15) << std::setprecision(2) << strategy->getExposure() << "%" 
                   << std::setw(15) << strategy->getTotalTrades() << std::endl;
     }
 }
 
-void Backtester::exportResults(const std::string& outputDir) const {
+void Backtester::exportResults(const std::string& outputDir, utils::ThreadPool* pool, int node,
+                               const std::vector<size_t>* selection) const {
+    std::vector<size_t> indices;
+    if (selection) {
+        indices = *selection;
+    } else {
+        for (size_t s = 0; s < m_strategies.size(); ++s) {
+            indices.push_back(s);
+        }
+    }
+    
     // Create strategy comparison CSV
     std::string comparisonFile = outputDir + "/strategy_comparison.csv";
     std::ofstream outfile(comparisonFile);
@@ -82,53 +169,130 @@ void Backtester::exportResults(const std::string& outputDir) const {
     }
     
     // Write header
-    outfile << "Strategy,Total Return,Annual Return,Sharpe Ratio,Max Drawdown,Win Rate,Total Trades\n";
+    outfile << "Strategy,Total Return,Annual Return,Sharpe Ratio,Max Drawdown,Win Rate,Total Trades,"
+            << "Sortino Ratio,Calmar Ratio,Volatility,Max Drawdown Duration,Exposure\n";
     
     // Write data for each strategy
-    for (const auto& strategy : m_strategies) {
-        outfile << strategy->getName() << "," 
+    for (size_t s : indices) {
+        const auto& strategy = m_strategies[s];
+        outfile << utils::csvField(strategy->getName()) << "," 
                 << strategy->getTotalReturn() << "," 
                 << strategy->getAnnualReturn() << "," 
                 << strategy->getSharpeRatio() << "," 
                 << strategy->getMaxDrawdown() << "," 
                 << strategy->getWinRate() << "," 
-                << strategy->getTotalTrades() << "\n";
+                << strategy->getTotalTrades() << "," 
+                << strategy->getSortinoRatio() << "," 
+                << strategy->getCalmarRatio() << "," 
+                << strategy->getVolatility() << "," 
+                << strategy->getMaxDrawdownDuration() << "," 
+                << strategy->getExposure() << "\n";
     }
     
     outfile.close();
     std::cout << "Strategy comparison exported to " << comparisonFile << std::endl;
     
     // Export individual strategy results
-    const auto& priceData = m_dataLoader.getData();
-    
-    for (const auto& strategy : m_strategies) {
-        // Create filename (replace spaces with underscores)
-        std::string strategyName = strategy->getName();
+    std::vector<std::string> filenames;
+    for (size_t s : indices) {
+        // Create filename (replace spaces with underscores, path separators with dashes)
+        std::string strategyName = m_strategies[s]->getName();
         std::replace(strategyName.begin(), strategyName.end(), ' ', '_');
-        std::string filename = outputDir + "/" + strategyName + ".csv";
-        
-        std::ofstream stratFile(filename);
-        
-        if (!stratFile.is_open()) {
-            std::cerr << "Failed to open file for writing: " << filename << std::endl;
-            continue;
+        std::replace(strategyName.begin(), strategyName.end(), '/', '-');
+        filenames.push_back(outputDir + "/" + strategyName + ".csv");
+    }
+    
+    std::vector<char> written(indices.size(), 0);
+    if (pool) {
+        utils::TaskGroup group(*pool);
+        for (size_t i = 0; i < indices.size(); ++i) {
+            group.submit([this, &indices, &filenames, &written, i] {
+                written[i] = exportStrategy(*m_strategies[indices[i]], filenames[i]);
+                m_strategies[indices[i]]->releaseResults();
+            }, node);
+        }
+        group.wait();
+    } else {
+        for (size_t i = 0; i < indices.size(); ++i) {
+            written[i] = exportStrategy(*m_strategies[indices[i]], filenames[i]);
+            m_strategies[indices[i]]->releaseResults();
+        }
+    }
+    
+    // Reported in strategy order however the writes were scheduled
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (written[i]) {
+            std::cout << "Results for " << m_strategies[indices[i]]->getName() << " exported to " << filenames[i] << std::endl;
+        } else {
+            std::cerr << "Failed to open file for writing: " << filenames[i] << std::endl;
         }
-        
-        // Header
-        stratFile << "Date,Close,Equity\n";
-        
-        const auto& equityCurve = strategy->getEquityCurve();
-        
-        // Data
-        for (size_t i = 0; i < equityCurve.size(); ++i) {
-            stratFile << priceData[i].date << "," 
-                    << priceData[i].close << "," 
-                    << equityCurve[i] << "\n";
+    }
+}
+
+bool Backtester::exportStrategy(const strategies::Strategy& strategy, const std::string& filename) const {
+    std::ofstream stratFile(filename);
+    if (!stratFile.is_open()) {
+        return false;
+    }
+    
+    // Header
+    stratFile << "Date,Close,Equity\n";
+    
+    const auto& priceData = m_dataLoader.getData();
+    const auto& equityCurve = strategy.getEquityCurve();
+    
+    // Data
+    for (size_t i = 0; i < equityCurve.size(); ++i) {
+        stratFile << data::formatTimestamp(priceData[i].unix_time) << "," 
+                << priceData[i].close << "," 
+                << equityCurve[i] << "\n";
+    }
+    return true;
+}
+
+std::vector<SweepResult> Backtester::runSweep(const std::vector<strategies::StrategySpec>& grid,
+                                             const SweepOptions& options) {
+    SweepCoordinator coordinator(m_dataLoader, options);
+    std::vector<SweepResult> results = coordinator.run(grid);
+    coordinator.printSummary();
+    
+    // Show the best parameter sets by Sharpe ratio, and the trade-offs
+    Leaderboard board(10, "Sharpe Ratio");
+    for (size_t i = 0; i < results.size(); ++i) {
+        board.offer(i, results[i].name, results[i].metrics);
+    }
+    board.collect();
+    board.print(std::cout);
+    
+    return results;
+}
+
+void Backtester::exportSweepResults(const std::vector<SweepResult>& results, const std::string& outputDir) const {
+    std::string filename = outputDir + "/sweep_results.csv";
+    std::ofstream outfile(filename);
+    
+    if (!outfile.is_open()) {
+        std::cerr << "Failed to open file for writing: " << filename << std::endl;
+        return;
+    }
+    
+    outfile << "Strategy,Spec";
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        outfile << "," << kMetricNames[f];
+    }
+    outfile << "\n";
+    
+    double values[kNumMetricFields];
+    for (const auto& result : results) {
+        outfile << utils::csvField(result.name) << "," << utils::csvField(strategies::formatSpec(result.spec));
+        metricsToArray(result.metrics, values);
+        for (int f = 0; f < kNumMetricFields; ++f) {
+            outfile << "," << values[f];
         }
-        
-        stratFile.close();
-        std::cout << "Results for " << strategy->getName() << " exported to " << filename << std::endl;
+        outfile << "\n";
     }
+    
+    std::cout << "Sweep results exported to " << filename << std::endl;
 }
 
 } // namespace backtester
@@ -0,0 +1,60 @@
+#include "backtester/compressed_backtest.h"
+
+namespace crypto {
+namespace backtester {
+
+std::vector<CompressedBacktestResult> backtestCompressed(
+    const std::vector<std::shared_ptr<strategies::Strategy>>& strategies,
+    const data::CompressedBars& bars, double initialCapital, double positionSize) {
+    const size_t lanes = strategies.size();
+    std::vector<CompressedBacktestResult> results(lanes);
+    if (lanes == 0 || bars.size() == 0) {
+        return results;
+    }
+
+    std::vector<std::unique_ptr<strategies::SignalStream>> streams;
+    std::vector<strategies::PositionEngine> engines;
+    streams.reserve(lanes);
+    engines.reserve(lanes);
+    for (const auto& strategy : strategies) {
+        streams.push_back(strategy->createSignalStream());
+        engines.emplace_back(strategy->getPositionConfig(), initialCapital, positionSize);
+        engines.back().reset();
+    }
+
+    MetricsAccumulator metrics(initialCapital, lanes);
+    std::vector<double> equity(lanes, initialCapital);
+    std::vector<unsigned char> inPosition(lanes, 0);
+    data::BarBlock block;
+
+    for (size_t b = 0; b < bars.blockCount(); ++b) {
+        bars.decodeBlock(b, block);
+        for (size_t i = 0; i < block.count; ++i) {
+            const data::OHLCV bar = block.bar(i);
+            const size_t index = block.first + i;
+            for (size_t s = 0; s < lanes; ++s) {
+                strategies::Signal signal = streams[s]->update(bar);
+                engines[s].step(index, bar.close, signal);
+                // Same expression as PositionEngine::markToMarket
+                if (index > 0) {
+                    equity[s] = engines[s].cash() + engines[s].heldUnits() * bar.close;
+                    inPosition[s] = engines[s].heldUnits() != 0.0;
+                }
+            }
+            metrics.update(equity.data(), inPosition.data());
+        }
+    }
+
+    for (size_t s = 0; s < lanes; ++s) {
+        results[s].trades = engines[s].getTrades();
+        for (const auto& trade : results[s].trades) {
+            metrics.addTrade(trade.profit, s);
+        }
+        results[s].metrics = metrics.finalize(s);
+        results[s].finalEquity = equity[s];
+    }
+    return results;
+}
+
+} // namespace backtester
+} // namespace crypto
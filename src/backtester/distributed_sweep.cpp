@@ -0,0 +1,557 @@
+#include "backtester/distributed_sweep.h"
+#include "strategies/ensemble_strategy.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace crypto {
+namespace backtester {
+
+namespace {
+
+// Line protocol over the socket pair:
+//   coordinator -> worker:  SHARD <id> <attempt> <n>\n  followed by n spec lines
+//                           QUIT\n
+//   worker -> coordinator:  RESULT <id> <seconds> <n>\n followed by n lines of
+//                           <spec>\t<name>\t<kNumMetricFields metrics>
+
+bool sendAll(int fd, const std::string& message) {
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t n = ::send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Blocking line read for the worker side
+bool readLine(int fd, std::string& buffer, std::string& line) {
+    while (true) {
+        size_t newline = buffer.find('\n');
+        if (newline != std::string::npos) {
+            line = buffer.substr(0, newline);
+            buffer.erase(0, newline + 1);
+            return true;
+        }
+
+        char chunk[4096];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+std::string formatResult(const SweepResult& result) {
+    std::ostringstream out;
+    out.precision(17);
+    out << strategies::formatSpec(result.spec) << "\t" << result.name << "\t";
+
+    double values[kNumMetricFields];
+    metricsToArray(result.metrics, values);
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        out << (f ? " " : "") << values[f];
+    }
+    return out.str();
+}
+
+bool parseResult(const std::string& line, SweepResult& result) {
+    size_t tab1 = line.find('\t');
+    size_t tab2 = tab1 == std::string::npos ? std::string::npos : line.find('\t', tab1 + 1);
+    if (tab2 == std::string::npos) {
+        return false;
+    }
+
+    if (!strategies::parseSpec(line.substr(0, tab1), result.spec)) {
+        return false;
+    }
+    result.name = line.substr(tab1 + 1, tab2 - tab1 - 1);
+
+    // strtod rather than operator>> so inf/nan metrics survive the round trip
+    const char* cursor = line.c_str() + tab2 + 1;
+    double values[kNumMetricFields];
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        char* end = nullptr;
+        values[f] = std::strtod(cursor, &end);
+        if (end == cursor) {
+            return false;
+        }
+        cursor = end;
+    }
+    result.metrics = metricsFromArray(values);
+    return true;
+}
+
+// Worker process main loop; never returns
+[[noreturn]] void workerMain(int fd, data::DataLoader& data, const SweepOptions& options) {
+    std::string buffer;
+    std::string line;
+
+    while (readLine(fd, buffer, line)) {
+        std::istringstream header(line);
+        std::string command;
+        size_t id = 0;
+        int attempt = 0;
+        size_t count = 0;
+        header >> command >> id >> attempt >> count;
+
+        if (command != "SHARD") {
+            break;
+        }
+
+        std::vector<strategies::StrategySpec> specs(count);
+        for (size_t i = 0; i < count; ++i) {
+            if (!readLine(fd, buffer, line) || !strategies::parseSpec(line, specs[i])) {
+                _exit(2);
+            }
+        }
+
+        // Fault injection so retries can be exercised on a single machine
+        if (options.failEveryNthShard > 0 && attempt == 1 &&
+            (id + 1) % static_cast<size_t>(options.failEveryNthShard) == 0) {
+            _exit(3);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<SweepResult> results = runSpecs(data, specs, options.initialCapital, options.positionSize);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::ostringstream reply;
+        reply.precision(17);
+        reply << "RESULT " << id << " " << seconds << " " << results.size() << "\n";
+        for (const auto& result : results) {
+            reply << formatResult(result) << "\n";
+        }
+
+        if (!sendAll(fd, reply.str())) {
+            break;
+        }
+    }
+
+    _exit(0);
+}
+
+} // namespace
+
+std::vector<SweepResult> runSpecs(
+    data::DataLoader& data,
+    const std::vector<strategies::StrategySpec>& specs,
+    double initialCapital,
+    double positionSize
+) {
+    std::vector<SweepResult> results;
+    results.reserve(specs.size());
+    auto signalCache = std::make_shared<strategies::SignalCache>();
+
+    for (const auto& spec : specs) {
+        SweepResult result;
+        result.spec = spec;
+        result.name = strategies::formatSpec(spec);
+
+        auto strategy = strategies::createStrategy(spec, signalCache);
+        if (strategy) {
+            // DataLoader caches indicators, so shared periods are computed once
+            for (const auto& request : strategy->requiredIndicators()) {
+                data.addIndicator(request);
+            }
+            // Only the metrics are reported, so no curve is ever built
+            strategy->setLazyResults(true);
+            strategy->backtest(data, initialCapital, positionSize);
+            result.name = strategy->getName();
+            result.metrics = strategy->getMetrics();
+        }
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+SweepCoordinator::SweepCoordinator(data::DataLoader& data, const SweepOptions& options)
+    : m_data(data), m_options(options) {}
+
+SweepCoordinator::~SweepCoordinator() {
+    for (size_t slot = 0; slot < m_workers.size(); ++slot) {
+        stopWorker(slot, true);
+    }
+}
+
+std::vector<SweepResult> SweepCoordinator::run(const std::vector<strategies::StrategySpec>& grid) {
+    buildShards(grid);
+    m_stats.clear();
+    m_shardResults.assign(m_shards.size(), {});
+
+    std::cout << "Sweeping " << grid.size() << " parameter sets in " << m_shards.size()
+              << " shards on " << m_options.workers << " workers" << std::endl;
+
+    m_workers.assign(std::max(m_options.workers, 0), Worker());
+    for (size_t slot = 0; slot < m_workers.size(); ++slot) {
+        spawnWorker(slot);
+    }
+
+    while (true) {
+        // Hand pending shards to idle workers
+        for (size_t slot = 0; slot < m_workers.size() && !m_pending.empty(); ++slot) {
+            if (m_workers[slot].pid > 0 && m_workers[slot].shard < 0) {
+                dispatch(slot, grid);
+            }
+        }
+
+        std::vector<pollfd> fds;
+        std::vector<size_t> slots;
+        for (size_t slot = 0; slot < m_workers.size(); ++slot) {
+            if (m_workers[slot].shard >= 0) {
+                fds.push_back({m_workers[slot].fd, POLLIN, 0});
+                slots.push_back(slot);
+            }
+        }
+
+        if (fds.empty()) {
+            if (m_pending.empty()) {
+                break;
+            }
+
+            // No live workers (or workers = 0): finish the remaining shards here
+            if (!m_workers.empty()) {
+                std::cerr << "Warning: No sweep workers available, running "
+                          << m_pending.size() << " shards in-process" << std::endl;
+            }
+            for (int id : m_pending) {
+                Shard& shard = m_shards[id];
+                std::vector<strategies::StrategySpec> specs;
+                for (size_t index : shard.specIndices) {
+                    specs.push_back(grid[index]);
+                }
+                auto start = std::chrono::steady_clock::now();
+                m_shardResults[id] = runSpecs(m_data, specs, m_options.initialCapital, m_options.positionSize);
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                shard.attempts++;
+                shard.done = true;
+                m_stats.push_back({static_cast<size_t>(id), shard.type, specs.size(), shard.attempts, -1, seconds, false});
+            }
+            m_pending.clear();
+            break;
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Error: poll failed during sweep" << std::endl;
+            break;
+        }
+
+        for (size_t i = 0; i < fds.size(); ++i) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            std::vector<SweepResult> results;
+            if (!collect(slots[i], results)) {
+                handleFailure(slots[i]);
+            }
+        }
+    }
+
+    for (size_t slot = 0; slot < m_workers.size(); ++slot) {
+        stopWorker(slot, false);
+    }
+
+    // Reassemble results in grid order, leaving out shards that failed
+    std::vector<SweepResult> ordered(grid.size());
+    std::vector<bool> filled(grid.size(), false);
+    for (size_t id = 0; id < m_shards.size(); ++id) {
+        const auto& indices = m_shards[id].specIndices;
+        for (size_t k = 0; k < m_shardResults[id].size() && k < indices.size(); ++k) {
+            ordered[indices[k]] = std::move(m_shardResults[id][k]);
+            filled[indices[k]] = true;
+        }
+    }
+
+    std::vector<SweepResult> results;
+    results.reserve(grid.size());
+    for (size_t i = 0; i < grid.size(); ++i) {
+        if (filled[i]) {
+            results.push_back(std::move(ordered[i]));
+        }
+    }
+    return results;
+}
+
+const std::vector<ShardStats>& SweepCoordinator::getShardStats() const {
+    return m_stats;
+}
+
+void SweepCoordinator::printSummary() const {
+    size_t failed = 0;
+    size_t retried = 0;
+    std::map<int, double> busy;
+
+    for (const auto& stat : m_stats) {
+        failed += stat.failed ? 1 : 0;
+        retried += stat.attempts > 1 ? 1 : 0;
+        if (!stat.failed) {
+            busy[stat.worker] += stat.seconds;
+        }
+    }
+
+    std::cout << "\n============= Sweep Summary =============\n";
+    std::cout << "Shards: " << m_stats.size() << ", retried: " << retried << ", failed: " << failed << "\n";
+    for (const auto& [worker, seconds] : busy) {
+        std::cout << (worker < 0 ? std::string("in-process") : "worker " + std::to_string(worker))
+                  << ": " << std::fixed << std::setprecision(3) << seconds << "s busy\n";
+    }
+    for (const auto& [type, cost] : m_costPerSpec) {
+        std::cout << "Measured cost " << type << ": " << std::setprecision(3) << cost * 1e3 << " ms/spec\n";
+    }
+}
+
+void SweepCoordinator::buildShards(const std::vector<strategies::StrategySpec>& grid) {
+    m_shards.clear();
+    m_pending.clear();
+
+    size_t shardSize = m_options.shardSize;
+    if (shardSize == 0) {
+        size_t target = static_cast<size_t>(std::max(m_options.workers, 1)) * 4;
+        shardSize = std::max<size_t>(1, (grid.size() + target - 1) / target);
+    }
+
+    // Shards hold a single strategy type so measured cost maps onto that type
+    std::map<std::string, std::vector<size_t>> byType;
+    for (size_t i = 0; i < grid.size(); ++i) {
+        byType[grid[i].type].push_back(i);
+    }
+
+    for (const auto& [type, indices] : byType) {
+        for (size_t begin = 0; begin < indices.size(); begin += shardSize) {
+            Shard shard;
+            shard.type = type;
+            size_t end = std::min(indices.size(), begin + shardSize);
+            shard.specIndices.assign(indices.begin() + begin, indices.begin() + end);
+            m_pending.push_back(static_cast<int>(m_shards.size()));
+            m_shards.push_back(shard);
+        }
+    }
+}
+
+bool SweepCoordinator::spawnWorker(size_t slot) {
+    int sockets[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0) {
+        std::cerr << "Error: Could not create socket pair for sweep worker" << std::endl;
+        return false;
+    }
+
+    // Flush so buffered output is not duplicated into the child
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    pid_t pid = ::fork();
+    if (pid < 0) {
+        std::cerr << "Error: Could not fork sweep worker" << std::endl;
+        ::close(sockets[0]);
+        ::close(sockets[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        // Child: keep only its own end, silence per-strategy console output
+        ::close(sockets[0]);
+        for (const auto& worker : m_workers) {
+            if (worker.fd >= 0) {
+                ::close(worker.fd);
+            }
+        }
+        if (!std::freopen("/dev/null", "w", stdout)) {
+            _exit(4);
+        }
+        workerMain(sockets[1], m_data, m_options);
+    }
+
+    ::close(sockets[1]);
+    m_workers[slot].pid = pid;
+    m_workers[slot].fd = sockets[0];
+    m_workers[slot].shard = -1;
+    m_workers[slot].buffer.clear();
+    return true;
+}
+
+void SweepCoordinator::stopWorker(size_t slot, bool kill) {
+    Worker& worker = m_workers[slot];
+    if (worker.pid <= 0) {
+        return;
+    }
+
+    if (kill) {
+        ::kill(worker.pid, SIGKILL);
+    } else {
+        sendAll(worker.fd, "QUIT\n");
+    }
+    ::close(worker.fd);
+    ::waitpid(worker.pid, nullptr, 0);
+
+    worker = Worker();
+}
+
+bool SweepCoordinator::dispatch(size_t slot, const std::vector<strategies::StrategySpec>& grid) {
+    int id = nextShard();
+    m_pending.erase(std::find(m_pending.begin(), m_pending.end(), id));
+
+    Shard& shard = m_shards[id];
+    shard.attempts++;
+
+    std::ostringstream message;
+    message.precision(17);
+    message << "SHARD " << id << " " << shard.attempts << " " << shard.specIndices.size() << "\n";
+    for (size_t index : shard.specIndices) {
+        message << strategies::formatSpec(grid[index]) << "\n";
+    }
+
+    m_workers[slot].shard = id;
+    if (!sendAll(m_workers[slot].fd, message.str())) {
+        handleFailure(slot);
+        return false;
+    }
+    return true;
+}
+
+bool SweepCoordinator::collect(size_t slot, std::vector<SweepResult>& results) {
+    Worker& worker = m_workers[slot];
+
+    char chunk[65536];
+    ssize_t n = ::read(worker.fd, chunk, sizeof(chunk));
+    if (n < 0 && errno == EINTR) {
+        return true;
+    }
+    if (n <= 0) {
+        return false;
+    }
+    worker.buffer.append(chunk, static_cast<size_t>(n));
+
+    // Wait for the header plus all of its result lines
+    size_t headerEnd = worker.buffer.find('\n');
+    if (headerEnd == std::string::npos) {
+        return true;
+    }
+
+    std::istringstream header(worker.buffer.substr(0, headerEnd));
+    std::string command;
+    size_t id = 0;
+    double seconds = 0.0;
+    size_t count = 0;
+    header >> command >> id >> seconds >> count;
+    if (command != "RESULT" || static_cast<int>(id) != worker.shard) {
+        return false;
+    }
+
+    size_t end = headerEnd;
+    for (size_t i = 0; i < count; ++i) {
+        end = worker.buffer.find('\n', end + 1);
+        if (end == std::string::npos) {
+            return true;
+        }
+    }
+
+    std::istringstream body(worker.buffer.substr(headerEnd + 1, end - headerEnd));
+    std::string line;
+    for (size_t i = 0; i < count; ++i) {
+        SweepResult result;
+        if (!std::getline(body, line) || !parseResult(line, result)) {
+            return false;
+        }
+        results.push_back(result);
+    }
+    worker.buffer.erase(0, end + 1);
+
+    // Record the shard and refine the cost model for its strategy type
+    Shard& shard = m_shards[id];
+    shard.done = true;
+    m_shardResults[id] = results;
+    m_stats.push_back({id, shard.type, count, shard.attempts, static_cast<int>(slot), seconds, false});
+
+    double perSpec = count > 0 ? seconds / count : 0.0;
+    auto it = m_costPerSpec.find(shard.type);
+    if (it == m_costPerSpec.end()) {
+        m_costPerSpec[shard.type] = perSpec;
+    } else {
+        it->second = 0.5 * (it->second + perSpec);
+    }
+
+    worker.shard = -1;
+    return true;
+}
+
+void SweepCoordinator::handleFailure(size_t slot) {
+    int id = m_workers[slot].shard;
+    stopWorker(slot, true);
+
+    if (id >= 0) {
+        Shard& shard = m_shards[id];
+        if (shard.attempts <= m_options.maxRetries) {
+            std::cerr << "Warning: Sweep worker " << slot << " died on shard " << id
+                      << ", retrying (attempt " << shard.attempts + 1 << ")" << std::endl;
+            m_pending.push_back(id);
+        } else {
+            std::cerr << "Error: Shard " << id << " failed after " << shard.attempts << " attempts" << std::endl;
+            m_stats.push_back({static_cast<size_t>(id), shard.type, shard.specIndices.size(),
+                               shard.attempts, -1, 0.0, true});
+        }
+    }
+
+    spawnWorker(slot);
+}
+
+int SweepCoordinator::nextShard() const {
+    // Longest-processing-time first keeps the tail of the sweep short
+    int best = m_pending.front();
+    double bestCost = estimatedCost(m_shards[best]);
+    for (int id : m_pending) {
+        double cost = estimatedCost(m_shards[id]);
+        if (cost > bestCost) {
+            best = id;
+            bestCost = cost;
+        }
+    }
+    return best;
+}
+
+double SweepCoordinator::estimatedCost(const Shard& shard) const {
+    auto it = m_costPerSpec.find(shard.type);
+    double perSpec = 1.0;
+
+    if (it != m_costPerSpec.end()) {
+        perSpec = it->second;
+    } else if (!m_costPerSpec.empty()) {
+        // Unmeasured types are assumed as costly as the worst measured one,
+        // so they get sampled early
+        perSpec = 0.0;
+        for (const auto& entry : m_costPerSpec) {
+            perSpec = std::max(perSpec, entry.second);
+        }
+    }
+
+    return perSpec * shard.specIndices.size();
+}
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,500 @@
+#include "backtester/golden_harness.h"
+#include "backtester/performance_metrics.h"
+#include "data/data_loader.h"
+#include "strategies/strategy_factory.h"
+#include "utils/csv_utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+
+namespace crypto {
+namespace backtester {
+
+namespace {
+
+constexpr double kInitialCapital = 10000.0;
+constexpr double kPositionSize = 0.95;
+const char* const kStages[] = {"load", "indicators", "signals", "backtest"};
+
+struct Scenario {
+    std::string name;
+    std::vector<data::OHLCV> bars;   // Empty for the file-backed scenario
+};
+
+struct ScenarioResult {
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> metrics;
+    std::vector<std::vector<double>> equity;
+    std::map<std::string, double> nsPerBar;
+    std::vector<std::string> problems;
+};
+
+// Discards std::cout while strategies print their per-run summaries
+class CoutSilencer {
+public:
+    CoutSilencer() : m_previous(std::cout.rdbuf(nullptr)) {}
+    ~CoutSilencer() {
+        std::cout.rdbuf(m_previous);
+        std::cout.clear();
+    }
+
+private:
+    std::streambuf* m_previous;
+};
+
+// SplitMix64 plus Box-Muller, so series are identical on every platform
+// (std::normal_distribution is implementation-defined)
+class DeterministicRng {
+public:
+    explicit DeterministicRng(uint64_t seed) : m_state(seed) {}
+
+    double uniform() {
+        uint64_t z = (m_state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z ^= z >> 31;
+        return (static_cast<double>(z >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+    }
+
+    double normal() {
+        double u1 = uniform();
+        double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    uint64_t m_state;
+};
+
+std::vector<data::OHLCV> makeBars(const std::vector<double>& closes) {
+    std::vector<data::OHLCV> bars(closes.size());
+    const int64_t start = 1577836800;  // 2020-01-01
+
+    for (size_t i = 0; i < closes.size(); ++i) {
+        data::OHLCV& bar = bars[i];
+        bar.unix_time = start + static_cast<int64_t>(i) * 86400;
+        bar.open = i > 0 ? closes[i - 1] : closes[i];
+        bar.close = closes[i];
+        bar.high = std::max(bar.open, bar.close) * 1.002;
+        bar.low = std::min(bar.open, bar.close) * 0.998;
+        bar.volume_btc = 1.0;
+        bar.volume_usd = bar.close;
+    }
+    return bars;
+}
+
+std::vector<Scenario> makeScenarios() {
+    std::vector<Scenario> scenarios;
+    scenarios.push_back({"btc_historical", {}});
+
+    // Trending geometric Brownian motion
+    {
+        DeterministicRng rng(42);
+        std::vector<double> closes(3000);
+        double price = 100.0;
+        for (auto& close : closes) {
+            price *= std::exp(0.0004 + 0.03 * rng.normal());
+            close = price;
+        }
+        scenarios.push_back({"synthetic_trend", makeBars(closes)});
+    }
+
+    // Mean-reverting (Ornstein-Uhlenbeck in log price) range market
+    {
+        DeterministicRng rng(7);
+        std::vector<double> closes(3000);
+        double logPrice = std::log(100.0);
+        for (auto& close : closes) {
+            logPrice += 0.05 * (std::log(100.0) - logPrice) + 0.02 * rng.normal();
+            close = std::exp(logPrice);
+        }
+        scenarios.push_back({"synthetic_range", makeBars(closes)});
+    }
+
+    return scenarios;
+}
+
+std::vector<std::shared_ptr<strategies::Strategy>> makeReferenceStrategies() {
+    const std::vector<strategies::StrategySpec> specs = {
+        {"sma", {20, 50}},
+        {"sma", {50, 200}},
+        {"rsi", {14, 30, 70}},
+        {"bb", {20, 2.0}}
+    };
+
+    std::vector<std::shared_ptr<strategies::Strategy>> result;
+    for (const auto& spec : specs) {
+        result.push_back(strategies::createStrategy(spec));
+    }
+    return result;
+}
+
+bool closeEnough(double a, double b, double tolerance) {
+    if (a == b || (std::isnan(a) && std::isnan(b))) {
+        return true;
+    }
+    double scale = std::max({1.0, std::fabs(a), std::fabs(b)});
+    return std::fabs(a - b) <= tolerance * scale;
+}
+
+// The standalone metrics API must agree with what backtest() reports
+void checkConsistency(const strategies::Strategy& strategy, double tolerance, std::vector<std::string>& problems) {
+    std::vector<std::pair<double, double>> trades;
+    for (const auto& trade : strategy.getTrades()) {
+        // A short wins when the exit is below the entry
+        if (trade.direction < 0) {
+            trades.emplace_back(trade.exitPrice, trade.entryPrice);
+        } else {
+            trades.emplace_back(trade.entryPrice, trade.exitPrice);
+        }
+    }
+
+    PerformanceMetrics standalone = calculateMetrics(strategy.getEquityCurve(), trades, kInitialCapital, 365);
+    double expected[kNumMetricFields];
+    double actual[kNumMetricFields];
+    metricsToArray(strategy.getMetrics(), expected);
+    metricsToArray(standalone, actual);
+
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        // Without position flags calculateMetrics must not guess at exposure
+        if (std::string(kMetricNames[f]) == "Exposure") {
+            if (!std::isnan(actual[f])) {
+                problems.push_back(strategy.getName() + ": calculateMetrics reports an exposure of " +
+                                   std::to_string(actual[f]) + " without position flags");
+            }
+            continue;
+        }
+        if (!closeEnough(expected[f], actual[f], tolerance)) {
+            problems.push_back(strategy.getName() + ": calculateMetrics " + kMetricNames[f] + " = " +
+                               std::to_string(actual[f]) + ", backtest reports " + std::to_string(expected[f]));
+        }
+    }
+
+    // The deepest point of the per-bar drawdown series is the max drawdown
+    std::vector<double> drawdowns = calculateDrawdown(strategy.getEquityCurve(), kInitialCapital);
+    double deepest = drawdowns.empty() ? 0.0 : -*std::min_element(drawdowns.begin(), drawdowns.end());
+    if (!closeEnough(deepest, strategy.getMetrics().maxDrawdown, tolerance)) {
+        problems.push_back(strategy.getName() + ": calculateDrawdown bottoms at " + std::to_string(deepest) +
+                           "%, backtest reports a max drawdown of " + std::to_string(strategy.getMetrics().maxDrawdown) + "%");
+    }
+}
+
+// Reproducible return statistics must not depend on thread count, and must
+// agree with the streaming accumulator's Sharpe ratio
+void checkReproducibility(const strategies::Strategy& strategy, double tolerance, std::vector<std::string>& problems) {
+    const auto& equity = strategy.getEquityCurve();
+    ReturnStatistics serial = calculateReturnStatistics(equity);
+    for (size_t threads : {2, 3, 8}) {
+        utils::ThreadPool pool(threads);
+        ReturnStatistics parallel = calculateReturnStatistics(equity, utils::ReductionMode::Reproducible, &pool);
+        if (parallel.mean != serial.mean || parallel.stdDev != serial.stdDev ||
+            parallel.downsideDev != serial.downsideDev) {
+            problems.push_back(strategy.getName() + ": reproducible return statistics differ on " +
+                               std::to_string(threads) + " threads");
+        }
+    }
+
+    double sharpe = serial.stdDev > 0.0 ? serial.mean / serial.stdDev * std::sqrt(252.0) : 0.0;
+    if (!closeEnough(sharpe, strategy.getMetrics().sharpeRatio, tolerance)) {
+        problems.push_back(strategy.getName() + ": reproducible Sharpe ratio = " + std::to_string(sharpe) +
+                           ", backtest reports " + std::to_string(strategy.getMetrics().sharpeRatio));
+    }
+}
+
+// A lazy backtest must report the same metrics without building a curve,
+// and its replay must rebuild exactly the curve and trades of a full one
+void checkLazyResults(const strategies::Strategy& full, strategies::Strategy& lazy, const data::DataLoader& loader,
+                      std::vector<std::string>& problems) {
+    lazy.setLazyResults(true);
+    lazy.backtest(loader, kInitialCapital, kPositionSize);
+
+    double expected[kNumMetricFields];
+    double actual[kNumMetricFields];
+    metricsToArray(full.getMetrics(), expected);
+    metricsToArray(lazy.getMetrics(), actual);
+    if (std::memcmp(expected, actual, sizeof(expected)) != 0) {
+        problems.push_back(full.getName() + ": lazy backtest metrics differ from the full backtest");
+    }
+
+    const auto& trades = lazy.getTrades();
+    bool sameTrades = trades.size() == full.getTrades().size();
+    for (size_t t = 0; sameTrades && t < trades.size(); ++t) {
+        const auto& a = trades[t];
+        const auto& b = full.getTrades()[t];
+        sameTrades = a.entryIndex == b.entryIndex && a.exitIndex == b.exitIndex && a.profit == b.profit;
+    }
+    if (lazy.getEquityCurve() != full.getEquityCurve() || !sameTrades) {
+        problems.push_back(full.getName() + ": replayed equity curve or trades differ from the full backtest");
+    }
+}
+
+bool runScenario(const Scenario& scenario, const GoldenOptions& options, ScenarioResult& result) {
+    using Clock = std::chrono::steady_clock;
+    auto seconds = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double>(b - a).count();
+    };
+
+    for (int run = 0; run < std::max(options.timingRuns, 1); ++run) {
+        CoutSilencer silence;
+        data::DataLoader loader(options.dataPath);
+
+        auto t0 = Clock::now();
+        if (scenario.bars.empty()) {
+            if (!loader.loadData()) {
+                return false;
+            }
+        } else {
+            loader.setData(scenario.bars);
+        }
+        auto t1 = Clock::now();
+
+        auto strategies = makeReferenceStrategies();
+        std::set<data::IndicatorRequest> requests;
+        for (const auto& strategy : strategies) {
+            for (const auto& request : strategy->requiredIndicators()) {
+                requests.insert(request);
+            }
+        }
+        for (const auto& request : requests) {
+            loader.addIndicator(request);
+        }
+        auto t2 = Clock::now();
+
+        // Kept by each strategy, so the backtest stage does not regenerate them
+        for (const auto& strategy : strategies) {
+            strategy->prepareSignals(loader);
+        }
+        auto t3 = Clock::now();
+
+        for (const auto& strategy : strategies) {
+            strategy->backtest(loader, kInitialCapital, kPositionSize);
+        }
+        auto t4 = Clock::now();
+
+        const double bars = static_cast<double>(std::max<size_t>(loader.getData().size(), 1));
+        const double stageSeconds[] = {seconds(t0, t1), seconds(t1, t2), seconds(t2, t3), seconds(t3, t4)};
+        for (int s = 0; s < 4; ++s) {
+            double ns = stageSeconds[s] * 1e9 / bars;
+            auto it = result.nsPerBar.find(kStages[s]);
+            if (it == result.nsPerBar.end() || ns < it->second) {
+                result.nsPerBar[kStages[s]] = ns;
+            }
+        }
+
+        // Keep outputs from the final run
+        if (run + 1 >= options.timingRuns) {
+            result.names.clear();
+            result.metrics.clear();
+            result.equity.clear();
+            auto lazy = makeReferenceStrategies();
+            for (size_t i = 0; i < strategies.size(); ++i) {
+                checkLazyResults(*strategies[i], *lazy[i], loader, result.problems);
+            }
+            for (const auto& strategy : strategies) {
+                std::vector<double> values(kNumMetricFields);
+                metricsToArray(strategy->getMetrics(), values.data());
+                result.names.push_back(strategy->getName());
+                result.metrics.push_back(values);
+                result.equity.push_back(strategy->getEquityCurve());
+                checkConsistency(*strategy, options.tolerance, result.problems);
+                checkReproducibility(*strategy, options.tolerance, result.problems);
+            }
+        }
+    }
+
+    return true;
+}
+
+std::string metricsPath(const GoldenOptions& options, const Scenario& scenario) {
+    return options.goldenDir + "/" + scenario.name + "_metrics.csv";
+}
+
+std::string equityPath(const GoldenOptions& options, const Scenario& scenario) {
+    return options.goldenDir + "/" + scenario.name + "_equity.csv";
+}
+
+std::string budgetPath(const GoldenOptions& options) {
+    return options.goldenDir + "/budgets.csv";
+}
+
+} // namespace
+
+bool recordGolden(const GoldenOptions& options) {
+    std::filesystem::create_directories(options.goldenDir);
+
+    std::ofstream budgets(budgetPath(options));
+    if (!budgets.is_open()) {
+        std::cerr << "Failed to open file for writing: " << budgetPath(options) << std::endl;
+        return false;
+    }
+    budgets << "Scenario,Stage,Ns Per Bar\n";
+
+    for (const auto& scenario : makeScenarios()) {
+        ScenarioResult result;
+        if (!runScenario(scenario, options, result)) {
+            std::cerr << "Failed to run golden scenario " << scenario.name << std::endl;
+            return false;
+        }
+
+        std::ofstream metrics(metricsPath(options, scenario));
+        std::ofstream equity(equityPath(options, scenario));
+        if (!metrics.is_open() || !equity.is_open()) {
+            std::cerr << "Failed to write golden outputs for " << scenario.name << std::endl;
+            return false;
+        }
+        metrics << std::setprecision(17);
+        equity << std::setprecision(17);
+
+        metrics << "Strategy";
+        for (int f = 0; f < kNumMetricFields; ++f) {
+            metrics << "," << kMetricNames[f];
+        }
+        metrics << "\n";
+        for (size_t s = 0; s < result.names.size(); ++s) {
+            metrics << result.names[s];
+            for (double value : result.metrics[s]) {
+                metrics << "," << value;
+            }
+            metrics << "\n";
+        }
+
+        equity << "Index";
+        for (const auto& name : result.names) {
+            equity << "," << name;
+        }
+        equity << "\n";
+        size_t bars = result.equity.empty() ? 0 : result.equity.front().size();
+        for (size_t i = 0; i < bars; ++i) {
+            equity << i;
+            for (const auto& curve : result.equity) {
+                equity << "," << curve[i];
+            }
+            equity << "\n";
+        }
+
+        for (const auto& [stage, ns] : result.nsPerBar) {
+            budgets << scenario.name << "," << stage << "," << ns * options.budgetHeadroom << "\n";
+        }
+
+        for (const auto& problem : result.problems) {
+            std::cerr << "Warning: " << scenario.name << ": " << problem << std::endl;
+        }
+        std::cout << "Recorded golden outputs for " << scenario.name << " ("
+                  << result.names.size() << " strategies, " << bars << " bars)" << std::endl;
+    }
+
+    return true;
+}
+
+bool verifyGolden(const GoldenOptions& options) {
+    // scenario -> stage -> ns/bar budget
+    std::map<std::string, std::map<std::string, double>> budgets;
+    for (const auto& row : utils::readCSV(budgetPath(options))) {
+        if (row.size() == 3) {
+            budgets[row[0]][row[1]] = std::stod(row[2]);
+        }
+    }
+    if (budgets.empty()) {
+        std::cerr << "Error: No golden budgets in " << options.goldenDir
+                  << ". Record them first with --record-golden." << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+
+    for (const auto& scenario : makeScenarios()) {
+        ScenarioResult result;
+        if (!runScenario(scenario, options, result)) {
+            std::cerr << "FAIL " << scenario.name << ": could not run scenario" << std::endl;
+            passed = false;
+            continue;
+        }
+
+        std::vector<std::string> problems = result.problems;
+
+        // Metrics, matched by strategy name
+        auto metricRows = utils::readCSV(metricsPath(options, scenario));
+        if (metricRows.size() != result.names.size()) {
+            problems.push_back("expected " + std::to_string(metricRows.size()) + " strategies, got " +
+                               std::to_string(result.names.size()));
+        }
+        for (const auto& row : metricRows) {
+            auto it = std::find(result.names.begin(), result.names.end(), row.empty() ? "" : row[0]);
+            if (it == result.names.end() || row.size() != kNumMetricFields + 1) {
+                problems.push_back("golden strategy " + (row.empty() ? std::string("?") : row[0]) + " missing");
+                continue;
+            }
+            const auto& actual = result.metrics[it - result.names.begin()];
+            for (int f = 0; f < kNumMetricFields; ++f) {
+                double expected = std::stod(row[f + 1]);
+                if (!closeEnough(expected, actual[f], options.tolerance)) {
+                    problems.push_back(row[0] + " " + kMetricNames[f] + ": expected " +
+                                       row[f + 1] + ", got " + std::to_string(actual[f]));
+                }
+            }
+        }
+
+        // Equity curves, column order matches result.names
+        auto equityRows = utils::readCSV(equityPath(options, scenario));
+        size_t bars = result.equity.empty() ? 0 : result.equity.front().size();
+        if (equityRows.size() != bars) {
+            problems.push_back("equity curves have " + std::to_string(bars) + " bars, golden has " +
+                               std::to_string(equityRows.size()));
+        } else {
+            for (size_t s = 0; s < result.equity.size(); ++s) {
+                for (size_t i = 0; i < bars; ++i) {
+                    if (equityRows[i].size() <= s + 1) {
+                        problems.push_back("golden equity row " + std::to_string(i) + " is short");
+                        break;
+                    }
+                    double expected = std::stod(equityRows[i][s + 1]);
+                    if (!closeEnough(expected, result.equity[s][i], options.tolerance)) {
+                        problems.push_back(result.names[s] + " equity diverges at bar " + std::to_string(i) +
+                                           ": expected " + equityRows[i][s + 1] + ", got " +
+                                           std::to_string(result.equity[s][i]));
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Performance budgets
+        std::cout << "\n" << scenario.name << "\n";
+        for (const auto& [stage, ns] : result.nsPerBar) {
+            auto it = budgets[scenario.name].find(stage);
+            bool hasBudget = it != budgets[scenario.name].end();
+            bool withinBudget = !hasBudget || ns <= it->second;
+            std::cout << "  " << std::left << std::setw(12) << stage << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(10) << ns << " ns/bar";
+            if (hasBudget) {
+                std::cout << "  (budget " << it->second << ")";
+            }
+            std::cout << (withinBudget ? "" : "  OVER BUDGET") << "\n";
+            if (!withinBudget) {
+                problems.push_back(stage + " stage took " + std::to_string(ns) + " ns/bar, budget " +
+                                   std::to_string(it->second));
+            }
+        }
+
+        for (const auto& problem : problems) {
+            std::cout << "  FAIL " << problem << "\n";
+        }
+        std::cout << "  " << (problems.empty() ? "PASS" : "FAIL") << std::endl;
+        passed = passed && problems.empty();
+    }
+
+    std::cout << "\nGolden verification " << (passed ? "passed" : "FAILED") << std::endl;
+    return passed;
+}
+
+} // namespace backtester
+} // namespace crypto
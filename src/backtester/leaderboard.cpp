@@ -0,0 +1,336 @@
+#include "backtester/leaderboard.h"
+#include "utils/csv_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+namespace crypto {
+namespace backtester {
+
+namespace {
+
+std::atomic<uint64_t> g_nextBoardId{1};
+
+double metricValue(const PerformanceMetrics& metrics, int field) {
+    double values[kNumMetricFields];
+    metricsToArray(metrics, values);
+    return values[field];
+}
+
+bool lowerIsBetter(const std::string& metric) {
+    return metric == "Max Drawdown" || metric == "Max Drawdown Duration" ||
+           metric.compare(0, 10, "Volatility") == 0 || metric.compare(0, 18, "Rolling Volatility") == 0;
+}
+
+// Higher return, lower drawdown and higher Sharpe, strictly better in one
+bool dominates(const PerformanceMetrics& a, const PerformanceMetrics& b) {
+    if (a.totalReturn < b.totalReturn || a.maxDrawdown > b.maxDrawdown || a.sharpeRatio < b.sharpeRatio) {
+        return false;
+    }
+    return a.totalReturn > b.totalReturn || a.maxDrawdown < b.maxDrawdown || a.sharpeRatio > b.sharpeRatio;
+}
+
+bool hasFrontMetrics(const PerformanceMetrics& metrics) {
+    return !std::isnan(metrics.totalReturn) && !std::isnan(metrics.maxDrawdown) && !std::isnan(metrics.sharpeRatio);
+}
+
+} // namespace
+
+Leaderboard::Leaderboard(size_t topK, const std::string& metric, bool pareto)
+    : m_topK(topK), m_field(2), m_lowerIsBetter(false), m_pareto(pareto),
+      m_boardId(g_nextBoardId++), m_cutoff(0.0), m_full(false), m_offered(0) {
+    if (!findMetric(metric, m_field)) {
+        std::cerr << "Warning: Unknown leaderboard metric \"" << metric << "\", ranking by Sharpe Ratio" << std::endl;
+    }
+    m_lowerIsBetter = lowerIsBetter(kMetricNames[m_field]);
+}
+
+bool Leaderboard::findMetric(const std::string& name, int& field) {
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        if (name == kMetricNames[f]) {
+            field = f;
+            return true;
+        }
+    }
+    return false;
+}
+
+Leaderboard::Slot& Leaderboard::localSlot() {
+    // Slots of the boards this thread has offered to. Ids are never reused,
+    // so entries left by a destroyed board simply stop matching.
+    static thread_local std::vector<std::pair<uint64_t, Slot*>> slots;
+    for (const auto& entry : slots) {
+        if (entry.first == m_boardId) {
+            return *entry.second;
+        }
+    }
+
+    Slot* slot;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slots.emplace_back();
+        slot = &m_slots.back();
+    }
+    if (slots.size() >= 16) {
+        slots.erase(slots.begin());
+    }
+    slots.emplace_back(m_boardId, slot);
+    return *slot;
+}
+
+double Leaderboard::score(const PerformanceMetrics& metrics) const {
+    return metricValue(metrics, m_field);
+}
+
+bool Leaderboard::better(const LeaderboardEntry& a, const LeaderboardEntry& b) const {
+    double sa = score(a.metrics);
+    double sb = score(b.metrics);
+    if (sa != sb) {
+        return m_lowerIsBetter ? sa < sb : sa > sb;
+    }
+    return a.id < b.id;   // Ties keep the earlier entry, however the threads interleaved
+}
+
+void Leaderboard::pushTopK(std::vector<LeaderboardEntry>& heap, LeaderboardEntry entry) const {
+    auto order = [this](const LeaderboardEntry& a, const LeaderboardEntry& b) { return better(a, b); };
+    if (heap.size() < m_topK) {
+        heap.push_back(std::move(entry));
+        std::push_heap(heap.begin(), heap.end(), order);
+    } else if (better(entry, heap.front())) {
+        std::pop_heap(heap.begin(), heap.end(), order);
+        heap.back() = std::move(entry);
+        std::push_heap(heap.begin(), heap.end(), order);
+    }
+}
+
+bool Leaderboard::dominated(const std::vector<LeaderboardEntry>& front, const PerformanceMetrics& metrics) {
+    for (const auto& member : front) {
+        if (dominates(member.metrics, metrics)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Leaderboard::addToFront(std::vector<LeaderboardEntry>& front, const LeaderboardEntry& entry) {
+    for (const auto& member : front) {
+        if (member.id == entry.id || dominates(member.metrics, entry.metrics)) {
+            return;
+        }
+    }
+    front.erase(std::remove_if(front.begin(), front.end(), [&entry](const LeaderboardEntry& member) {
+        return dominates(entry.metrics, member.metrics);
+    }), front.end());
+    front.push_back(entry);
+}
+
+void Leaderboard::offer(size_t id, const std::string& name, const PerformanceMetrics& metrics) {
+    double value = score(metrics);
+    if (std::isnan(value)) {
+        return;
+    }
+    m_offered.fetch_add(1, std::memory_order_relaxed);
+
+    // Most of a large sweep fails both tests without copying anything
+    bool ranks = m_topK > 0;
+    if (ranks && m_full.load(std::memory_order_acquire)) {
+        double cutoff = m_cutoff.load(std::memory_order_relaxed);
+        ranks = m_lowerIsBetter ? value <= cutoff : value >= cutoff;
+    }
+    bool front = m_pareto && hasFrontMetrics(metrics);
+
+    Slot& slot = localSlot();
+    if (front) {
+        front = !dominated(slot.front, metrics) && !dominated(slot.known, metrics);
+    }
+    if (ranks || front) {
+        LeaderboardEntry entry{id, name, metrics};
+        if (front) {
+            addToFront(slot.front, entry);
+        }
+        if (ranks) {
+            pushTopK(slot.heap, std::move(entry));
+        }
+    }
+
+    if (++slot.pending >= kMergeEvery) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        mergeLocked(slot);
+    }
+}
+
+void Leaderboard::mergeLocked(Slot& slot) {
+    for (auto& entry : slot.heap) {
+        pushTopK(m_heap, std::move(entry));
+    }
+    slot.heap.clear();
+
+    for (const auto& entry : slot.front) {
+        addToFront(m_front, entry);
+    }
+    slot.front.clear();
+    if (m_pareto) {
+        slot.known = m_front;
+    }
+    slot.pending = 0;
+
+    if (m_topK > 0 && m_heap.size() == m_topK) {
+        m_cutoff.store(score(m_heap.front().metrics), std::memory_order_relaxed);
+        m_full.store(true, std::memory_order_release);
+    }
+}
+
+void Leaderboard::collect() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& slot : m_slots) {
+        mergeLocked(slot);
+    }
+}
+
+std::vector<LeaderboardEntry> Leaderboard::snapshot() const {
+    std::vector<LeaderboardEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entries = m_heap;
+    }
+    std::sort(entries.begin(), entries.end(), [this](const LeaderboardEntry& a, const LeaderboardEntry& b) {
+        return better(a, b);
+    });
+    return entries;
+}
+
+std::vector<LeaderboardEntry> Leaderboard::paretoFront() const {
+    std::vector<LeaderboardEntry> entries;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        entries = m_front;
+    }
+    std::sort(entries.begin(), entries.end(), [](const LeaderboardEntry& a, const LeaderboardEntry& b) {
+        if (a.metrics.totalReturn != b.metrics.totalReturn) {
+            return a.metrics.totalReturn > b.metrics.totalReturn;
+        }
+        return a.id < b.id;
+    });
+    return entries;
+}
+
+std::vector<size_t> Leaderboard::selection() const {
+    std::vector<size_t> ids;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& entry : m_heap) {
+            ids.push_back(entry.id);
+        }
+        for (const auto& entry : m_front) {
+            ids.push_back(entry.id);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    return ids;
+}
+
+size_t Leaderboard::offered() const {
+    return m_offered.load(std::memory_order_relaxed);
+}
+
+const std::string& Leaderboard::metricName() const {
+    static const std::vector<std::string> names(kMetricNames, kMetricNames + kNumMetricFields);
+    return names[m_field];
+}
+
+void Leaderboard::printRows(std::ostream& out, const std::vector<LeaderboardEntry>& rows, bool ranked) const {
+    out << std::left << std::setw(6) << "Rank" << std::setw(30) << "Strategy"
+        << std::right << std::setw(15) << "Total Return"
+        << std::setw(15) << "Sharpe Ratio"
+        << std::setw(15) << "Max Drawdown"
+        << std::setw(15) << "Total Trades";
+    bool extra = ranked && m_field != 0 && m_field != 2 && m_field != 6 && m_field != 10;
+    if (extra) {
+        out << std::setw(24) << metricName();
+    }
+    out << std::endl << std::string(extra ? 120 : 96, '-') << std::endl;
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        const auto& m = rows[i].metrics;
+        out << std::left << std::setw(6) << (i + 1) << std::setw(30) << rows[i].name
+            << std::right << std::setw(15) << std::fixed << std::setprecision(2) << m.totalReturn << "%"
+            << std::setw(15) << m.sharpeRatio
+            << std::setw(15) << m.maxDrawdown << "%"
+            << std::setw(15) << m.totalTrades;
+        if (extra) {
+            out << std::setw(24) << metricValue(m, m_field);
+        }
+        out << std::endl;
+    }
+    out.unsetf(std::ios::fixed);
+    out << std::setprecision(6);
+}
+
+void Leaderboard::print(std::ostream& out, size_t rows) const {
+    auto top = snapshot();
+    if (rows > 0 && top.size() > rows) {
+        top.resize(rows);
+    }
+
+    if (m_topK > 0) {
+        out << "\n============= Top " << top.size() << " by " << metricName() << " (of "
+            << offered() << ") =============\n";
+        printRows(out, top, true);
+    }
+    if (m_pareto) {
+        auto front = paretoFront();
+        out << "\n============= Pareto Front: Return / Drawdown / Sharpe (" << front.size()
+            << ") =============\n";
+        printRows(out, front, false);
+    }
+}
+
+bool Leaderboard::writeCsv(const std::string& path) const {
+    auto top = snapshot();
+    auto front = paretoFront();
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream outfile(temporary);
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open file for writing: " << temporary << std::endl;
+            return false;
+        }
+
+        outfile << "Board,Rank,Id,Strategy";
+        for (int f = 0; f < kNumMetricFields; ++f) {
+            outfile << "," << kMetricNames[f];
+        }
+        outfile << "\n";
+
+        double values[kNumMetricFields];
+        auto writeRows = [&](const char* board, const std::vector<LeaderboardEntry>& rows) {
+            for (size_t i = 0; i < rows.size(); ++i) {
+                outfile << board << "," << (i + 1) << "," << rows[i].id << "," << utils::csvField(rows[i].name);
+                metricsToArray(rows[i].metrics, values);
+                for (int f = 0; f < kNumMetricFields; ++f) {
+                    outfile << "," << values[f];
+                }
+                outfile << "\n";
+            }
+        };
+        writeRows("top", top);
+        writeRows("pareto", front);
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cerr << "Failed to replace " << path << ": " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace backtester
+} // namespace crypto
@@ -1,89 +1,320 @@
 #include "backtester/performance_metrics.h"
 #include <cmath>
+#include <limits>
 #include <numeric>
 #include <algorithm>
 
 namespace crypto {
 namespace backtester {
 
+const char* const kMetricNames[kNumMetricFields] = {
+    "Total Return", "Annual Return", "Sharpe Ratio", "Sortino Ratio", "Calmar Ratio",
+    "Volatility", "Max Drawdown", "Max Drawdown Duration", "Exposure", "Win Rate",
+    "Total Trades", "Rolling Sharpe 30", "Rolling Sharpe 90", "Rolling Sharpe 365",
+    "Rolling Volatility 30", "Rolling Volatility 90", "Rolling Volatility 365"
+};
+
+void metricsToArray(const PerformanceMetrics& m, double* values) {
+    const double fields[kNumMetricFields] = {
+        m.totalReturn, m.annualReturn, m.sharpeRatio, m.sortinoRatio, m.calmarRatio,
+        m.volatility, m.maxDrawdown, static_cast<double>(m.maxDrawdownDuration), m.exposure,
+        m.winRate, static_cast<double>(m.totalTrades),
+        m.rollingSharpe[0], m.rollingSharpe[1], m.rollingSharpe[2],
+        m.rollingVolatility[0], m.rollingVolatility[1], m.rollingVolatility[2]
+    };
+    std::copy(fields, fields + kNumMetricFields, values);
+}
+
+PerformanceMetrics metricsFromArray(const double* values) {
+    PerformanceMetrics m;
+    m.totalReturn = values[0];
+    m.annualReturn = values[1];
+    m.sharpeRatio = values[2];
+    m.sortinoRatio = values[3];
+    m.calmarRatio = values[4];
+    m.volatility = values[5];
+    m.maxDrawdown = values[6];
+    m.maxDrawdownDuration = static_cast<int>(values[7]);
+    m.exposure = values[8];
+    m.winRate = values[9];
+    m.totalTrades = static_cast<int>(values[10]);
+    for (int w = 0; w < kNumRollingWindows; ++w) {
+        m.rollingSharpe[w] = values[11 + w];
+        m.rollingVolatility[w] = values[11 + kNumRollingWindows + w];
+    }
+    return m;
+}
+
+namespace {
+
+constexpr size_t kRingSize = 365;  // Longest rolling window
+
+// A window of equal returns can still show a deviation of an ulp or two
+// from rounding the mean; anything within this many ulps of the mean's
+// magnitude is zero volatility
+constexpr double kFlatUlps = 4.0;
+
+} // namespace
+
+MetricsAccumulator::MetricsAccumulator(double initialCapital, size_t lanes,
+                                       double periodsPerYear, double sharpePeriods)
+    : m_lanes(lanes), m_initialCapital(initialCapital),
+      m_periodsPerYear(periodsPerYear), m_sharpePeriods(sharpePeriods) {
+    reset(initialCapital);
+}
+
+void MetricsAccumulator::reset(double initialCapital) {
+    m_initialCapital = initialCapital;
+    m_bars = 0;
+    m_returns = 0;
+    m_ringHead = 0;
+
+    m_prevEquity.assign(m_lanes, initialCapital);
+    m_meanReturn.assign(m_lanes, 0.0);
+    m_m2.assign(m_lanes, 0.0);
+    m_downsideSq.assign(m_lanes, 0.0);
+    m_peak.assign(m_lanes, initialCapital);
+    m_maxDrawdown.assign(m_lanes, 0.0);
+    m_underwater.assign(m_lanes, 0.0);
+    m_maxUnderwater.assign(m_lanes, 0.0);
+    m_inPositionBars.assign(m_lanes, 0.0);
+    m_trades.assign(m_lanes, 0);
+    m_winningTrades.assign(m_lanes, 0);
+
+    m_ring.assign(kRingSize * m_lanes, 0.0);
+}
+
+size_t MetricsAccumulator::lanes() const {
+    return m_lanes;
+}
+
+void MetricsAccumulator::update(const double* equity, const unsigned char* inPosition) {
+    const size_t lanes = m_lanes;
+    double* peak = m_peak.data();
+    double* maxDrawdown = m_maxDrawdown.data();
+    double* underwater = m_underwater.data();
+    double* maxUnderwater = m_maxUnderwater.data();
+
+    // Drawdown, time under water and exposure apply to every bar
+    for (size_t l = 0; l < lanes; ++l) {
+        double e = equity[l];
+        peak[l] = std::max(peak[l], e);
+        double drawdown = peak[l] > 0.0 ? (peak[l] - e) / peak[l] : 0.0;
+        maxDrawdown[l] = std::max(maxDrawdown[l], drawdown);
+        underwater[l] = e < peak[l] ? underwater[l] + 1.0 : 0.0;
+        maxUnderwater[l] = std::max(maxUnderwater[l], underwater[l]);
+    }
+
+    if (inPosition) {
+        double* inPositionBars = m_inPositionBars.data();
+        for (size_t l = 0; l < lanes; ++l) {
+            inPositionBars[l] += inPosition[l] ? 1.0 : 0.0;
+        }
+    }
+
+    // Returns start from the second bar
+    if (m_bars++ == 0) {
+        std::copy(equity, equity + lanes, m_prevEquity.begin());
+        return;
+    }
+
+    ++m_returns;
+    const double invN = 1.0 / static_cast<double>(m_returns);
+    double* prev = m_prevEquity.data();
+    double* mean = m_meanReturn.data();
+    double* m2 = m_m2.data();
+    double* downsideSq = m_downsideSq.data();
+    double* slot = m_ring.data() + m_ringHead * lanes;
+
+    for (size_t l = 0; l < lanes; ++l) {
+        double r = prev[l] > 0.0 ? equity[l] / prev[l] - 1.0 : 0.0;
+
+        // Welford mean/variance of returns
+        double delta = r - mean[l];
+        mean[l] += delta * invN;
+        m2[l] += delta * (r - mean[l]);
+
+        double downside = std::min(r, 0.0);
+        downsideSq[l] += downside * downside;
+
+        slot[l] = r;
+        prev[l] = equity[l];
+    }
+
+    m_ringHead = (m_ringHead + 1) % kRingSize;
+}
+
+void MetricsAccumulator::update(double equity, bool inPosition) {
+    unsigned char flag = inPosition ? 1 : 0;
+    update(&equity, &flag);
+}
+
+void MetricsAccumulator::addTrade(double profit, size_t lane) {
+    m_trades[lane]++;
+    if (profit > 0.0) {
+        m_winningTrades[lane]++;
+    }
+}
+
+PerformanceMetrics MetricsAccumulator::finalize(size_t lane) const {
+    PerformanceMetrics metrics;
+
+    if (m_bars == 0) {
+        return metrics;
+    }
+
+    const double annualization = std::sqrt(m_sharpePeriods);
+
+    // Returns
+    metrics.totalReturn = (m_prevEquity[lane] / m_initialCapital - 1.0) * 100.0;
+    double years = static_cast<double>(m_bars) / m_periodsPerYear;
+    metrics.annualReturn = (std::pow(1.0 + metrics.totalReturn / 100.0, 1.0 / years) - 1.0) * 100.0;
+
+    // Risk-adjusted ratios (population statistics, risk-free rate of 0)
+    if (m_returns > 0) {
+        double meanReturn = m_meanReturn[lane];
+        double stdDev = std::sqrt(m_m2[lane] / m_returns);
+        double downsideDev = std::sqrt(m_downsideSq[lane] / m_returns);
+
+        metrics.sharpeRatio = stdDev > 0.0 ? meanReturn / stdDev * annualization : 0.0;
+        metrics.sortinoRatio = downsideDev > 0.0 ? meanReturn / downsideDev * annualization : 0.0;
+        metrics.volatility = stdDev * annualization * 100.0;
+    }
+
+    // Rolling windows: two-pass mean and variance of the last `window`
+    // returns in the ring, so a window that has gone flat reads as flat
+    // rather than as the rounding residue of returns that have left it
+    for (int w = 0; w < kNumRollingWindows; ++w) {
+        size_t window = static_cast<size_t>(kRollingWindows[w]);
+        if (m_returns < window) {
+            continue;
+        }
+        auto ringReturn = [&](size_t age) {
+            return m_ring[((m_ringHead + kRingSize - 1 - age) % kRingSize) * m_lanes + lane];
+        };
+        utils::CompensatedSum sum;
+        for (size_t age = 0; age < window; ++age) {
+            sum.add(ringReturn(age));
+        }
+        double mean = sum.value() / window;
+        utils::CompensatedSum squares;
+        for (size_t age = 0; age < window; ++age) {
+            double deviation = ringReturn(age) - mean;
+            squares.add(deviation * deviation);
+        }
+        double stdDev = std::sqrt(squares.value() / window);
+        if (stdDev <= kFlatUlps * std::numeric_limits<double>::epsilon() * std::abs(mean)) {
+            stdDev = 0.0;
+        }
+        metrics.rollingSharpe[w] = stdDev > 0.0 ? mean / stdDev * annualization : 0.0;
+        metrics.rollingVolatility[w] = stdDev * annualization * 100.0;
+    }
+
+    // Drawdown
+    metrics.maxDrawdown = m_maxDrawdown[lane] * 100.0;
+    metrics.maxDrawdownDuration = static_cast<int>(m_maxUnderwater[lane]);
+    metrics.calmarRatio = metrics.maxDrawdown > 0.0 ? metrics.annualReturn / metrics.maxDrawdown : 0.0;
+    metrics.exposure = m_inPositionBars[lane] / m_bars * 100.0;
+
+    // Trades
+    metrics.totalTrades = m_trades[lane];
+    metrics.winRate = metrics.totalTrades > 0 ?
+                    static_cast<double>(m_winningTrades[lane]) / metrics.totalTrades * 100.0 : 0.0;
+
+    return metrics;
+}
+
 PerformanceMetrics calculateMetrics(
     const std::vector<double>& equityCurve, 
     const std::vector<std::pair<double, double>>& trades,
     double initialCapital,
-    int daysInPeriod
+    int daysInPeriod,
+    const std::vector<unsigned char>& inPosition
 ) {
-    PerformanceMetrics metrics;
+    MetricsAccumulator accumulator(initialCapital, 1, daysInPeriod);
+    const bool positions = inPosition.size() == equityCurve.size();
     
-    if (equityCurve.empty()) {
-        return metrics;
+    for (size_t i = 0; i < equityCurve.size(); ++i) {
+        accumulator.update(&equityCurve[i], positions ? &inPosition[i] : nullptr);
     }
     
-    // Calculate total return
-    metrics.totalReturn = (equityCurve.back() / initialCapital - 1.0) * 100.0;
-    
-    // Calculate annualized return
-    double years = static_cast<double>(equityCurve.size()) / daysInPeriod;
-    metrics.annualReturn = (std::pow(1.0 + metrics.totalReturn / 100.0, 1.0 / years) - 1.0) * 100.0;
+    for (const auto& trade : trades) {
+        accumulator.addTrade(trade.second - trade.first);
+    }
     
-    // Calculate max drawdown
-    std::vector<double> drawdowns = calculateDrawdown(equityCurve);
-    metrics.maxDrawdown = drawdowns.empty() ? 0.0 : *std::min_element(drawdowns.begin(), drawdowns.end()) * -1.0;
+    PerformanceMetrics metrics = accumulator.finalize();
+    if (!positions) {
+        metrics.exposure = std::numeric_limits<double>::quiet_NaN();
+    }
+    return metrics;
+}
+
+std::vector<PerformanceMetrics> calculateMetricsBatch(
+    const std::vector<std::vector<double>>& equityCurves,
+    double initialCapital,
+    int daysInPeriod
+) {
+    std::vector<PerformanceMetrics> results;
     
-    // Calculate win rate
-    metrics.totalTrades = static_cast<int>(trades.size());
-    int winningTrades = 0;
+    if (equityCurves.empty()) {
+        return results;
+    }
     
-    for (const auto& trade : trades) {
-        if (trade.second > trade.first) {
-            winningTrades++;
-        }
+    size_t lanes = equityCurves.size();
+    size_t bars = equityCurves.front().size();
+    for (const auto& curve : equityCurves) {
+        bars = std::min(bars, curve.size());
     }
     
-    metrics.winRate = metrics.totalTrades > 0 ? 
-                    static_cast<double>(winningTrades) / metrics.totalTrades * 100.0 : 0.0;
+    MetricsAccumulator accumulator(initialCapital, lanes, daysInPeriod);
     
-    // Calculate daily returns for Sharpe ratio
-    std::vector<double> returns;
-    for (size_t i = 1; i < equityCurve.size(); ++i) {
-        returns.push_back(equityCurve[i] / equityCurve[i-1] - 1.0);
+    // Gather one bar across all curves, then reduce all lanes at once
+    std::vector<double> row(lanes);
+    for (size_t i = 0; i < bars; ++i) {
+        for (size_t l = 0; l < lanes; ++l) {
+            row[l] = equityCurves[l][i];
+        }
+        accumulator.update(row.data());
     }
     
-    metrics.sharpeRatio = calculateSharpeRatio(returns);
+    // Equity curves alone say nothing about when a position was held
+    results.reserve(lanes);
+    for (size_t l = 0; l < lanes; ++l) {
+        results.push_back(accumulator.finalize(l));
+        results.back().exposure = std::numeric_limits<double>::quiet_NaN();
+    }
     
-    return metrics;
+    return results;
 }
 
-std::vector<double> calculateDrawdown(const std::vector<double>& equityCurve) {
+std::vector<double> calculateDrawdown(const std::vector<double>& equityCurve, double initialCapital) {
     std::vector<double> drawdowns(equityCurve.size(), 0.0);
     
-    if (equityCurve.empty()) {
-        return drawdowns;
-    }
-    
-    double peak = equityCurve[0];
+    double peak = initialCapital;
     
     for (size_t i = 0; i < equityCurve.size(); ++i) {
         if (equityCurve[i] > peak) {
             peak = equityCurve[i];
         }
         
-        drawdowns[i] = (equityCurve[i] - peak) / peak * 100.0;
+        drawdowns[i] = peak > 0.0 ? (equityCurve[i] - peak) / peak * 100.0 : 0.0;
     }
     
     return drawdowns;
 }
 
-double calculateSharpeRatio(const std::vector<double>& returns, double riskFreeRate) {
+double calculateSharpeRatio(const std::vector<double>& returns, double riskFreeRate, utils::ReductionMode mode) {
     if (returns.empty()) {
         return 0.0;
     }
     
-    double meanReturn = std::accumulate(returns.begin(), returns.end(), 0.0) / returns.size();
+    const double* r = returns.data();
+    double meanReturn = utils::parallelSum(returns.size(), [r](size_t i) { return r[i]; }, mode) / returns.size();
     
-    double variance = 0.0;
-    for (const auto& ret : returns) {
-        variance += (ret - meanReturn) * (ret - meanReturn);
-    }
+    double variance = utils::parallelSum(returns.size(), [r, meanReturn](size_t i) {
+        double deviation = r[i] - meanReturn;
+        return deviation * deviation;
+    }, mode);
     variance /= returns.size();
     
     double stdDev = std::sqrt(variance);
@@ -96,5 +327,34 @@ double calculateSharpeRatio(const std::vector<double>& returns, double riskFreeR
     return (meanReturn - riskFreeRate) / stdDev * std::sqrt(252.0);
 }
 
+ReturnStatistics calculateReturnStatistics(const std::vector<double>& equityCurve,
+                                           utils::ReductionMode mode, utils::ThreadPool* pool) {
+    ReturnStatistics stats;
+    if (equityCurve.size() < 2) {
+        return stats;
+    }
+    
+    // Return i is bar i+1 over bar i, as in MetricsAccumulator
+    const double* e = equityCurve.data();
+    auto ret = [e](size_t i) { return e[i] > 0.0 ? e[i + 1] / e[i] - 1.0 : 0.0; };
+    stats.count = equityCurve.size() - 1;
+    const double n = static_cast<double>(stats.count);
+    
+    stats.mean = utils::parallelSum(stats.count, ret, mode, pool) / n;
+    double mean = stats.mean;
+    double variance = utils::parallelSum(stats.count, [&ret, mean](size_t i) {
+        double deviation = ret(i) - mean;
+        return deviation * deviation;
+    }, mode, pool) / n;
+    double downside = utils::parallelSum(stats.count, [&ret](size_t i) {
+        double r = std::min(ret(i), 0.0);
+        return r * r;
+    }, mode, pool) / n;
+    
+    stats.stdDev = std::sqrt(variance);
+    stats.downsideDev = std::sqrt(downside);
+    return stats;
+}
+
 } // namespace backtester
 } // namespace crypto
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "backtester/result_store.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace crypto {
+namespace backtester {
+
+const char* const kTradeColumnNames[kNumTradeColumns] = {
+    "Entry Index", "Exit Index", "Entry Price", "Exit Price", "Profit", "Profit Percent", "Direction"
+};
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'T', 'S', 'B', 'R', 'E', 'S', '\0'};
+constexpr uint32_t kVersion = 2;
+
+uint64_t alignUp(uint64_t value) {
+    return (value + 7) & ~uint64_t(7);
+}
+
+} // namespace
+
+ResultStore::~ResultStore() {
+    close();
+}
+
+bool ResultStore::create(const std::string& path, size_t capacity,
+                         const std::vector<data::OHLCV>& priceData, size_t maxTrades) {
+    close();
+
+    uint64_t bars = priceData.size();
+
+    // Lay out the columnar sections after the header
+    ResultStoreHeader layout;
+    std::memset(&layout, 0, sizeof(layout));
+    std::memcpy(layout.magic, kMagic, sizeof(kMagic));
+    layout.version = kVersion;
+    layout.metricsFields = kNumMetricFields;
+    layout.capacity = capacity;
+    layout.bars = bars;
+    layout.maxTrades = maxTrades;
+
+    uint64_t offset = sizeof(ResultStoreHeader);
+    layout.nameOffset = offset;
+    offset = alignUp(offset + capacity * kNameLength);
+    layout.stateOffset = offset;
+    offset += capacity * sizeof(uint64_t);
+    layout.metricsOffset = offset;
+    offset += capacity * kNumMetricFields * sizeof(double);
+    layout.tradeCountOffset = offset;
+    offset += capacity * sizeof(uint64_t);
+    layout.timestampOffset = offset;
+    offset += bars * sizeof(int64_t);
+    layout.closeOffset = offset;
+    offset += bars * sizeof(double);
+    layout.equityOffset = offset;
+    offset += capacity * bars * sizeof(double);
+    layout.tradesOffset = offset;
+    offset += capacity * kNumTradeColumns * maxTrades * sizeof(double);
+    layout.fileSize = offset;
+
+    // Built under a unique temporary name and renamed into place, so a
+    // reader still mapping an earlier store keeps its file intact
+    std::string temp = path + ".tmp" + std::to_string(getpid());
+    m_fd = ::open(temp.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (m_fd < 0) {
+        std::cerr << "Error: Could not create result store " << path << std::endl;
+        return false;
+    }
+
+    // Sections are sparse until written, so unused slots cost no disk or RAM
+    if (::ftruncate(m_fd, static_cast<off_t>(layout.fileSize)) != 0) {
+        std::cerr << "Error: Could not size result store " << path << std::endl;
+        close();
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    void* base = ::mmap(nullptr, layout.fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (base == MAP_FAILED) {
+        std::cerr << "Error: Could not map result store " << path << std::endl;
+        close();
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    m_base = static_cast<uint8_t*>(base);
+    m_size = layout.fileSize;
+    m_writable = true;
+
+    // Price columns are shared by every slot
+    int64_t* timestamps = section<int64_t>(layout.timestampOffset);
+    double* closes = section<double>(layout.closeOffset);
+    for (size_t i = 0; i < bars; ++i) {
+        timestamps[i] = priceData[i].unix_time;
+        closes[i] = priceData[i].close;
+    }
+
+    // Header last, so a reader never sees a valid magic over a partial layout
+    std::memcpy(static_cast<void*>(m_base), &layout, sizeof(layout));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Slots are published through this mapping after the rename
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::cerr << "Error: Could not move result store into place at " << path << std::endl;
+        close();
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ResultStore::open(const std::string& path) {
+    close();
+
+    m_fd = ::open(path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        std::cerr << "Error: Could not open result store " << path << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(ResultStoreHeader)) {
+        std::cerr << "Error: Result store " << path << " is too small" << std::endl;
+        close();
+        return false;
+    }
+
+    void* base = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, m_fd, 0);
+    if (base == MAP_FAILED) {
+        std::cerr << "Error: Could not map result store " << path << std::endl;
+        close();
+        return false;
+    }
+
+    m_base = static_cast<uint8_t*>(base);
+    m_size = info.st_size;
+    m_writable = false;
+
+    if (std::memcmp(header()->magic, kMagic, sizeof(kMagic)) != 0 ||
+        header()->version != kVersion || header()->fileSize > m_size) {
+        std::cerr << "Error: " << path << " is not a valid result store" << std::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void ResultStore::close() {
+    if (m_base) {
+        ::munmap(m_base, m_size);
+        m_base = nullptr;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_size = 0;
+    m_writable = false;
+}
+
+bool ResultStore::isOpen() const {
+    return m_base != nullptr;
+}
+
+bool ResultStore::publish(size_t slot, const strategies::Strategy& strategy) {
+    if (!m_writable || slot >= capacity()) {
+        return false;
+    }
+
+    const ResultStoreHeader* h = header();
+
+    // Name
+    char* name = section<char>(h->nameOffset + slot * kNameLength);
+    std::memset(name, 0, kNameLength);
+    std::strncpy(name, strategy.getName().c_str(), kNameLength - 1);
+
+    // Metrics
+    double* metrics = section<double>(h->metricsOffset) + slot * kNumMetricFields;
+    metricsToArray(strategy.getMetrics(), metrics);
+
+    // Equity curve
+    const auto& curve = strategy.getEquityCurve();
+    double* equity = section<double>(h->equityOffset) + slot * h->bars;
+    std::copy(curve.begin(), curve.begin() + std::min<size_t>(curve.size(), h->bars), equity);
+
+    // Trades, one column at a time
+    const auto& trades = strategy.getTrades();
+    size_t count = std::min<size_t>(trades.size(), h->maxTrades);
+    uint8_t* tradeBase = m_base + h->tradesOffset + slot * kNumTradeColumns * h->maxTrades * sizeof(double);
+    int64_t* entryIndex = reinterpret_cast<int64_t*>(tradeBase);
+    int64_t* exitIndex = entryIndex + h->maxTrades;
+    double* entryPrice = reinterpret_cast<double*>(exitIndex + h->maxTrades);
+    double* exitPrice = entryPrice + h->maxTrades;
+    double* profit = exitPrice + h->maxTrades;
+    double* profitPercent = profit + h->maxTrades;
+    int64_t* direction = reinterpret_cast<int64_t*>(profitPercent + h->maxTrades);
+
+    for (size_t t = 0; t < count; ++t) {
+        entryIndex[t] = static_cast<int64_t>(trades[t].entryIndex);
+        exitIndex[t] = static_cast<int64_t>(trades[t].exitIndex);
+        entryPrice[t] = trades[t].entryPrice;
+        exitPrice[t] = trades[t].exitPrice;
+        profit[t] = trades[t].profit;
+        profitPercent[t] = trades[t].profitPercent;
+        direction[t] = trades[t].direction;
+    }
+    section<uint64_t>(h->tradeCountOffset)[slot] = count;
+
+    if (count < trades.size()) {
+        std::cerr << "Warning: " << strategy.getName() << " has " << trades.size()
+                  << " trades, result store keeps the first " << count << std::endl;
+    }
+
+    // Data before state: readers that see the slot ready see all of it
+    slotState(slot)->store(1, std::memory_order_release);
+    publishedCount()->fetch_add(1, std::memory_order_release);
+
+    return true;
+}
+
+size_t ResultStore::capacity() const {
+    return m_base ? header()->capacity : 0;
+}
+
+size_t ResultStore::bars() const {
+    return m_base ? header()->bars : 0;
+}
+
+size_t ResultStore::published() const {
+    return m_base ? publishedCount()->load(std::memory_order_acquire) : 0;
+}
+
+bool ResultStore::isReady(size_t slot) const {
+    if (!m_base || slot >= capacity()) {
+        return false;
+    }
+    return slotState(slot)->load(std::memory_order_acquire) == 1;
+}
+
+std::string ResultStore::name(size_t slot) const {
+    if (!isReady(slot)) {
+        return "";
+    }
+    const char* name = section<const char>(header()->nameOffset + slot * kNameLength);
+    return std::string(name, strnlen(name, kNameLength));
+}
+
+const double* ResultStore::metrics(size_t slot) const {
+    return isReady(slot) ? section<const double>(header()->metricsOffset) + slot * kNumMetricFields : nullptr;
+}
+
+const double* ResultStore::equity(size_t slot) const {
+    return isReady(slot) ? section<const double>(header()->equityOffset) + slot * header()->bars : nullptr;
+}
+
+size_t ResultStore::tradeCount(size_t slot) const {
+    return isReady(slot) ? section<const uint64_t>(header()->tradeCountOffset)[slot] : 0;
+}
+
+ResultStoreHeader* ResultStore::header() const {
+    return reinterpret_cast<ResultStoreHeader*>(m_base);
+}
+
+std::atomic<uint64_t>* ResultStore::slotState(size_t slot) const {
+    static_assert(sizeof(std::atomic<uint64_t>) == sizeof(uint64_t), "atomic counters must map onto plain uint64");
+    return reinterpret_cast<std::atomic<uint64_t>*>(m_base + header()->stateOffset) + slot;
+}
+
+std::atomic<uint64_t>* ResultStore::publishedCount() const {
+    return reinterpret_cast<std::atomic<uint64_t>*>(&header()->published);
+}
+
+} // namespace backtester
+} // namespace crypto
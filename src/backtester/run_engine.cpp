@@ -0,0 +1,300 @@
+#include "backtester/run_engine.h"
+#include "strategies/ensemble_strategy.h"
+#include "utils/bounded_queue.h"
+#include "utils/thread_affinity.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <thread>
+
+namespace crypto {
+namespace backtester {
+
+RunEngine::RunEngine(const RunSpec& spec) : m_spec(spec), m_datasets(spec.datasets) {
+
+    // Drop repeated parameter sets
+    std::set<std::string> seen;
+    std::vector<strategies::StrategySpec> unique;
+    for (const auto& strategy : m_spec.strategies) {
+        if (seen.insert(strategies::formatSpec(strategy)).second) {
+            unique.push_back(strategy);
+        }
+    }
+    m_spec.strategies = unique;
+}
+
+namespace {
+
+// Total length of the union of [start, end) intervals
+double unionLength(std::vector<std::pair<double, double>> intervals) {
+    std::sort(intervals.begin(), intervals.end());
+    double total = 0.0;
+    double start = 0.0;
+    double end = -1.0;
+    for (const auto& interval : intervals) {
+        if (interval.first > end) {
+            if (end > start) total += end - start;
+            start = interval.first;
+            end = interval.second;
+        } else {
+            end = std::max(end, interval.second);
+        }
+    }
+    if (end > start) total += end - start;
+    return total;
+}
+
+} // namespace
+
+std::string RunEngine::outputDirFor(size_t dataset) const {
+    return m_datasets.size() > 1 ? m_spec.outputDir + "/" + m_datasets[dataset].name : m_spec.outputDir;
+}
+
+bool RunEngine::run() {
+    for (const auto& dataset : m_datasets) {
+        if (!std::filesystem::exists(dataset.path)) {
+            std::cerr << "Error: Data file not found at " << dataset.path << std::endl;
+            return false;
+        }
+    }
+
+    printPlan();
+
+    m_start = std::chrono::steady_clock::now();
+    utils::ThreadPool pool(m_spec.threads);
+    bool verbose = pool.size() == 1 && m_datasets.size() == 1;
+
+    // Four stages joined by bounded queues: while dataset N is backtesting,
+    // N+1 computes indicators and N+2 loads. A full queue stalls the stage
+    // feeding it, so at most queueDepth datasets wait between stages.
+    m_stages.assign(4, StageStats());
+    m_stages[0].name = "load";
+    m_stages[1].name = "indicators";
+    m_stages[2].name = "backtest";
+    m_stages[3].name = "export";
+
+    size_t depth = std::max<size_t>(1, m_spec.queueDepth);
+    utils::BoundedQueue<DatasetJob> loaded(depth);
+    utils::BoundedQueue<DatasetJob> prepared(depth);
+    utils::BoundedQueue<DatasetJob> finished(depth);
+
+    // Datasets take turns across NUMA nodes. The loader moves to the node
+    // before reading, so the bars are first touched (and placed) there, and
+    // the dataset's tasks are queued on that node's workers.
+    // A dataset that fails to load is reported and skipped; the rest still run
+    std::vector<size_t> failedLoads;
+    std::thread loader([&] {
+        for (size_t d = 0; d < m_datasets.size(); ++d) {
+            int node = static_cast<int>(d % pool.nodeCount());
+            if (pool.nodeCount() > 1) {
+                utils::pinCurrentThread(utils::numaNodes()[node].cpus);
+            }
+            double start = elapsed();
+            DatasetJob job{d, node, std::make_unique<Backtester>(m_datasets[d].path, m_spec.validation), nullptr};
+            Backtester& backtester = *job.backtester;
+            if (!backtester.isLoaded()) {
+                failedLoads.push_back(d);
+                m_stages[0].busy.emplace_back(start, elapsed());
+                continue;
+            }
+            backtester.setIndicatorCache(m_spec.indicatorCache);
+            // Ensembles over this dataset generate each component once
+            auto signalCache = std::make_shared<strategies::SignalCache>();
+            for (const auto& spec : m_spec.strategies) {
+                auto strategy = strategies::createStrategy(spec, signalCache);
+                strategy->setVerbose(verbose);
+                strategy->setPositionConfig(m_spec.position);
+                strategy->setLazyResults(m_spec.lazyResults);
+                backtester.addStrategy(strategy);
+            }
+
+            std::filesystem::create_directories(outputDirFor(d));
+            if (m_spec.resultStore) {
+                // A leaderboard publishes only its selection, after ranking
+                backtester.publishResultsTo(outputDirFor(d) + "/strategy_results.bin", m_spec.topK > 0);
+            }
+            m_stages[0].busy.emplace_back(start, elapsed());
+            loaded.push(std::move(job));
+        }
+        loaded.close();
+    });
+
+    std::thread indicators([&] {
+        DatasetJob job;
+        while (loaded.pop(job)) {
+            double start = elapsed();
+            job.backtester->prepare(m_spec.initialCapital, m_spec.positionSize, &pool, job.node);
+            m_stages[1].busy.emplace_back(start, elapsed());
+            prepared.push(std::move(job));
+        }
+        prepared.close();
+    });
+
+    // Strategies of one dataset run concurrently on the shared pool; each
+    // stage waits only for its own tasks
+    std::thread backtests([&] {
+        DatasetJob job;
+        while (prepared.pop(job)) {
+            double start = elapsed();
+            Backtester* backtester = job.backtester.get();
+            if (m_spec.topK > 0) {
+                job.leaderboard = std::make_unique<Leaderboard>(m_spec.topK, m_spec.rankBy, m_spec.pareto);
+            }
+            Leaderboard* board = job.leaderboard.get();
+            utils::TaskGroup group(pool);
+            for (size_t s = 0; s < backtester->getStrategyCount(); ++s) {
+                group.submit([backtester, board, s] {
+                    backtester->runStrategy(s);
+                    if (board) {
+                        auto strategy = backtester->getStrategy(s);
+                        board->offer(s, strategy->getName(), strategy->getMetrics());
+                    }
+                }, job.node);
+            }
+            if (board) {
+                // The live view: the board as of each worker's last merge
+                std::string path = outputDirFor(job.index) + "/leaderboard.csv";
+                while (!group.waitFor(std::chrono::seconds(1))) {
+                    board->writeCsv(path);
+                    std::cout << "Leaderboard: " << board->offered() << "/" << backtester->getStrategyCount()
+                              << " backtests ranked, see " << path << std::endl;
+                }
+                board->collect();
+                board->writeCsv(path);
+            } else {
+                group.wait();
+            }
+            m_stages[2].busy.emplace_back(start, elapsed());
+            finished.push(std::move(job));
+        }
+        finished.close();
+    });
+
+    // Reports and exports on the calling thread; each dataset is released
+    // once written, so memory is bounded by the queue depths
+    DatasetJob job;
+    while (finished.pop(job)) {
+        double start = elapsed();
+        if (m_datasets.size() > 1) {
+            std::cout << "\n##### Dataset: " << m_datasets[job.index].name << " #####" << std::endl;
+        }
+        if (job.leaderboard) {
+            // Only the leaders are worth a table row and a curve on disk
+            if (m_spec.compare) {
+                job.leaderboard->print(std::cout);
+            }
+            auto selection = job.leaderboard->selection();
+            if (m_spec.resultStore) {
+                job.backtester->publishSelection(selection);
+            }
+            if (m_spec.exportCsv) {
+                job.backtester->exportResults(outputDirFor(job.index), &pool, job.node, &selection);
+            }
+        } else {
+            if (m_spec.compare) {
+                job.backtester->compareStrategies();
+            }
+            if (m_spec.exportCsv) {
+                job.backtester->exportResults(outputDirFor(job.index), &pool, job.node);
+            }
+        }
+        job.backtester.reset();
+        m_stages[3].busy.emplace_back(start, elapsed());
+    }
+
+    loader.join();
+    indicators.join();
+    backtests.join();
+
+    m_stages[1].inputWait = loaded.popWaitSeconds();
+    m_stages[0].outputWait = loaded.pushWaitSeconds();
+    m_stages[2].inputWait = prepared.popWaitSeconds();
+    m_stages[1].outputWait = prepared.pushWaitSeconds();
+    m_stages[3].inputWait = finished.popWaitSeconds();
+    m_stages[2].outputWait = finished.pushWaitSeconds();
+
+    double seconds = elapsed();
+    std::cout << "\nRan " << (m_datasets.size() - failedLoads.size()) * m_spec.strategies.size() << " backtests on "
+              << pool.size() << " threads in " << seconds << "s" << std::endl;
+    pool.printStats(std::cout);
+    if (m_datasets.size() > 1) {
+        printPipelineReport(seconds, depth);
+    }
+
+    for (size_t d : failedLoads) {
+        std::cerr << "Error: Skipped dataset " << m_datasets[d].name << ", its data failed to load" << std::endl;
+    }
+    return failedLoads.empty();
+}
+
+double RunEngine::elapsed() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+}
+
+void RunEngine::printPipelineReport(double wallSeconds, size_t depth) const {
+    std::cout << "\nPipeline (queue depth " << depth << "):\n";
+    std::cout << std::left << std::setw(12) << "Stage"
+              << std::right << std::setw(10) << "Items"
+              << std::setw(12) << "Busy (s)"
+              << std::setw(14) << "Starved (s)"
+              << std::setw(14) << "Blocked (s)"
+              << std::setw(14) << "Overlapped" << std::endl;
+
+    double totalBusy = 0.0;
+    for (size_t s = 0; s < m_stages.size(); ++s) {
+        const StageStats& stage = m_stages[s];
+        double busy = unionLength(stage.busy);
+        totalBusy += busy;
+
+        // Time this stage ran while any other stage was also running:
+        // |A| + |others| - |A u others|
+        std::vector<std::pair<double, double>> others;
+        for (size_t o = 0; o < m_stages.size(); ++o) {
+            if (o != s) {
+                others.insert(others.end(), m_stages[o].busy.begin(), m_stages[o].busy.end());
+            }
+        }
+        std::vector<std::pair<double, double>> combined = others;
+        combined.insert(combined.end(), stage.busy.begin(), stage.busy.end());
+        double overlap = busy + unionLength(others) - unionLength(combined);
+
+        std::cout << std::left << std::setw(12) << stage.name
+                  << std::right << std::setw(10) << stage.busy.size()
+                  << std::fixed << std::setprecision(3)
+                  << std::setw(12) << busy
+                  << std::setw(14) << stage.inputWait
+                  << std::setw(14) << stage.outputWait
+                  << std::setprecision(1)
+                  << std::setw(13) << (busy > 0.0 ? 100.0 * overlap / busy : 0.0) << "%" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        std::cout << std::setprecision(6);
+    }
+
+    // Above 1x the stages genuinely ran at the same time
+    std::cout << "Stage time " << std::fixed << std::setprecision(3) << totalBusy << "s in " << wallSeconds
+              << "s wall (" << std::setprecision(2) << (wallSeconds > 0.0 ? totalBusy / wallSeconds : 0.0)
+              << "x concurrency)" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void RunEngine::printPlan() const {
+    std::set<data::IndicatorRequest> indicators;
+    for (const auto& spec : m_spec.strategies) {
+        auto strategy = strategies::createStrategy(spec);
+        for (const auto& request : strategy->requiredIndicators()) {
+            indicators.insert(request);
+        }
+    }
+
+    std::cout << "Run plan: " << m_datasets.size() << " dataset(s), "
+              << m_spec.strategies.size() << " strategies, "
+              << m_datasets.size() * m_spec.strategies.size() << " backtests, "
+              << indicators.size() << " distinct indicators per dataset" << std::endl;
+}
+
+} // namespace backtester
+} // namespace crypto
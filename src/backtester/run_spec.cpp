@@ -0,0 +1,215 @@
+#include "backtester/run_spec.h"
+#include "backtester/leaderboard.h"
+#include "utils/json.h"
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace crypto {
+namespace backtester {
+
+namespace {
+
+// Turn one JSON strategy entry into specs via the grid syntax
+bool parseStrategyEntry(const utils::JsonValue& entry, std::vector<strategies::StrategySpec>& specs) {
+    std::string type = entry["type"].asString();
+    if (type == "ensemble") {
+        std::string expression = entry["expr"].asString();
+        if (expression.empty()) {
+            std::cerr << "Error: An ensemble strategy needs an \"expr\" string" << std::endl;
+            return false;
+        }
+        return strategies::parseGrid("ensemble:" + expression, specs);
+    }
+
+    if (type.empty() || !entry["params"].isArray()) {
+        std::cerr << "Error: Each strategy needs a \"type\" and a \"params\" array" << std::endl;
+        return false;
+    }
+
+    std::ostringstream grid;
+    grid.precision(17);
+    grid << type << ":";
+
+    const auto& params = entry["params"].asArray();
+    for (size_t i = 0; i < params.size(); ++i) {
+        grid << (i ? "," : "");
+        if (params[i].isNumber()) {
+            grid << params[i].asNumber();
+        } else if (params[i].isString()) {
+            grid << params[i].asString();
+        } else {
+            std::cerr << "Error: Parameters of a " << type << " strategy must be numbers or range strings" << std::endl;
+            return false;
+        }
+    }
+
+    size_t before = specs.size();
+    if (!strategies::parseGrid(grid.str(), specs)) {
+        return false;
+    }
+    if (specs.size() == before) {
+        std::cerr << "Warning: Strategy entry " << grid.str() << " has no valid parameter combinations" << std::endl;
+    }
+    return true;
+}
+
+// Optional "position" section; absent keys keep the long-flat defaults
+bool parsePositionConfig(const utils::JsonValue& section, strategies::PositionConfig& config) {
+    if (section.isNull()) {
+        return true;
+    }
+
+    std::string mode = section["mode"].asString("long");
+    if (mode == "long") {
+        config.mode = strategies::PositionMode::LongOnly;
+    } else if (mode == "longshort") {
+        config.mode = strategies::PositionMode::LongShort;
+    } else {
+        return false;
+    }
+
+    std::string sizing = section["sizing"].asString("fixed");
+    if (sizing == "fixed") {
+        config.sizing = strategies::SizingRule::Fixed;
+    } else if (sizing == "voltarget") {
+        config.sizing = strategies::SizingRule::VolatilityTarget;
+    } else if (sizing == "kelly") {
+        config.sizing = strategies::SizingRule::Kelly;
+    } else {
+        return false;
+    }
+
+    config.leverage = section["leverage"].asNumber(config.leverage);
+    config.maxEntries = static_cast<int>(section["pyramiding"].asNumber(config.maxEntries));
+    config.targetVolatility = section["targetVolatility"].asNumber(config.targetVolatility);
+    config.volatilityWindow = static_cast<int>(section["volatilityWindow"].asNumber(config.volatilityWindow));
+    config.kellyFraction = section["kellyFraction"].asNumber(config.kellyFraction);
+    config.kellyMinTrades = static_cast<int>(section["kellyMinTrades"].asNumber(config.kellyMinTrades));
+
+    return config.leverage > 0.0 && config.maxEntries >= 1 && config.volatilityWindow >= 2;
+}
+
+bool parseValidationConfig(const utils::JsonValue& section, data::ValidationConfig& config) {
+    if (section.isNull()) {
+        return true;
+    }
+
+    if (!data::parseOutlierAction(section["outliers"].asString("flag"), config.outliers)) {
+        return false;
+    }
+    config.interval = static_cast<int64_t>(section["interval"].asNumber(static_cast<double>(config.interval)));
+    config.window = static_cast<size_t>(section["window"].asNumber(static_cast<double>(config.window)));
+    config.threshold = section["threshold"].asNumber(config.threshold);
+
+    return config.interval >= 0 && config.threshold > 0.0;
+}
+
+} // namespace
+
+bool loadRunSpec(const std::string& path, RunSpec& spec) {
+    utils::JsonValue root;
+    if (!utils::readJsonFile(path, root)) {
+        return false;
+    }
+
+    spec = RunSpec();
+
+    // Each dataset gets its own output directory, so names and files must be unique
+    std::map<std::string, std::string> namesByPath;
+    std::set<std::string> names;
+    for (const auto& entry : root["datasets"].asArray()) {
+        DatasetSpec dataset;
+        if (entry.isString()) {
+            dataset.path = entry.asString();
+        } else {
+            dataset.path = entry["path"].asString();
+            dataset.name = entry["name"].asString();
+        }
+        if (dataset.path.empty()) {
+            std::cerr << "Error: Dataset entries in " << path << " need a \"path\"" << std::endl;
+            return false;
+        }
+        if (dataset.name.empty()) {
+            dataset.name = std::filesystem::path(dataset.path).stem().string();
+        }
+        auto previous = namesByPath.emplace(dataset.path, dataset.name);
+        if (!previous.second) {
+            std::cerr << "Error: Datasets \"" << previous.first->second << "\" and \"" << dataset.name
+                      << "\" in " << path << " both point at " << dataset.path << std::endl;
+            return false;
+        }
+        if (!names.insert(dataset.name).second) {
+            std::cerr << "Error: Dataset name \"" << dataset.name << "\" is used twice in " << path << std::endl;
+            return false;
+        }
+        spec.datasets.push_back(dataset);
+    }
+
+    for (const auto& entry : root["strategies"].asArray()) {
+        if (!parseStrategyEntry(entry, spec.strategies)) {
+            return false;
+        }
+    }
+
+    const auto& execution = root["execution"];
+    spec.initialCapital = execution["initialCapital"].asNumber(spec.initialCapital);
+    spec.positionSize = execution["positionSize"].asNumber(spec.positionSize);
+    spec.threads = static_cast<size_t>(execution["threads"].asNumber(0.0));
+    spec.queueDepth = static_cast<size_t>(execution["queueDepth"].asNumber(static_cast<double>(spec.queueDepth)));
+    spec.indicatorCache = execution["indicatorCache"].asString(spec.indicatorCache);
+    spec.lazyResults = execution["lazyResults"].asBool(spec.lazyResults);
+
+    if (!parsePositionConfig(root["position"], spec.position)) {
+        std::cerr << "Error: Invalid \"position\" section in " << path << std::endl;
+        return false;
+    }
+
+    if (!parseValidationConfig(root["validation"], spec.validation)) {
+        std::cerr << "Error: Invalid \"validation\" section in " << path << std::endl;
+        return false;
+    }
+
+    const auto& outputs = root["outputs"];
+    spec.outputDir = outputs["dir"].asString(spec.outputDir);
+    spec.exportCsv = outputs["csv"].asBool(spec.exportCsv);
+    spec.resultStore = outputs["resultStore"].asBool(spec.resultStore);
+    spec.compare = outputs["compare"].asBool(spec.compare);
+    spec.topK = static_cast<size_t>(outputs["topK"].asNumber(0.0));
+    spec.rankBy = outputs["rankBy"].asString(spec.rankBy);
+    spec.pareto = outputs["pareto"].asBool(spec.pareto);
+
+    int field;
+    if (!Leaderboard::findMetric(spec.rankBy, field)) {
+        std::cerr << "Error: Unknown \"rankBy\" metric \"" << spec.rankBy << "\" in " << path << std::endl;
+        return false;
+    }
+
+    if (spec.datasets.empty() || spec.strategies.empty()) {
+        std::cerr << "Error: Run spec " << path << " needs at least one dataset and one strategy" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+RunSpec defaultRunSpec(const std::string& dataPath) {
+    RunSpec spec;
+    spec.datasets.push_back({std::filesystem::path(dataPath).stem().string(), dataPath});
+    spec.strategies = {
+        {"sma", {20, 50}},
+        {"sma", {50, 200}},
+        {"rsi", {14, 30, 70}},
+        {"bb", {20, 2.0}}
+    };
+    spec.initialCapital = 10000.0;
+    spec.positionSize = 0.95;   // Invest 95% of capital per trade
+    spec.threads = 1;
+    spec.resultStore = true;
+    return spec;
+}
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,249 @@
+#include "backtester/stress_test.h"
+#include "strategies/ensemble_strategy.h"
+#include "utils/csv_utils.h"
+#include "utils/thread_pool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+
+namespace crypto {
+namespace backtester {
+
+namespace {
+
+// Independent, well-mixed seed per (model, path) (splitmix64)
+uint64_t pathSeed(uint64_t seed, size_t model, size_t path) {
+    uint64_t x = seed + 0x9E3779B97F4A7C15ULL * (model * 1000003ULL + path + 1);
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Linear interpolation between the closest ranks of sorted values
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    double rank = q * (sorted.size() - 1);
+    size_t below = static_cast<size_t>(rank);
+    size_t above = std::min(below + 1, sorted.size() - 1);
+    return sorted[below] + (rank - below) * (sorted[above] - sorted[below]);
+}
+
+double metricValue(const PerformanceMetrics& metrics, int field) {
+    double values[kNumMetricFields];
+    metricsToArray(metrics, values);
+    return values[field];
+}
+
+// Backtest every strategy on `bars` and keep only their metrics
+void backtestPath(std::vector<data::OHLCV> bars, const std::vector<strategies::StrategySpec>& specs,
+                  const std::vector<data::IndicatorRequest>& indicators, const StressOptions& options,
+                  PerformanceMetrics* results) {
+    data::DataLoader loader("");
+    loader.setVerbose(false);
+    loader.setData(std::move(bars));
+    loader.addIndicators(indicators);
+
+    // Ensemble components are shared within the path only
+    auto signalCache = std::make_shared<strategies::SignalCache>();
+    for (size_t s = 0; s < specs.size(); ++s) {
+        auto strategy = strategies::createStrategy(specs[s], signalCache);
+        strategy->setVerbose(false);
+        strategy->setPositionConfig(options.position);
+        strategy->setLazyResults(true);
+        strategy->backtest(loader, options.initialCapital, options.positionSize);
+        results[s] = strategy->getMetrics();
+    }
+}
+
+} // namespace
+
+StressTester::StressTester(const std::vector<data::OHLCV>& history, const StressOptions& options)
+    : m_history(history), m_options(options), m_generator(history, options.blockSize) {}
+
+void StressTester::run(const std::vector<strategies::StrategySpec>& specs) {
+    std::set<data::IndicatorRequest> unique;
+    m_names.clear();
+    for (const auto& spec : specs) {
+        auto strategy = strategies::createStrategy(spec);
+        m_names.push_back(strategy->getName());
+        for (const auto& request : strategy->requiredIndicators()) {
+            unique.insert(request);
+        }
+    }
+    const std::vector<data::IndicatorRequest> indicators(unique.begin(), unique.end());
+    const size_t count = specs.size();
+    const size_t bars = m_options.bars > 0 ? m_options.bars : m_history.size();
+
+    // The history itself, as the reference point for each distribution
+    m_historical.assign(count, PerformanceMetrics());
+    backtestPath(m_history, specs, indicators, m_options, m_historical.data());
+
+    auto start = std::chrono::steady_clock::now();
+    utils::ThreadPool pool(m_options.threads);
+    m_results.assign(m_options.models.size(), std::vector<PerformanceMetrics>(m_options.paths * count));
+    for (size_t m = 0; m < m_options.models.size(); ++m) {
+        for (size_t p = 0; p < m_options.paths; ++p) {
+            // Each task writes its own slots, so no locking
+            PerformanceMetrics* results = &m_results[m][p * count];
+            pool.submit([this, &specs, &indicators, results, m, p] {
+                std::vector<data::OHLCV> path;
+                m_generator.generate(m_options.models[m], pathSeed(m_options.seed, m, p), m_options.bars, path);
+                backtestPath(std::move(path), specs, indicators, m_options, results);
+            });
+        }
+    }
+    pool.wait();
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t paths = m_options.models.size() * m_options.paths;
+    std::cout << "Stress tested " << count << " strategies on " << paths << " synthetic paths of " << bars
+              << " bars on " << pool.size() << " threads in " << seconds << "s ("
+              << (seconds > 0.0 ? paths * bars / seconds : 0.0) << " bars/s generated and tested)" << std::endl;
+}
+
+const PerformanceMetrics& StressTester::metrics(size_t model, size_t path, size_t s) const {
+    return m_results[model][path * m_names.size() + s];
+}
+
+MetricDistribution StressTester::distribution(size_t model, size_t s, int field) const {
+    std::vector<double> values;
+    for (size_t p = 0; p < m_options.paths; ++p) {
+        double value = metricValue(metrics(model, p, s), field);
+        if (!std::isnan(value)) {
+            values.push_back(value);
+        }
+    }
+
+    MetricDistribution result;
+    if (values.empty()) {
+        return result;
+    }
+    for (double value : values) {
+        result.mean += value;
+    }
+    result.mean /= values.size();
+    for (double value : values) {
+        result.stdDev += (value - result.mean) * (value - result.mean);
+    }
+    result.stdDev = values.size() > 1 ? std::sqrt(result.stdDev / (values.size() - 1)) : 0.0;
+
+    std::sort(values.begin(), values.end());
+    result.p5 = percentile(values, 0.05);
+    result.p25 = percentile(values, 0.25);
+    result.p50 = percentile(values, 0.50);
+    result.p75 = percentile(values, 0.75);
+    result.p95 = percentile(values, 0.95);
+    return result;
+}
+
+double StressTester::lossProbability(size_t model, size_t s) const {
+    if (m_options.paths == 0) {
+        return 0.0;
+    }
+    size_t losses = 0;
+    for (size_t p = 0; p < m_options.paths; ++p) {
+        losses += metrics(model, p, s).totalReturn < 0.0;
+    }
+    return static_cast<double>(losses) / m_options.paths;
+}
+
+void StressTester::printSummary(std::ostream& out) const {
+    const data::PathCalibration& c = m_generator.calibration();
+    out << "\nCalibrated on " << m_history.size() << " bars: drift " << c.drift << ", volatility " << c.volatility
+        << " per bar; calm/stressed volatility " << c.calmVolatility << "/" << c.stressVolatility
+        << ", staying probability " << c.calmStay << "/" << c.stressStay << std::endl;
+
+    const int sharpe = 2;
+    const int maxDrawdown = 6;
+    for (size_t m = 0; m < m_options.models.size(); ++m) {
+        out << "\n============= Stress Test: " << data::pathModelName(m_options.models[m]) << ", "
+            << m_options.paths << " paths =============\n";
+        out << std::left << std::setw(30) << "Strategy"
+            << std::right << std::setw(12) << "Sharpe p5"
+            << std::setw(12) << "p50"
+            << std::setw(12) << "p95"
+            << std::setw(12) << "History"
+            << std::setw(14) << "Return p50"
+            << std::setw(12) << "MaxDD p50"
+            << std::setw(12) << "MaxDD p95"
+            << std::setw(10) << "P(loss)" << std::endl;
+        out << std::string(136, '-') << std::endl;
+
+        for (size_t s = 0; s < m_names.size(); ++s) {
+            MetricDistribution sharpes = distribution(m, s, sharpe);
+            MetricDistribution drawdowns = distribution(m, s, maxDrawdown);
+            MetricDistribution returns = distribution(m, s, 0);
+            out << std::left << std::setw(30) << m_names[s]
+                << std::right << std::fixed << std::setprecision(2)
+                << std::setw(12) << sharpes.p5
+                << std::setw(12) << sharpes.p50
+                << std::setw(12) << sharpes.p95
+                << std::setw(12) << m_historical[s].sharpeRatio
+                << std::setw(13) << returns.p50 << "%"
+                << std::setw(11) << drawdowns.p50 << "%"
+                << std::setw(11) << drawdowns.p95 << "%"
+                << std::setw(9) << lossProbability(m, s) * 100.0 << "%" << std::endl;
+        }
+        out.unsetf(std::ios::fixed);
+        out << std::setprecision(6);
+    }
+}
+
+bool StressTester::exportResults(const std::string& outputDir) const {
+    std::string summaryFile = outputDir + "/stress_summary.csv";
+    std::ofstream summary(summaryFile);
+    if (!summary.is_open()) {
+        std::cerr << "Failed to open file for writing: " << summaryFile << std::endl;
+        return false;
+    }
+    summary << "Model,Strategy,Metric,History,Mean,StdDev,P5,P25,P50,P75,P95\n";
+    for (size_t m = 0; m < m_options.models.size(); ++m) {
+        for (size_t s = 0; s < m_names.size(); ++s) {
+            for (int f = 0; f < kNumMetricFields; ++f) {
+                MetricDistribution d = distribution(m, s, f);
+                summary << data::pathModelName(m_options.models[m]) << "," << utils::csvField(m_names[s]) << ","
+                        << kMetricNames[f] << "," << metricValue(m_historical[s], f) << "," << d.mean << ","
+                        << d.stdDev << "," << d.p5 << "," << d.p25 << "," << d.p50 << "," << d.p75 << ","
+                        << d.p95 << "\n";
+            }
+        }
+    }
+    summary.close();
+    std::cout << "Stress test distributions exported to " << summaryFile << std::endl;
+
+    std::string pathsFile = outputDir + "/stress_paths.csv";
+    std::ofstream paths(pathsFile);
+    if (!paths.is_open()) {
+        std::cerr << "Failed to open file for writing: " << pathsFile << std::endl;
+        return false;
+    }
+    paths << "Model,Path,Strategy";
+    for (int f = 0; f < kNumMetricFields; ++f) {
+        paths << "," << kMetricNames[f];
+    }
+    paths << "\n";
+    double values[kNumMetricFields];
+    for (size_t m = 0; m < m_options.models.size(); ++m) {
+        for (size_t p = 0; p < m_options.paths; ++p) {
+            for (size_t s = 0; s < m_names.size(); ++s) {
+                paths << data::pathModelName(m_options.models[m]) << "," << p << "," << utils::csvField(m_names[s]);
+                metricsToArray(metrics(m, p, s), values);
+                for (int f = 0; f < kNumMetricFields; ++f) {
+                    paths << "," << values[f];
+                }
+                paths << "\n";
+            }
+        }
+    }
+    std::cout << "Per-path metrics exported to " << pathsFile << std::endl;
+    return true;
+}
+
+} // namespace backtester
+} // namespace crypto
@@ -0,0 +1,465 @@
+#include "data/compressed_bars.h"
+#include "data/data_loader.h"
+#include <algorithm>
+#include <cstring>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+constexpr int kMaxDecimals = 8;
+constexpr double kPow10[kMaxDecimals + 1] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8};
+// Scaled integers stay exact in a double below 2^53
+constexpr double kMaxScaled = 9007199254740992.0;
+// Deltas are bit-packed in groups this long, each at its own width, so one
+// large move (or a price level rising through a block) widens only its group
+constexpr size_t kDeltaGroup = 64;
+
+uint64_t toBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Sign-extend the low `bits` bits
+int64_t signExtend(uint64_t value, unsigned bits) {
+    return static_cast<int64_t>(value << (64 - bits)) >> (64 - bits);
+}
+
+unsigned bitWidth(uint64_t value) {
+    return value == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(value));
+}
+
+// Bits are packed least significant first into 64-bit words
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint64_t>& words) : m_words(words), m_bits(words.size() * 64) {}
+
+    uint64_t position() const { return m_bits; }
+
+    void write(uint64_t value, unsigned bits) {
+        if (bits == 0) {
+            return;
+        }
+        if (bits < 64) {
+            value &= (uint64_t(1) << bits) - 1;
+        }
+        unsigned offset = m_bits & 63;
+        if (offset == 0) {
+            m_words.push_back(0);
+        }
+        m_words.back() |= value << offset;
+        if (offset + bits > 64) {
+            m_words.push_back(value >> (64 - offset));
+        }
+        m_bits += bits;
+    }
+
+private:
+    std::vector<uint64_t>& m_words;
+    uint64_t m_bits;
+};
+
+class BitReader {
+public:
+    BitReader(const std::vector<uint64_t>& words, uint64_t position) : m_words(words.data()), m_pos(position) {}
+
+    uint64_t read(unsigned bits) {
+        if (bits == 0) {
+            return 0;
+        }
+        size_t word = m_pos >> 6;
+        unsigned offset = m_pos & 63;
+        uint64_t value = m_words[word] >> offset;
+        if (offset + bits > 64) {
+            value |= m_words[word + 1] << (64 - offset);
+        }
+        m_pos += bits;
+        return bits == 64 ? value : value & ((uint64_t(1) << bits) - 1);
+    }
+
+    bool bit() {
+        bool value = (m_words[m_pos >> 6] >> (m_pos & 63)) & 1;
+        ++m_pos;
+        return value;
+    }
+
+private:
+    const uint64_t* m_words;
+    uint64_t m_pos;
+};
+
+int64_t scaleToInt(double value, double scale) {
+    double scaled = value * scale;
+    return static_cast<int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+bool exactAt(const double* values, size_t count, double scale, bool& representable) {
+    for (size_t i = 0; i < count; ++i) {
+        double scaled = values[i] * scale;
+        if (!(scaled > -kMaxScaled && scaled < kMaxScaled)) {
+            representable = false;
+            return false;
+        }
+        if (toBits(static_cast<double>(scaleToInt(values[i], scale)) / scale) != toBits(values[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Smallest number of decimals that reproduces every value and every
+// predecessor exactly, or -1
+int decimalPlaces(const double* values, const double* previous, size_t count) {
+    bool representable = true;
+    for (int k = 0; k <= kMaxDecimals && representable; ++k) {
+        if (exactAt(values, count, kPow10[k], representable) &&
+            (previous == values || exactAt(previous, count, kPow10[k], representable))) {
+            return k;
+        }
+    }
+    return -1;
+}
+
+// Decimal block: k, first scaled integer, then per group of deltas its
+// width and the zigzag deltas bit-packed at that width. Value i is stored
+// relative to previous[i - 1].
+void encodeDecimal(BitWriter& writer, const double* values, const double* previous, size_t count, int decimals) {
+    const double scale = kPow10[decimals];
+    std::vector<uint64_t> deltas(count);
+    for (size_t i = 1; i < count; ++i) {
+        deltas[i] = zigzag(scaleToInt(values[i], scale) - scaleToInt(previous[i - 1], scale));
+    }
+
+    writer.write(static_cast<uint64_t>(decimals), 4);
+    writer.write(static_cast<uint64_t>(scaleToInt(values[0], scale)), 64);
+    for (size_t first = 1; first < count; first += kDeltaGroup) {
+        size_t end = std::min(count, first + kDeltaGroup);
+        uint64_t widest = 0;
+        for (size_t i = first; i < end; ++i) {
+            widest |= deltas[i];
+        }
+        unsigned width = bitWidth(widest);
+        writer.write(width, 7);
+        for (size_t i = first; i < end; ++i) {
+            writer.write(deltas[i], width);
+        }
+    }
+}
+
+void decodeDecimal(BitReader& reader, double* out, const double* previous, size_t count) {
+    const double scale = kPow10[reader.read(4)];
+    int64_t value = static_cast<int64_t>(reader.read(64));
+    out[0] = static_cast<double>(value) / scale;
+    for (size_t first = 1; first < count; first += kDeltaGroup) {
+        size_t end = std::min(count, first + kDeltaGroup);
+        unsigned width = static_cast<unsigned>(reader.read(7));
+        if (previous == out) {
+            // Plain deltas: keep the running integer
+            for (size_t i = first; i < end; ++i) {
+                value += unzigzag(reader.read(width));
+                out[i] = static_cast<double>(value) / scale;
+            }
+        } else {
+            // previous[i - 1] is an exact decimal at this scale
+            for (size_t i = first; i < end; ++i) {
+                value = scaleToInt(previous[i - 1], scale) + unzigzag(reader.read(width));
+                out[i] = static_cast<double>(value) / scale;
+            }
+        }
+    }
+}
+
+// Gorilla XOR block: the first value raw, then per value '0' when it
+// repeats, '10' + the meaningful bits when they fit the previous
+// leading/trailing-zero window, or '11' + 5-bit leading zeros + 6-bit
+// length + the meaningful bits
+void encodeXor(BitWriter& writer, const double* values, size_t count) {
+    uint64_t previous = toBits(values[0]);
+    writer.write(previous, 64);
+    bool window = false;
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for (size_t i = 1; i < count; ++i) {
+        uint64_t bits = toBits(values[i]);
+        uint64_t x = bits ^ previous;
+        previous = bits;
+        if (x == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+        writer.write(1, 1);
+        unsigned lz = std::min(static_cast<unsigned>(__builtin_clzll(x)), 31u);
+        unsigned tz = static_cast<unsigned>(__builtin_ctzll(x));
+        if (window && lz >= leading && tz >= trailing) {
+            writer.write(0, 1);
+            writer.write(x >> trailing, 64 - leading - trailing);
+        } else {
+            window = true;
+            leading = lz;
+            trailing = tz;
+            unsigned meaningful = 64 - leading - trailing;
+            writer.write(1, 1);
+            writer.write(leading, 5);
+            writer.write(meaningful - 1, 6);
+            writer.write(x >> trailing, meaningful);
+        }
+    }
+}
+
+void decodeXor(BitReader& reader, double* out, size_t count) {
+    uint64_t previous = reader.read(64);
+    out[0] = fromBits(previous);
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    for (size_t i = 1; i < count; ++i) {
+        if (reader.bit()) {
+            if (reader.bit()) {
+                leading = static_cast<unsigned>(reader.read(5));
+                unsigned meaningful = static_cast<unsigned>(reader.read(6)) + 1;
+                trailing = 64 - leading - meaningful;
+            }
+            previous ^= reader.read(64 - leading - trailing) << trailing;
+        }
+        out[i] = fromBits(previous);
+    }
+}
+
+} // namespace
+
+void CompressedTimeColumn::encode(const int64_t* values, size_t count) {
+    m_words.clear();
+    m_blockStart.clear();
+    m_count = count;
+    BitWriter writer(m_words);
+
+    for (size_t first = 0; first < count; first += kCompressedBlockSize) {
+        size_t n = std::min(kCompressedBlockSize, count - first);
+        const int64_t* block = values + first;
+        m_blockStart.push_back(writer.position());
+
+        // Gorilla's buckets: '0' for an unchanged spacing, then 7, 9 and 12
+        // bit delta-of-deltas, and '1111' + 64 bits for anything larger
+        writer.write(static_cast<uint64_t>(block[0]), 64);
+        uint64_t previousDelta = 0;
+        for (size_t i = 1; i < n; ++i) {
+            uint64_t delta = static_cast<uint64_t>(block[i]) - static_cast<uint64_t>(block[i - 1]);
+            int64_t dod = static_cast<int64_t>(delta - previousDelta);
+            previousDelta = delta;
+            if (dod == 0) {
+                writer.write(0, 1);
+            } else if (dod >= -64 && dod < 64) {
+                writer.write(0b01, 2);
+                writer.write(static_cast<uint64_t>(dod), 7);
+            } else if (dod >= -256 && dod < 256) {
+                writer.write(0b011, 3);
+                writer.write(static_cast<uint64_t>(dod), 9);
+            } else if (dod >= -2048 && dod < 2048) {
+                writer.write(0b0111, 4);
+                writer.write(static_cast<uint64_t>(dod), 12);
+            } else {
+                writer.write(0b1111, 4);
+                writer.write(static_cast<uint64_t>(dod), 64);
+            }
+        }
+    }
+    m_words.shrink_to_fit();
+}
+
+size_t CompressedTimeColumn::bytes() const {
+    return m_words.size() * sizeof(uint64_t) + m_blockStart.size() * sizeof(uint64_t);
+}
+
+size_t CompressedTimeColumn::decodeBlock(size_t block, int64_t* out) const {
+    size_t first = block * kCompressedBlockSize;
+    if (first >= m_count) {
+        return 0;
+    }
+    size_t n = std::min(kCompressedBlockSize, m_count - first);
+    BitReader reader(m_words, m_blockStart[block]);
+
+    uint64_t value = reader.read(64);
+    uint64_t delta = 0;
+    out[0] = static_cast<int64_t>(value);
+    for (size_t i = 1; i < n; ++i) {
+        if (reader.bit()) {
+            int64_t dod;
+            if (!reader.bit()) {
+                dod = signExtend(reader.read(7), 7);
+            } else if (!reader.bit()) {
+                dod = signExtend(reader.read(9), 9);
+            } else if (!reader.bit()) {
+                dod = signExtend(reader.read(12), 12);
+            } else {
+                dod = static_cast<int64_t>(reader.read(64));
+            }
+            delta += static_cast<uint64_t>(dod);
+        }
+        value += delta;
+        out[i] = static_cast<int64_t>(value);
+    }
+    return n;
+}
+
+void CompressedColumn::encode(const double* values, size_t count, const double* previous) {
+    m_words.clear();
+    m_blockStart.clear();
+    m_count = count;
+    BitWriter writer(m_words);
+
+    for (size_t first = 0; first < count; first += kCompressedBlockSize) {
+        size_t n = std::min(kCompressedBlockSize, count - first);
+        const double* block = values + first;
+        const double* predecessors = previous ? previous + first : block;
+        m_blockStart.push_back(writer.position());
+
+        int decimals = decimalPlaces(block, predecessors, n);
+        writer.write(decimals >= 0 ? 1 : 0, 1);
+        if (decimals >= 0) {
+            encodeDecimal(writer, block, predecessors, n, decimals);
+        } else {
+            encodeXor(writer, block, n);
+        }
+    }
+    m_words.shrink_to_fit();
+}
+
+size_t CompressedColumn::bytes() const {
+    return m_words.size() * sizeof(uint64_t) + m_blockStart.size() * sizeof(uint64_t);
+}
+
+size_t CompressedColumn::decodeBlock(size_t block, double* out, const double* previous) const {
+    size_t first = block * kCompressedBlockSize;
+    if (first >= m_count) {
+        return 0;
+    }
+    size_t n = std::min(kCompressedBlockSize, m_count - first);
+    BitReader reader(m_words, m_blockStart[block]);
+    if (reader.bit()) {
+        decodeDecimal(reader, out, previous ? previous : out, n);
+    } else {
+        decodeXor(reader, out, n);
+    }
+    return n;
+}
+
+BarBlock::BarBlock()
+    : time(kCompressedBlockSize), open(kCompressedBlockSize), high(kCompressedBlockSize),
+      low(kCompressedBlockSize), close(kCompressedBlockSize), volume(kCompressedBlockSize),
+      volumeUsd(kCompressedBlockSize) {}
+
+OHLCV BarBlock::bar(size_t i) const {
+    return OHLCV{time[i], open[i], high[i], low[i], close[i], volume[i], volumeUsd[i]};
+}
+
+CompressedBars CompressedBars::compress(const std::vector<OHLCV>& bars) {
+    CompressedBars result;
+    result.m_count = bars.size();
+
+    // Transpose one column at a time so only one scratch column is live
+    std::vector<int64_t> times(bars.size());
+    for (size_t i = 0; i < bars.size(); ++i) {
+        times[i] = bars[i].unix_time;
+    }
+    result.m_time.encode(times.data(), times.size());
+    times = std::vector<int64_t>();
+
+    std::vector<double> column(bars.size());
+    auto encode = [&](CompressedColumn& target, double OHLCV::*field) {
+        for (size_t i = 0; i < bars.size(); ++i) {
+            column[i] = bars[i].*field;
+        }
+        target.encode(column.data(), column.size());
+    };
+    encode(result.m_high, &OHLCV::high);
+    encode(result.m_low, &OHLCV::low);
+    encode(result.m_close, &OHLCV::close);
+
+    // Bars usually open at the previous close, so opens are stored as their
+    // difference from it (mostly zero-width groups)
+    std::vector<double> closes(column);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        column[i] = bars[i].open;
+    }
+    result.m_open.encode(column.data(), column.size(), closes.data());
+    closes = std::vector<double>();
+    encode(result.m_volume, &OHLCV::volume_btc);
+
+    // Quote volume derived by the loader as volume x close is recomputed on
+    // decode; those blocks store zeros, which cost a few bytes
+    result.m_derivedUsd.assign(result.blockCount(), false);
+    for (size_t b = 0; b < result.blockCount(); ++b) {
+        size_t first = b * kCompressedBlockSize;
+        size_t end = std::min(bars.size(), first + kCompressedBlockSize);
+        bool derived = true;
+        for (size_t i = first; i < end && derived; ++i) {
+            derived = toBits(bars[i].volume_usd) == toBits(bars[i].volume_btc * bars[i].close);
+        }
+        result.m_derivedUsd[b] = derived;
+        for (size_t i = first; i < end; ++i) {
+            column[i] = derived ? 0.0 : bars[i].volume_usd;
+        }
+    }
+    result.m_volumeUsd.encode(column.data(), column.size());
+    return result;
+}
+
+size_t CompressedBars::bytes() const {
+    return sizeof(*this) + m_time.bytes() + m_open.bytes() + m_high.bytes() + m_low.bytes() +
+           m_close.bytes() + m_volume.bytes() + m_volumeUsd.bytes() + m_derivedUsd.size() / 8;
+}
+
+size_t CompressedBars::rawBytes() const {
+    return m_count * sizeof(OHLCV);
+}
+
+void CompressedBars::decodeBlock(size_t block, BarBlock& out) const {
+    out.first = block * kCompressedBlockSize;
+    out.count = m_time.decodeBlock(block, out.time.data());
+    m_high.decodeBlock(block, out.high.data());
+    m_low.decodeBlock(block, out.low.data());
+    m_close.decodeBlock(block, out.close.data());
+    m_open.decodeBlock(block, out.open.data(), out.close.data());
+    m_volume.decodeBlock(block, out.volume.data());
+    m_volumeUsd.decodeBlock(block, out.volumeUsd.data());
+    if (m_derivedUsd[block]) {
+        for (size_t i = 0; i < out.count; ++i) {
+            out.volumeUsd[i] = out.volume[i] * out.close[i];
+        }
+    }
+}
+
+size_t CompressedBars::decodeCloses(size_t block, double* out) const {
+    return m_close.decodeBlock(block, out);
+}
+
+std::vector<OHLCV> CompressedBars::decompress() const {
+    std::vector<OHLCV> bars;
+    bars.reserve(m_count);
+    BarBlock block;
+    for (size_t b = 0; b < blockCount(); ++b) {
+        decodeBlock(b, block);
+        for (size_t i = 0; i < block.count; ++i) {
+            bars.push_back(block.bar(i));
+        }
+    }
+    return bars;
+}
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,343 @@
+#include "data/csv_schema.h"
+#include "data/data_loader.h"
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+constexpr size_t kMaxFields = 32;
+constexpr size_t kMaxBannerLines = 8;
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t' || text.front() == '"' ||
+                             text.front() == '\'')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r' ||
+                             text.back() == '"' || text.back() == '\'')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+size_t splitFields(std::string_view line, std::string_view* fields) {
+    size_t count = 0;
+    while (count < kMaxFields) {
+        size_t comma = line.find(',');
+        fields[count++] = trim(line.substr(0, comma));
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        line.remove_prefix(comma + 1);
+    }
+    return count;
+}
+
+bool parseNumber(std::string_view text, double& value) {
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    if (text.empty()) {
+        return false;
+    }
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+// Header name with case, spaces, '_', '-' and a UTF-8 byte order mark removed
+std::string normalise(std::string_view name) {
+    std::string out;
+    for (char c : name) {
+        unsigned char u = static_cast<unsigned char>(c);
+        if (c == ' ' || c == '_' || c == '-' || u >= 0x80) {
+            continue;
+        }
+        out += static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    }
+    return out;
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+int64_t daysFromCivil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+// Reads up to `maxDigits` digits; false if there are none
+bool readDigits(std::string_view& text, size_t maxDigits, int& value) {
+    size_t n = 0;
+    value = 0;
+    while (n < maxDigits && n < text.size() && text[n] >= '0' && text[n] <= '9') {
+        value = value * 10 + (text[n] - '0');
+        ++n;
+    }
+    text.remove_prefix(n);
+    return n > 0;
+}
+
+bool parseIsoDate(std::string_view text, int64_t& seconds) {
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    if (!readDigits(text, 4, year) || text.empty() || (text[0] != '-' && text[0] != '/')) {
+        return false;
+    }
+    char separator = text[0];
+    text.remove_prefix(1);
+    if (!readDigits(text, 2, month) || text.empty() || text[0] != separator) {
+        return false;
+    }
+    text.remove_prefix(1);
+    if (!readDigits(text, 2, day) || month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    if (!text.empty() && (text[0] == 'T' || text[0] == ' ')) {
+        text.remove_prefix(1);
+        if (!readDigits(text, 2, hour)) {
+            return false;
+        }
+        if (text.size() >= 3 && text[0] == '-' && (text[1] == 'A' || text[1] == 'P') && text[2] == 'M') {
+            // Hourly exports write "2024-01-31 01-PM"
+            if (hour < 1 || hour > 12) {
+                return false;
+            }
+            hour = hour % 12 + (text[1] == 'P' ? 12 : 0);
+            text.remove_prefix(3);
+        } else if (!text.empty() && text[0] == ':') {
+            text.remove_prefix(1);
+            if (!readDigits(text, 2, minute)) {
+                return false;
+            }
+            if (!text.empty() && text[0] == ':') {
+                text.remove_prefix(1);
+                if (!readDigits(text, 2, second)) {
+                    return false;
+                }
+                if (!text.empty() && text[0] == '.') {
+                    int fraction = 0;
+                    text.remove_prefix(1);
+                    while (readDigits(text, 9, fraction)) {
+                    }
+                }
+            }
+        }
+    }
+
+    int offset = 0;
+    if (!text.empty() && text[0] == 'Z') {
+        text.remove_prefix(1);
+    } else if (!text.empty() && (text[0] == '+' || text[0] == '-')) {
+        int sign = text[0] == '-' ? -1 : 1;
+        int offsetHours = 0;
+        int offsetMinutes = 0;
+        text.remove_prefix(1);
+        if (!readDigits(text, 2, offsetHours)) {
+            return false;
+        }
+        if (!text.empty() && text[0] == ':') {
+            text.remove_prefix(1);
+        }
+        readDigits(text, 2, offsetMinutes);
+        offset = sign * (offsetHours * 3600 + offsetMinutes * 60);
+    }
+    if (!text.empty() || hour > 23 || minute > 59 || second > 60) {
+        return false;
+    }
+
+    seconds = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+              hour * 3600 + minute * 60 + second - offset;
+    return true;
+}
+
+bool parseEpoch(std::string_view text, int64_t& seconds) {
+    int64_t value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr == text.data()) {
+        return false;
+    }
+    // Ignore a fractional part: "1700000000.5"
+    std::string_view rest = text.substr(static_cast<size_t>(result.ptr - text.data()));
+    if (!rest.empty()) {
+        if (rest[0] != '.' || rest.find_first_not_of("0123456789", 1) != std::string_view::npos) {
+            return false;
+        }
+    }
+
+    // Seconds reach 1e11 in the year 5138, so larger values are finer units
+    int64_t magnitude = std::llabs(value);
+    if (magnitude >= 100000000000000000LL) {
+        value /= 1000000000;
+    } else if (magnitude >= 100000000000000LL) {
+        value /= 1000000;
+    } else if (magnitude >= 100000000000LL) {
+        value /= 1000;
+    }
+    seconds = value;
+    return true;
+}
+
+} // namespace
+
+bool parseTimestamp(std::string_view text, int64_t& seconds) {
+    text = trim(text);
+    if (text.size() > 4 && (text[4] == '-' || text[4] == '/')) {
+        return parseIsoDate(text, seconds);
+    }
+    return !text.empty() && parseEpoch(text, seconds);
+}
+
+std::string formatTimestamp(int64_t seconds) {
+    int64_t days = seconds >= 0 ? seconds / 86400 : -((-seconds + 86399) / 86400);
+    int64_t secondOfDay = seconds - days * 86400;
+
+    // Inverse of daysFromCivil
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    unsigned dayOfEra = static_cast<unsigned>(z - era * 146097);
+    unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    unsigned mp = (5 * dayOfYear + 2) / 153;
+    unsigned day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+
+    char buffer[48];
+    if (secondOfDay == 0) {
+        std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u", static_cast<long long>(year), month, day);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u %02d:%02d:%02d", static_cast<long long>(year),
+                      month, day, static_cast<int>(secondOfDay / 3600), static_cast<int>(secondOfDay / 60 % 60),
+                      static_cast<int>(secondOfDay % 60));
+    }
+    return buffer;
+}
+
+bool CsvSchema::detect(const std::vector<std::string_view>& lines, CsvSchema& schema) {
+    // Time columns by preference: epoch numbers parse faster than dates
+    static const char* const timeNames[] = {
+        "unix", "unixtimestamp", "timestamp", "opentime", "datetime", "date", "time", "timeperiodstart"
+    };
+    constexpr int kTimeNames = sizeof(timeNames) / sizeof(timeNames[0]);
+
+    std::string_view fields[kMaxFields];
+    for (size_t l = 0; l < lines.size() && l < kMaxBannerLines; ++l) {
+        CsvSchema found;
+        found.skipLines = l + 1;
+        int timeRank = kTimeNames;
+        size_t count = splitFields(lines[l], fields);
+        for (size_t f = 0; f < count; ++f) {
+            std::string name = normalise(fields[f]);
+            int column = static_cast<int>(f);
+            for (int t = 0; t < timeRank; ++t) {
+                if (name == timeNames[t]) {
+                    found.time = column;
+                    timeRank = t;
+                }
+            }
+            if (name == "open" && found.open < 0) found.open = column;
+            if (name == "high" && found.high < 0) found.high = column;
+            if (name == "low" && found.low < 0) found.low = column;
+            if (name == "close" && found.close < 0) found.close = column;
+            if (name.find("vol") != std::string::npos) {
+                // "Volume USD", "quote asset volume" and "volumeto" are in the quote currency
+                bool quote = name.find("usd") != std::string::npos || name.find("quote") != std::string::npos ||
+                             name == "volumeto";
+                int& slot = quote ? found.volumeUsd : found.volume;
+                if (slot < 0) {
+                    slot = column;
+                }
+            }
+        }
+        if (found.time >= 0 && found.open >= 0 && found.high >= 0 && found.low >= 0 && found.close >= 0) {
+            schema = found;
+            return true;
+        }
+
+        // No header: a numeric first row is read as exchange klines
+        int64_t time = 0;
+        double price = 0.0;
+        if (count >= 6 && parseTimestamp(fields[0], time) && parseNumber(fields[4], price)) {
+            schema = CsvSchema();
+            schema.time = 0;
+            schema.open = 1;
+            schema.high = 2;
+            schema.low = 3;
+            schema.close = 4;
+            schema.volume = 5;
+            schema.volumeUsd = count >= 8 ? 7 : -1;
+            schema.skipLines = l;
+            return true;
+        }
+    }
+    return false;
+}
+
+CsvSchema CsvSchema::canonical() {
+    CsvSchema schema;
+    schema.time = 0;
+    schema.open = 1;
+    schema.high = 2;
+    schema.low = 3;
+    schema.close = 4;
+    schema.volume = 5;
+    schema.volumeUsd = 6;
+    return schema;
+}
+
+bool CsvSchema::parseRow(std::string_view line, OHLCV& bar) const {
+    std::string_view fields[kMaxFields];
+    size_t count = splitFields(line, fields);
+    auto field = [&](int column) {
+        return column >= 0 && static_cast<size_t>(column) < count ? fields[column] : std::string_view();
+    };
+
+    if (!parseTimestamp(field(time), bar.unix_time) || !parseNumber(field(open), bar.open) ||
+        !parseNumber(field(high), bar.high) || !parseNumber(field(low), bar.low) ||
+        !parseNumber(field(close), bar.close)) {
+        return false;
+    }
+
+    bool hasVolume = parseNumber(field(volume), bar.volume_btc);
+    bool hasVolumeUsd = parseNumber(field(volumeUsd), bar.volume_usd);
+    if (!hasVolume) {
+        bar.volume_btc = hasVolumeUsd && bar.close != 0.0 ? bar.volume_usd / bar.close : 0.0;
+    }
+    if (!hasVolumeUsd) {
+        bar.volume_usd = bar.volume_btc * bar.close;
+    }
+    return true;
+}
+
+std::string CsvSchema::describe() const {
+    std::string out;
+    auto add = [&out](const char* name, int column) {
+        if (column >= 0) {
+            out += out.empty() ? "" : " ";
+            out += name;
+            out += "=" + std::to_string(column);
+        }
+    };
+    add("time", time);
+    add("open", open);
+    add("high", high);
+    add("low", low);
+    add("close", close);
+    add("volume", volume);
+    add("volume_usd", volumeUsd);
+    return out;
+}
+
+} // namespace data
+} // namespace crypto
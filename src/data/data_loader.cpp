@@ -1,84 +1,264 @@
 #include "data/data_loader.h"
+#include "utils/memory_accounting.h"
+#include "utils/thread_pool.h"
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cmath>
+#include <cstdio>
 #include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <thread>
 
 namespace crypto {
 namespace data {
 
-DataLoader::DataLoader(const std::string& filePath) : m_filePath(filePath) {}
+size_t indicatorValidFrom(const IndicatorRequest& request, size_t output) {
+    // Mirrors the ready() conditions of the streaming forms
+    size_t period = static_cast<size_t>(std::max(1, request.period));
+    switch (request.kind) {
+        case IndicatorKind::RSI:
+            return period;    // The first change is at bar 1
+        case IndicatorKind::MACD: {
+            size_t slow = static_cast<size_t>(std::max(1, static_cast<int>(request.param)));
+            size_t signal = request.param2 > 0.0 ? static_cast<size_t>(std::max(1, static_cast<int>(request.param2))) : 9;
+            size_t line = std::max(period, slow) - 1;
+            return output == 0 ? line : line + signal - 1;
+        }
+        case IndicatorKind::Stochastic: {
+            size_t dPeriod = request.param > 0.0 ? static_cast<size_t>(std::max(1, static_cast<int>(request.param))) : 3;
+            return output == 0 ? period - 1 : period + dPeriod - 2;
+        }
+        case IndicatorKind::ADX:
+            // +DI/-DI need `period` moves, ADX another period - 1 DX values
+            return output == 0 ? 2 * period - 1 : period;
+        case IndicatorKind::OBV:
+            return 0;
+        default:
+            return period - 1;
+    }
+}
 
-bool DataLoader::loadData() {
-    std::ifstream file(m_filePath);
+IndicatorRequest bollingerKey(int period, double stdDev) {
+    return {IndicatorKind::BollingerBands, period, stdDev};
+}
+
+DataLoader::DataLoader(const std::string& filePath) 
+    : m_filePath(filePath), m_datasetHash(0), m_datasetHashed(false), m_verbose(true) {}
+
+namespace {
+
+// Value of a stored series before its validity start
+const double kWarmup = std::numeric_limits<double>::quiet_NaN();
+
+void markWarmup(std::vector<double>& series, size_t validFrom) {
+    std::fill(series.begin(), series.begin() + std::min(validFrom, series.size()), kWarmup);
+}
+
+// Parse one file with its own sniffed layout, oldest bar first
+bool readBars(const std::string& path, std::vector<OHLCV>& bars) {
+    utils::MemoryScope scope(utils::MemoryTag::Bars);
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file.is_open()) {
-        std::cerr << "Error: Could not open file " << m_filePath << std::endl;
+        std::cerr << "Error: Could not open file " << path << std::endl;
+        return false;
+    }
+    std::string text(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(&text[0], static_cast<std::streamsize>(text.size()));
+    
+    size_t position = 0;
+    auto nextLine = [&text, &position](std::string_view& line) {
+        if (position >= text.size()) {
+            return false;
+        }
+        size_t newline = text.find('\n', position);
+        size_t end = newline == std::string::npos ? text.size() : newline;
+        line = std::string_view(text).substr(position, end - position);
+        position = end + 1;
+        return true;
+    };
+    
+    std::vector<std::string_view> head;
+    std::string_view line;
+    while (head.size() < 8 && nextLine(line)) {
+        head.push_back(line);
+    }
+    CsvSchema schema;
+    if (!CsvSchema::detect(head, schema)) {
+        std::cerr << "Error: No time/open/high/low/close header in " << path << std::endl;
         return false;
     }
     
-    std::string line;
+    bars.reserve(static_cast<size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+    size_t malformed = 0;
+    auto parse = [&](std::string_view row) {
+        OHLCV bar;
+        if (schema.parseRow(row, bar)) {
+            bars.push_back(bar);
+        } else if (row.find_first_not_of(" \t\r") != std::string_view::npos) {
+            ++malformed;
+        }
+    };
+    for (size_t i = schema.skipLines; i < head.size(); ++i) {
+        parse(head[i]);
+    }
+    while (nextLine(line)) {
+        parse(line);
+    }
     
-    // Skip first two lines (URL and header)
-    std::getline(file, line);
-    std::getline(file, line);
+    if (malformed > 0) {
+        std::cerr << "Warning: Skipped " << malformed << " malformed rows in " << path << std::endl;
+    }
     
-    // Process each line
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string token;
-        
-        OHLCV data;
-        
-        // Parse each column (unix,date,symbol,open,high,low,close,Volume BTC,Volume USD)
-        std::getline(ss, token, ',');
-        data.unix_time = std::stol(token);
-        
-        std::getline(ss, token, ',');
-        data.date = token;
-        
-        std::getline(ss, token, ',');
-        data.symbol = token;
-        
-        std::getline(ss, token, ',');
-        data.open = std::stod(token);
-        
-        std::getline(ss, token, ',');
-        data.high = std::stod(token);
-        
-        std::getline(ss, token, ',');
-        data.low = std::stod(token);
-        
-        std::getline(ss, token, ',');
-        data.close = std::stod(token);
-        
-        std::getline(ss, token, ',');
-        data.volume_btc = std::stod(token);
-        
-        std::getline(ss, token, ',');
-        if (!token.empty()) {
-            data.volume_usd = std::stod(token);
+    // Exports are often newest first
+    if (bars.size() > 1 && bars.front().unix_time > bars.back().unix_time) {
+        std::reverse(bars.begin(), bars.end());
+    }
+    return true;
+}
+
+} // namespace
+
+bool DataLoader::loadData() {
+    utils::MemoryScope scope(utils::MemoryTag::Bars);
+    std::vector<std::string> files;
+    std::error_code error;
+    if (std::filesystem::is_directory(m_filePath, error)) {
+        for (const auto& entry : std::filesystem::directory_iterator(m_filePath, error)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".csv") {
+                files.push_back(entry.path().string());
+            }
         }
-        
-        m_data.push_back(data);
+        std::sort(files.begin(), files.end());
+        if (files.empty()) {
+            std::cerr << "Error: No .csv files in " << m_filePath << std::endl;
+            return false;
+        }
+    } else {
+        files.push_back(m_filePath);
     }
     
-    // If data is in descending order (newest first), reverse it
-    if (!m_data.empty() && !m_data.back().date.empty() && !m_data.front().date.empty()) {
-        if (m_data.front().date > m_data.back().date) {
-            std::reverse(m_data.begin(), m_data.end());
+    // Daily or monthly files are independent, so each parses on its own thread
+    std::vector<std::vector<OHLCV>> parts(files.size());
+    std::vector<char> loaded(files.size(), 0);
+    if (files.size() == 1) {
+        loaded[0] = readBars(files[0], parts[0]);
+    } else {
+        size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        utils::ThreadPool pool(std::min(files.size(), cores));
+        for (size_t f = 0; f < files.size(); ++f) {
+            pool.submit([&files, &parts, &loaded, f] {
+                loaded[f] = readBars(files[f], parts[f]);
+            });
         }
+        pool.wait();
     }
     
-    std::cout << "Loaded " << m_data.size() << " records from " << m_filePath << std::endl;
+    size_t total = 0;
+    for (const auto& part : parts) {
+        total += part.size();
+    }
+    std::vector<OHLCV> bars;
+    bars.reserve(total);
+    for (size_t f = 0; f < files.size(); ++f) {
+        bars.insert(bars.end(), parts[f].begin(), parts[f].end());
+        std::vector<OHLCV>().swap(parts[f]);
+    }
+    ValidationReport report = validateBars(bars, m_validation);
+    setData(std::move(bars));
+    m_validationReport = std::move(report);
+    
+    size_t failed = static_cast<size_t>(std::count(loaded.begin(), loaded.end(), 0));
+    std::cout << "Loaded " << m_data.size() << " records from " << m_filePath;
+    if (files.size() > 1) {
+        std::cout << " (" << files.size() - failed << " of " << files.size() << " files)";
+    }
+    std::cout << std::endl;
+    m_validationReport.print(std::cout);
     
     if (!m_data.empty()) {
-        std::cout << "Data range: " << m_data.front().date << " to " << m_data.back().date << std::endl;
+        auto range = getDateRange();
+        std::cout << "Data range: " << range.first << " to " << range.second << std::endl;
+        utils::markMilestone("data loaded");
     }
     
     return !m_data.empty();
 }
 
+bool DataLoader::parseBar(const std::string& line, OHLCV& data) {
+    static const CsvSchema schema = CsvSchema::canonical();
+    return schema.parseRow(line, data);
+}
+
+std::string DataLoader::formatBar(const OHLCV& bar) {
+    char buffer[192];
+    std::snprintf(buffer, sizeof(buffer), "%lld,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g",
+                  static_cast<long long>(bar.unix_time), bar.open, bar.high, bar.low, bar.close,
+                  bar.volume_btc, bar.volume_usd);
+    return buffer;
+}
+
+void DataLoader::setValidation(const ValidationConfig& config) {
+    m_validation = config;
+}
+
+const ValidationReport& DataLoader::getValidationReport() const {
+    return m_validationReport;
+}
+
+void DataLoader::setData(std::vector<OHLCV> data) {
+    utils::MemoryScope scope(utils::MemoryTag::Bars);
+    m_data = std::move(data);
+    
+    // Indicators computed on previous data no longer apply
+    m_sma.clear();
+    m_ema.clear();
+    m_rsi.clear();
+    m_bollingerUpper.clear();
+    m_bollingerLower.clear();
+    m_library.clear();
+    
+    buildCloseIndex();
+}
+
+void DataLoader::buildCloseIndex() {
+    // New data: the cache key must be recomputed
+    m_datasetHashed = false;
+    
+    // Columns for the indicator kernels, and prefix sums of closes for
+    // O(1) window statistics
+    m_columns = OHLCVColumns::fromBars(m_data);
+    m_closeIndex.build(m_columns.close);
+}
+
+void DataLoader::setVerbose(bool verbose) {
+    m_verbose = verbose;
+}
+
+void DataLoader::setIndicatorCache(const std::string& dir) {
+    m_cache = IndicatorCache(dir);
+}
+
+bool DataLoader::loadCached(const std::string& key, std::vector<double>& series) {
+    if (!m_cache.enabled() || m_data.empty()) {
+        return false;
+    }
+    if (!m_datasetHashed) {
+        m_datasetHash = IndicatorCache::hashDataset(m_data);
+        m_datasetHashed = true;
+    }
+    return m_cache.load(m_datasetHash, key, series) && series.size() == m_data.size();
+}
+
+void DataLoader::storeCached(const std::string& key, const std::vector<double>& series) {
+    // loadCached always runs first and computes the dataset hash
+    if (m_cache.enabled() && m_datasetHashed) {
+        m_cache.store(m_datasetHash, key, series);
+    }
+}
+
 const std::vector<OHLCV>& DataLoader::getData() const {
     return m_data;
 }
@@ -87,80 +267,103 @@ std::pair<std::string, std::string> DataLoader::getDateRange() const {
     if (m_data.empty()) {
         return {"", ""};
     }
-    return {m_data.front().date, m_data.back().date};
+    return {formatTimestamp(m_data.front().unix_time), formatTimestamp(m_data.back().unix_time)};
 }
 
 void DataLoader::addSMA(int period) {
+    utils::MemoryScope scope(utils::MemoryTag::Indicators);
     if (m_data.empty() || period <= 0 || period > static_cast<int>(m_data.size())) {
         return;
     }
     
     // Check if already calculated
-    if (m_sma.find(period) != m_sma.end()) {
+    if (hasSeries(m_sma, period)) {
         return;
     }
     
-    std::vector<double> sma(m_data.size(), 0.0);
-    
-    // Calculate SMA
-    for (size_t i = 0; i < m_data.size(); ++i) {
-        if (i < static_cast<size_t>(period - 1)) {
-            sma[i] = 0.0;  // Not enough data
-        } else {
-            double sum = 0.0;
-            for (int j = 0; j < period; ++j) {
-                sum += m_data[i - j].close;
-            }
-            sma[i] = sum / period;
+    std::string key = IndicatorCache::makeKey("sma", period);
+    std::vector<double> cached;
+    if (loadCached(key, cached)) {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        m_sma.emplace(period, std::move(cached));
+        if (m_verbose) {
+            std::cout << "Loaded SMA(" << period << ") from cache" << std::endl;
         }
+        return;
     }
     
-    m_sma[period] = sma;
-    std::cout << "Calculated SMA(" << period << ")" << std::endl;
+    std::vector<double> sma(m_data.size(), kWarmup);
+    
+    // Calculate SMA (first period - 1 values stay warmup, not enough data)
+    for (size_t i = period - 1; i < m_data.size(); ++i) {
+        sma[i] = m_closeIndex.windowMean(period, i);
+    }
+    
+    storeCached(key, sma);
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    m_sma.emplace(period, std::move(sma));
+    if (m_verbose) {
+        std::cout << "Calculated SMA(" << period << ")" << std::endl;
+    }
 }
 
 void DataLoader::addEMA(int period) {
+    utils::MemoryScope scope(utils::MemoryTag::Indicators);
     if (m_data.empty() || period <= 0 || period > static_cast<int>(m_data.size())) {
         return;
     }
     
     // Check if already calculated
-    if (m_ema.find(period) != m_ema.end()) {
+    if (hasSeries(m_ema, period)) {
         return;
     }
     
-    std::vector<double> ema(m_data.size(), 0.0);
-    
-    // First value is SMA
-    double sum = 0.0;
-    for (int i = 0; i < period; ++i) {
-        sum += m_data[i].close;
+    std::string key = IndicatorCache::makeKey("ema", period);
+    std::vector<double> cached;
+    if (loadCached(key, cached)) {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        m_ema.emplace(period, std::move(cached));
+        if (m_verbose) {
+            std::cout << "Loaded EMA(" << period << ") from cache" << std::endl;
+        }
+        return;
     }
-    ema[period - 1] = sum / period;
     
-    // Multiplier: (2 / (Time periods + 1) )
-    double multiplier = 2.0 / (period + 1.0);
+    // SMA-seeded EMA, shared with the streaming form
+    std::vector<double> ema = computeEMA(m_columns.close, period);
+    markWarmup(ema, indicatorValidFrom({IndicatorKind::EMA, period, 0.0}));
     
-    // Calculate EMA for the rest
-    for (size_t i = period; i < m_data.size(); ++i) {
-        ema[i] = (m_data[i].close - ema[i - 1]) * multiplier + ema[i - 1];
+    storeCached(key, ema);
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    m_ema.emplace(period, std::move(ema));
+    if (m_verbose) {
+        std::cout << "Calculated EMA(" << period << ")" << std::endl;
     }
-    
-    m_ema[period] = ema;
-    std::cout << "Calculated EMA(" << period << ")" << std::endl;
 }
 
 void DataLoader::addRSI(int period) {
+    utils::MemoryScope scope(utils::MemoryTag::Indicators);
     if (m_data.empty() || period <= 0 || period > static_cast<int>(m_data.size())) {
         return;
     }
     
     // Check if already calculated
-    if (m_rsi.find(period) != m_rsi.end()) {
+    if (hasSeries(m_rsi, period)) {
+        return;
+    }
+    
+    std::string key = IndicatorCache::makeKey("rsi", period);
+    std::vector<double> cached;
+    if (loadCached(key, cached)) {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        m_rsi.emplace(period, std::move(cached));
+        if (m_verbose) {
+            std::cout << "Loaded RSI(" << period << ") from cache" << std::endl;
+        }
         return;
     }
     
-    std::vector<double> rsi(m_data.size(), 0.0);
+    std::vector<double> rsi(m_data.size(), kWarmup);
     std::vector<double> gains(m_data.size(), 0.0);
     std::vector<double> losses(m_data.size(), 0.0);
     
@@ -201,11 +404,16 @@ void DataLoader::addRSI(int period) {
         rsi[i] = 100.0 - (100.0 / (1.0 + rs));
     }
     
-    m_rsi[period] = rsi;
-    std::cout << "Calculated RSI(" << period << ")" << std::endl;
+    storeCached(key, rsi);
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    m_rsi.emplace(period, std::move(rsi));
+    if (m_verbose) {
+        std::cout << "Calculated RSI(" << period << ")" << std::endl;
+    }
 }
 
 void DataLoader::addBollingerBands(int period, double stdDev) {
+    utils::MemoryScope scope(utils::MemoryTag::Indicators);
     if (m_data.empty() || period <= 0 || period > static_cast<int>(m_data.size())) {
         return;
     }
@@ -213,31 +421,217 @@ void DataLoader::addBollingerBands(int period, double stdDev) {
     // Calculate SMA first (middle band)
     addSMA(period);
     
-    // Check if already calculated
-    if (m_bollingerUpper.find(period) != m_bollingerUpper.end()) {
+    // Check if already calculated; bands of other widths are separate series
+    const IndicatorRequest bands = bollingerKey(period, stdDev);
+    if (hasBands(bands)) {
         return;
     }
     
-    std::vector<double> upper(m_data.size(), 0.0);
-    std::vector<double> lower(m_data.size(), 0.0);
+    std::string upperKey = IndicatorCache::makeKey("bb-upper", period, stdDev);
+    std::string lowerKey = IndicatorCache::makeKey("bb-lower", period, stdDev);
+    std::vector<double> cachedUpper;
+    std::vector<double> cachedLower;
+    if (loadCached(upperKey, cachedUpper) && loadCached(lowerKey, cachedLower)) {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        m_bollingerUpper.emplace(bands, std::move(cachedUpper));
+        m_bollingerLower.emplace(bands, std::move(cachedLower));
+        if (m_verbose) {
+            std::cout << "Loaded Bollinger Bands(" << period << ", " << stdDev << ") from cache" << std::endl;
+        }
+        return;
+    }
+    
+    std::vector<double> upper(m_data.size(), kWarmup);
+    std::vector<double> lower(m_data.size(), kWarmup);
     
     // Calculate standard deviation and bands
+    const std::vector<double>* smaSeries;
+    {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        smaSeries = &m_sma[period];
+    }
+    const std::vector<double>& sma = *smaSeries;
     for (size_t i = period - 1; i < m_data.size(); ++i) {
-        double sum = 0.0;
-        for (int j = 0; j < period; ++j) {
-            double diff = m_data[i - j].close - m_sma[period][i];
-            sum += diff * diff;
-        }
-        double stdDev_val = std::sqrt(sum / period);
+        double stdDev_val = m_closeIndex.windowStdDev(period, i);
         
-        upper[i] = m_sma[period][i] + stdDev * stdDev_val;
-        lower[i] = m_sma[period][i] - stdDev * stdDev_val;
+        upper[i] = sma[i] + stdDev * stdDev_val;
+        lower[i] = sma[i] - stdDev * stdDev_val;
+    }
+    
+    storeCached(upperKey, upper);
+    storeCached(lowerKey, lower);
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    m_bollingerUpper.emplace(bands, std::move(upper));
+    m_bollingerLower.emplace(bands, std::move(lower));
+
+    if (m_verbose) {
+        std::cout << "Calculated Bollinger Bands(" << period << ", " << stdDev << ")" << std::endl;
+    }
+}
+
+void DataLoader::addIndicator(const IndicatorRequest& request) {
+    utils::MemoryScope scope(utils::MemoryTag::Indicators);
+    switch (request.kind) {
+        case IndicatorKind::SMA:
+            addSMA(request.period);
+            break;
+        case IndicatorKind::EMA:
+            addEMA(request.period);
+            break;
+        case IndicatorKind::RSI:
+            addRSI(request.period);
+            break;
+        case IndicatorKind::BollingerBands:
+            addBollingerBands(request.period, request.param);
+            break;
+        default:
+            addLibraryIndicator(request);
+            break;
+    }
+}
+
+void DataLoader::addIndicators(const std::vector<IndicatorRequest>& requests, utils::ThreadPool* pool, int node) {
+    if (!pool || requests.size() < 2) {
+        for (const auto& request : requests) {
+            addIndicator(request);
+        }
+        return;
+    }
+    
+    // Hash once up front so the tasks only read it
+    if (m_cache.enabled() && !m_data.empty() && !m_datasetHashed) {
+        m_datasetHash = IndicatorCache::hashDataset(m_data);
+        m_datasetHashed = true;
+    }
+    
+    utils::TaskGroup group(*pool);
+    for (const auto& request : requests) {
+        group.submit([this, request] { addIndicator(request); }, node);
+    }
+    group.wait();
+}
+
+bool DataLoader::hasSeries(const std::map<int, std::vector<double>>& series, int period) const {
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    return series.find(period) != series.end();
+}
+
+bool DataLoader::hasBands(const IndicatorRequest& key) const {
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    return m_bollingerUpper.find(key) != m_bollingerUpper.end();
+}
+
+bool DataLoader::hasLibrarySeries(const IndicatorRequest& request) const {
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    return m_library.find(request) != m_library.end();
+}
+
+namespace {
+
+const char* libraryName(IndicatorKind kind) {
+    switch (kind) {
+        case IndicatorKind::MACD: return "macd";
+        case IndicatorKind::ATR: return "atr";
+        case IndicatorKind::VWAP: return "vwap";
+        case IndicatorKind::Stochastic: return "stoch";
+        case IndicatorKind::ADX: return "adx";
+        case IndicatorKind::Donchian: return "donchian";
+        case IndicatorKind::OBV: return "obv";
+        default: return "indicator";
+    }
+}
+
+size_t outputCount(IndicatorKind kind) {
+    switch (kind) {
+        case IndicatorKind::BollingerBands:
+        case IndicatorKind::Stochastic:
+            return 2;
+        case IndicatorKind::MACD:
+        case IndicatorKind::ADX:
+        case IndicatorKind::Donchian:
+            return 3;
+        default:
+            return 1;
+    }
+}
+
+std::string libraryKey(const IndicatorRequest& request, size_t output) {
+    std::ostringstream key;
+    key.precision(17);
+    key << libraryName(request.kind) << "-" << request.period << "-" << request.param
+        << "-" << request.param2 << "-" << output;
+    return key.str();
+}
+
+} // namespace
+
+void DataLoader::addLibraryIndicator(const IndicatorRequest& request) {
+    if (m_data.empty() || hasLibrarySeries(request)) {
+        return;
+    }
+    
+    size_t outputs = outputCount(request.kind);
+    
+    // All outputs come from the cache or none do
+    std::vector<std::vector<double>> series(outputs);
+    bool cached = true;
+    for (size_t o = 0; o < outputs && cached; ++o) {
+        cached = loadCached(libraryKey(request, o), series[o]);
+    }
+    if (cached) {
+        std::lock_guard<std::mutex> lock(m_indicatorMutex);
+        m_library.emplace(request, std::move(series));
+        if (m_verbose) {
+            std::cout << "Loaded " << libraryKey(request, 0) << " from cache" << std::endl;
+        }
+        return;
     }
     
-    m_bollingerUpper[period] = upper;
-    m_bollingerLower[period] = lower;
+    switch (request.kind) {
+        case IndicatorKind::MACD: {
+            int signal = request.param2 > 0.0 ? static_cast<int>(request.param2) : 9;
+            MACDSeries macd = computeMACD(m_columns.close, request.period, static_cast<int>(request.param), signal);
+            series = {std::move(macd.line), std::move(macd.signal), std::move(macd.histogram)};
+            break;
+        }
+        case IndicatorKind::ATR:
+            series = {computeATR(m_columns, request.period)};
+            break;
+        case IndicatorKind::VWAP:
+            series = {computeVWAP(m_columns, request.period)};
+            break;
+        case IndicatorKind::Stochastic: {
+            int dPeriod = request.param > 0.0 ? static_cast<int>(request.param) : 3;
+            StochasticSeries stochastic = computeStochastic(m_columns, request.period, dPeriod);
+            series = {std::move(stochastic.k), std::move(stochastic.d)};
+            break;
+        }
+        case IndicatorKind::ADX: {
+            ADXSeries adx = computeADX(m_columns, request.period);
+            series = {std::move(adx.adx), std::move(adx.plusDI), std::move(adx.minusDI)};
+            break;
+        }
+        case IndicatorKind::Donchian: {
+            DonchianSeries donchian = computeDonchian(m_columns, request.period);
+            series = {std::move(donchian.upper), std::move(donchian.middle), std::move(donchian.lower)};
+            break;
+        }
+        case IndicatorKind::OBV:
+            series = {computeOBV(m_columns)};
+            break;
+        default:
+            return;
+    }
     
-    std::cout << "Calculated Bollinger Bands(" << period << ", " << stdDev << ")" << std::endl;
+    for (size_t o = 0; o < series.size(); ++o) {
+        markWarmup(series[o], indicatorValidFrom(request, o));
+        storeCached(libraryKey(request, o), series[o]);
+    }
+    std::lock_guard<std::mutex> lock(m_indicatorMutex);
+    m_library.emplace(request, std::move(series));
+    if (m_verbose) {
+        std::cout << "Calculated " << libraryKey(request, 0) << std::endl;
+    }
 }
 
 std::vector<double> DataLoader::getSMA(int period) const {
@@ -264,21 +658,103 @@ std::vector<double> DataLoader::getRSI(int period) const {
     return std::vector<double>();
 }
 
-std::vector<double> DataLoader::getBollingerUpper(int period) const {
-    auto it = m_bollingerUpper.find(period);
+std::vector<double> DataLoader::getBollingerUpper(int period, double stdDev) const {
+    auto it = m_bollingerUpper.find(bollingerKey(period, stdDev));
     if (it != m_bollingerUpper.end()) {
         return it->second;
     }
     return std::vector<double>();
 }
 
-std::vector<double> DataLoader::getBollingerLower(int period) const {
-    auto it = m_bollingerLower.find(period);
+std::vector<double> DataLoader::getBollingerLower(int period, double stdDev) const {
+    auto it = m_bollingerLower.find(bollingerKey(period, stdDev));
     if (it != m_bollingerLower.end()) {
         return it->second;
     }
     return std::vector<double>();
 }
 
+std::vector<double> DataLoader::getIndicator(const IndicatorRequest& request, size_t output) const {
+    auto it = m_library.find(request);
+    if (it != m_library.end() && output < it->second.size()) {
+        return it->second[output];
+    }
+    return std::vector<double>();
+}
+
+const std::vector<double>* DataLoader::findIndicator(const IndicatorRequest& request, size_t output) const {
+    const std::map<int, std::vector<double>>* series = nullptr;
+    switch (request.kind) {
+        case IndicatorKind::SMA:
+            series = &m_sma;
+            break;
+        case IndicatorKind::EMA:
+            series = &m_ema;
+            break;
+        case IndicatorKind::RSI:
+            series = &m_rsi;
+            break;
+        case IndicatorKind::BollingerBands: {
+            const auto& bands = output == 0 ? m_bollingerUpper : m_bollingerLower;
+            auto it = bands.find(bollingerKey(request.period, request.param));
+            return it != bands.end() && output < 2 ? &it->second : nullptr;
+        }
+        default: {
+            auto it = m_library.find(request);
+            if (it != m_library.end() && output < it->second.size()) {
+                return &it->second[output];
+            }
+            return nullptr;
+        }
+    }
+    
+    auto it = series->find(request.period);
+    return it != series->end() && output == 0 ? &it->second : nullptr;
+}
+
+IndicatorSeries DataLoader::findSeries(const IndicatorRequest& request, size_t output) const {
+    return {findIndicator(request, output), indicatorValidFrom(request, output)};
+}
+
+size_t DataLoader::commonValidStart(const std::vector<IndicatorRequest>& requests) const {
+    size_t start = 0;
+    for (const auto& request : requests) {
+        for (size_t o = 0; o < outputCount(request.kind); ++o) {
+            start = std::max(start, indicatorValidFrom(request, o));
+        }
+    }
+    return std::min(start, m_data.size());
+}
+
+const OHLCVColumns& DataLoader::getColumns() const {
+    return m_columns;
+}
+
+const PrefixSumIndex& DataLoader::getCloseIndex() const {
+    return m_closeIndex;
+}
+
+double DataLoader::getSMAAt(int period, size_t index) const {
+    return m_closeIndex.windowMean(period, index);
+}
+
+double DataLoader::getStdDevAt(int period, size_t index) const {
+    return m_closeIndex.windowStdDev(period, index);
+}
+
+double DataLoader::getBollingerUpperAt(int period, double stdDev, size_t index) const {
+    if (!m_closeIndex.hasWindow(period, index)) {
+        return 0.0;
+    }
+    return m_closeIndex.windowMean(period, index) + stdDev * m_closeIndex.windowStdDev(period, index);
+}
+
+double DataLoader::getBollingerLowerAt(int period, double stdDev, size_t index) const {
+    if (!m_closeIndex.hasWindow(period, index)) {
+        return 0.0;
+    }
+    return m_closeIndex.windowMean(period, index) - stdDev * m_closeIndex.windowStdDev(period, index);
+}
+
 } // namespace data
 } // namespace crypto
\ No newline at end of file
@@ -0,0 +1,268 @@
+#include "data/data_validation.h"
+#include "data/data_loader.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+// Flat stretches have a MAD of zero; never flag moves smaller than this scale
+constexpr double kMinScale = 1e-4;
+// Returns sampled (evenly spaced) from each block to estimate its scale
+constexpr size_t kScaleSamples = 64;
+constexpr size_t kMaxPrintedOutliers = 5;
+
+// Sort by time and keep the last bar of each timestamp; returns the number dropped
+size_t sortAndDeduplicate(std::vector<OHLCV>& bars) {
+    auto earlier = [](const OHLCV& a, const OHLCV& b) { return a.unix_time < b.unix_time; };
+    if (!std::is_sorted(bars.begin(), bars.end(), earlier)) {
+        std::stable_sort(bars.begin(), bars.end(), earlier);
+    }
+
+    // Nothing moves until the first duplicate
+    size_t kept = 1;
+    while (kept < bars.size() && bars[kept].unix_time != bars[kept - 1].unix_time) {
+        ++kept;
+    }
+    for (size_t i = kept; i < bars.size(); ++i) {
+        if (bars[kept - 1].unix_time == bars[i].unix_time) {
+            bars[kept - 1] = bars[i];
+        } else {
+            bars[kept++] = bars[i];
+        }
+    }
+    kept = std::min(kept, bars.size());
+    size_t dropped = bars.size() - kept;
+    bars.resize(kept);
+    return dropped;
+}
+
+// Median spacing of the first few thousand bars
+int64_t inferInterval(const std::vector<OHLCV>& bars) {
+    size_t count = std::min<size_t>(bars.size() - 1, 4096);
+    std::vector<int64_t> spacing(count);
+    for (size_t i = 0; i < count; ++i) {
+        spacing[i] = bars[i + 1].unix_time - bars[i].unix_time;
+    }
+    std::nth_element(spacing.begin(), spacing.begin() + count / 2, spacing.end());
+    return std::max<int64_t>(spacing[count / 2], 1);
+}
+
+bool validPrices(const OHLCV& bar) {
+    // NaN fails every comparison, so this also rejects non-finite prices
+    bool finite = bar.open > 0.0 && bar.open < HUGE_VAL && bar.high > 0.0 && bar.high < HUGE_VAL &&
+                  bar.low > 0.0 && bar.low < HUGE_VAL && bar.close > 0.0 && bar.close < HUGE_VAL;
+    return finite && bar.low <= std::min(bar.open, bar.close) && bar.high >= std::max(bar.open, bar.close);
+}
+
+// Median and 1.4826 * MAD of up to kScaleSamples evenly spaced finite
+// values of `block`; a sample of 64 pins both to a few percent
+void robustScale(const std::vector<double>& block, std::vector<double>& scratch, double& median, double& scale) {
+    scratch.clear();
+    size_t step = std::max<size_t>(block.size() / kScaleSamples, 1);
+    for (size_t i = 0; i < block.size(); i += step) {
+        if (std::isfinite(block[i])) {
+            scratch.push_back(block[i]);
+        }
+    }
+    if (scratch.empty()) {
+        return;
+    }
+    auto middle = scratch.begin() + scratch.size() / 2;
+    std::nth_element(scratch.begin(), middle, scratch.end());
+    median = *middle;
+    for (double& value : scratch) {
+        value = std::fabs(value - median);
+    }
+    std::nth_element(scratch.begin(), middle, scratch.end());
+    scale = 1.4826 * *middle;
+}
+
+// Every check in one pass over blocks of `window` bars, so each bar is read
+// from memory once and the outlier test runs on returns still in cache.
+// Nothing is modified: bad bars are listed for the caller to repair. Returns
+// false at the first bar that is not strictly later than the one before.
+bool scanBars(const std::vector<OHLCV>& bars, const ValidationConfig& config, ValidationReport& report,
+              std::vector<size_t>& invalid) {
+    const size_t n = bars.size();
+    const size_t window = std::max<size_t>(config.window, 8);
+    const int64_t interval = report.interval;
+    const bool outliers = config.outliers != OutlierAction::Off;
+    std::vector<double> returns;
+    std::vector<double> scratch;
+    returns.reserve(window);
+    scratch.reserve(kScaleSamples);
+
+    if (!validPrices(bars[0])) {
+        invalid.push_back(0);
+    }
+
+    double median = 0.0;
+    double scale = 0.0;
+    for (size_t start = 1; start < n; start += window) {
+        size_t end = std::min(n, start + window);
+        returns.resize(end - start);
+
+        for (size_t i = start; i < end; ++i) {
+            int64_t spacing = bars[i].unix_time - bars[i - 1].unix_time;
+            if (spacing != interval) {
+                if (spacing <= 0) {
+                    return false;
+                }
+                size_t missing = static_cast<size_t>((spacing - 1) / interval);
+                report.misaligned += spacing % interval != 0;
+                if (missing > 0) {
+                    ++report.gaps;
+                    report.missingBars += missing;
+                    if (missing > report.largestGap) {
+                        report.largestGap = missing;
+                        report.largestGapStart = bars[i - 1].unix_time;
+                    }
+                }
+            }
+            if (!validPrices(bars[i])) {
+                invalid.push_back(i);
+            }
+            returns[i - start] = bars[i].close / bars[i - 1].close - 1.0;
+        }
+        if (!outliers) {
+            continue;
+        }
+
+        // Each block is judged by the one before; the first by itself
+        if (start == 1) {
+            robustScale(returns, scratch, median, scale);
+        }
+        double limit = config.threshold * std::max(scale, kMinScale);
+        for (size_t i = start; i < end && i + 1 < n; ++i) {
+            double into = returns[i - start] - median;
+            if (!(std::fabs(into) > limit)) {
+                continue;
+            }
+            double outOf = bars[i + 1].close / bars[i].close - 1.0 - median;
+            if (std::fabs(outOf) > limit && (into > 0.0) != (outOf > 0.0)) {
+                report.outliers.push_back({i, bars[i].unix_time, bars[i].close});
+            }
+        }
+        robustScale(returns, scratch, median, scale);
+    }
+    return true;
+}
+
+void repairBars(std::vector<OHLCV>& bars, const std::vector<size_t>& invalid, ValidationReport& report) {
+    for (size_t i : invalid) {
+        OHLCV& bar = bars[i];
+        bool finite = std::isfinite(bar.open) && std::isfinite(bar.high) && std::isfinite(bar.low) &&
+                      std::isfinite(bar.close) && bar.open > 0.0 && bar.close > 0.0;
+        if (finite) {
+            bar.high = std::max({bar.high, bar.open, bar.close});
+            bar.low = std::min({bar.low, bar.open, bar.close});
+            ++report.repairedInvalid;
+        }
+    }
+
+    // In index order, so a run of spikes is bridged from the repaired side
+    for (const auto& outlier : report.outliers) {
+        size_t i = outlier.index;
+        OHLCV& bar = bars[i];
+        double bad = bar.close;
+        bar.close = std::sqrt(bars[i - 1].close * bars[i + 1].close);
+        if (bar.high == bad) {
+            bar.high = std::max(bar.open, bar.close);
+        }
+        if (bar.low == bad) {
+            bar.low = std::min(bar.open, bar.close);
+        }
+        ++report.repaired;
+    }
+}
+
+std::string formatInterval(int64_t seconds) {
+    if (seconds % 86400 == 0) return std::to_string(seconds / 86400) + "d";
+    if (seconds % 3600 == 0) return std::to_string(seconds / 3600) + "h";
+    if (seconds % 60 == 0) return std::to_string(seconds / 60) + "m";
+    return std::to_string(seconds) + "s";
+}
+
+} // namespace
+
+bool ValidationReport::clean() const {
+    return duplicates == 0 && gaps == 0 && misaligned == 0 && invalid == 0 && outliers.empty();
+}
+
+void ValidationReport::print(std::ostream& out) const {
+    out << "Validation: " << bars << " bars at " << formatInterval(interval) << " intervals";
+    if (clean()) {
+        out << ", no gaps, duplicates, invalid bars or outliers" << std::endl;
+        return;
+    }
+    out << "\n  Duplicates dropped: " << duplicates
+        << "\n  Gaps: " << gaps << " (" << missingBars << " missing bars";
+    if (gaps > 0) {
+        out << ", largest " << largestGap << " after " << formatTimestamp(largestGapStart);
+    }
+    out << ")\n  Misaligned spacings: " << misaligned
+        << "\n  Invalid bars: " << invalid;
+    if (repairedInvalid > 0) {
+        out << " (" << repairedInvalid << " high/low repaired)";
+    }
+    out << "\n  Outliers: " << outliers.size();
+    if (repaired > 0) {
+        out << " (" << repaired << " repaired)";
+    }
+    for (size_t o = 0; o < outliers.size() && o < kMaxPrintedOutliers; ++o) {
+        out << (o == 0 ? ": " : ", ") << formatTimestamp(outliers[o].time) << " close " << outliers[o].close;
+    }
+    if (outliers.size() > kMaxPrintedOutliers) {
+        out << ", ...";
+    }
+    out << std::endl;
+}
+
+ValidationReport validateBars(std::vector<OHLCV>& bars, const ValidationConfig& config) {
+    ValidationReport report;
+    std::vector<size_t> invalid;
+    size_t duplicates = 0;
+    bool sorted = false;
+    while (bars.size() >= 2) {
+        report = ValidationReport();
+        invalid.clear();
+        report.interval = config.interval > 0 ? config.interval : inferInterval(bars);
+        if (scanBars(bars, config, report, invalid)) {
+            break;
+        }
+        // Out of order or repeated: sort once, then scan again from the start
+        if (sorted) {
+            break;
+        }
+        duplicates = sortAndDeduplicate(bars);
+        sorted = true;
+    }
+    report.bars = bars.size();
+    report.duplicates = duplicates;
+    report.invalid = invalid.size();
+
+    if (config.outliers == OutlierAction::Repair) {
+        repairBars(bars, invalid, report);
+    }
+    return report;
+}
+
+bool parseOutlierAction(const std::string& text, OutlierAction& action) {
+    if (text == "off") {
+        action = OutlierAction::Off;
+    } else if (text == "flag") {
+        action = OutlierAction::Flag;
+    } else if (text == "repair") {
+        action = OutlierAction::Repair;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,182 @@
+#include "data/indicator_cache.h"
+#include "data/data_loader.h"
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'T', 'S', 'B', 'I', 'N', 'D', '\0'};
+constexpr uint32_t kVersion = 2;   // 2: warmup bars are NaN
+
+// 32-byte entry header, followed by `count` doubles
+struct EntryHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t datasetHash;
+    uint64_t count;
+};
+
+constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const void* bytes, size_t length) {
+    const unsigned char* p = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= p[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+// read() until `length` bytes arrive; false on error or end of file
+bool readFully(int fd, void* buffer, size_t length) {
+    char* out = static_cast<char*>(buffer);
+    while (length > 0) {
+        ssize_t n = ::read(fd, out, length);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        out += n;
+        length -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+IndicatorCache::IndicatorCache(const std::string& dir) : m_dir(dir) {}
+
+bool IndicatorCache::enabled() const {
+    return !m_dir.empty();
+}
+
+const std::string& IndicatorCache::getDir() const {
+    return m_dir;
+}
+
+uint64_t IndicatorCache::hashDataset(const std::vector<OHLCV>& data) {
+    uint64_t hash = kFnvOffset;
+    uint64_t count = data.size();
+    hash = fnv1a(hash, &count, sizeof(count));
+    for (const auto& bar : data) {
+        int64_t time = bar.unix_time;
+        double fields[6] = {bar.open, bar.high, bar.low, bar.close, bar.volume_btc, bar.volume_usd};
+        hash = fnv1a(hash, &time, sizeof(time));
+        hash = fnv1a(hash, fields, sizeof(fields));
+    }
+    return hash;
+}
+
+std::string IndicatorCache::makeKey(const std::string& name, int period, double param) {
+    char buffer[96];
+    if (param == 0.0) {
+        std::snprintf(buffer, sizeof(buffer), "%s-%d", name.c_str(), period);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%s-%d-%.17g", name.c_str(), period, param);
+    }
+    return buffer;
+}
+
+std::string IndicatorCache::entryPath(uint64_t datasetHash, const std::string& key) const {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(datasetHash));
+    return m_dir + "/" + hash + "/" + key + ".bin";
+}
+
+bool IndicatorCache::load(uint64_t datasetHash, const std::string& key, std::vector<double>& series) const {
+    if (!enabled()) {
+        return false;
+    }
+
+    std::string path = entryPath(datasetHash, key);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(EntryHeader)) {
+        ::close(fd);
+        return false;
+    }
+
+    // Read straight into the series: the DataLoader owns every series as a
+    // vector, so a mapping would only be copied out of again
+    size_t size = static_cast<size_t>(st.st_size);
+    EntryHeader header;
+    bool valid = readFully(fd, &header, sizeof(header)) &&
+                 std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0 &&
+                 header.version == kVersion &&
+                 header.datasetHash == datasetHash &&
+                 size == sizeof(EntryHeader) + header.count * sizeof(double);
+    if (valid) {
+        series.resize(header.count);
+        valid = readFully(fd, series.data(), header.count * sizeof(double));
+    }
+    ::close(fd);
+    return valid;
+}
+
+bool IndicatorCache::store(uint64_t datasetHash, const std::string& key, const std::vector<double>& series) const {
+    if (!enabled()) {
+        return false;
+    }
+
+    std::string path = entryPath(datasetHash, key);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    if (ec) {
+        std::cerr << "Warning: Could not create indicator cache directory for " << path << std::endl;
+        return false;
+    }
+
+    EntryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.datasetHash = datasetHash;
+    header.count = series.size();
+
+    // Unique temporary name (per process and per call, since pool threads
+    // may store the same key at once), then an atomic rename into place
+    static std::atomic<uint64_t> sequence{0};
+    std::string temp = path + ".tmp" + std::to_string(getpid()) + "-" + std::to_string(sequence++);
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Warning: Could not write indicator cache entry " << temp << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(series.data()), series.size() * sizeof(double));
+        if (!file) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace data
+} // namespace crypto
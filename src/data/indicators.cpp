@@ -0,0 +1,427 @@
+#include "data/indicators.h"
+#include "data/data_loader.h"
+#include <algorithm>
+#include <cmath>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+double trueRange(double high, double low, double prevClose) {
+    return std::max({high - low, std::fabs(high - prevClose), std::fabs(low - prevClose)});
+}
+
+} // namespace
+
+OHLCVColumns OHLCVColumns::fromBars(const std::vector<OHLCV>& bars) {
+    OHLCVColumns columns;
+    size_t n = bars.size();
+    columns.open.resize(n);
+    columns.high.resize(n);
+    columns.low.resize(n);
+    columns.close.resize(n);
+    columns.volume.resize(n);
+    columns.volumeUsd.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        columns.open[i] = bars[i].open;
+        columns.high[i] = bars[i].high;
+        columns.low[i] = bars[i].low;
+        columns.close[i] = bars[i].close;
+        columns.volume[i] = bars[i].volume_btc;
+        columns.volumeUsd[i] = bars[i].volume_usd;
+    }
+    return columns;
+}
+
+// EMA
+
+EMAStream::EMAStream(int period)
+    : m_period(std::max(1, period)), m_multiplier(2.0 / (std::max(1, period) + 1.0)) {
+    reset();
+}
+
+void EMAStream::reset() {
+    m_count = 0;
+    m_sum = 0.0;
+    m_value = 0.0;
+}
+
+double EMAStream::update(double value) {
+    ++m_count;
+    if (m_count < m_period) {
+        m_sum += value;
+    } else if (m_count == m_period) {
+        m_sum += value;
+        m_value = m_sum / m_period;
+    } else {
+        m_value = (value - m_value) * m_multiplier + m_value;
+    }
+    return m_value;
+}
+
+// SMA
+
+SMAStream::SMAStream(int period) : m_period(std::max(1, period)) {
+    reset();
+}
+
+void SMAStream::reset() {
+    m_count = 0;
+    m_head = 0;
+    m_sum = 0.0;
+    m_value = 0.0;
+    m_ring.assign(m_period, 0.0);
+}
+
+double SMAStream::update(double value) {
+    m_sum += value - m_ring[m_head];
+    m_ring[m_head] = value;
+    m_head = m_head + 1 == m_ring.size() ? 0 : m_head + 1;
+    if (++m_count >= m_period) {
+        m_value = m_sum / m_period;
+    }
+    return m_value;
+}
+
+// MACD
+
+MACDStream::MACDStream(int fast, int slow, int signal)
+    : m_fast(fast), m_slow(slow), m_signal(signal) {
+    reset();
+}
+
+void MACDStream::reset() {
+    m_fast.reset();
+    m_slow.reset();
+    m_signal.reset();
+    m_value = {0.0, 0.0, 0.0};
+}
+
+MACDValue MACDStream::update(double close) {
+    double fast = m_fast.update(close);
+    double slow = m_slow.update(close);
+    if (!m_fast.ready() || !m_slow.ready()) {
+        return m_value;
+    }
+
+    m_value.line = fast - slow;
+    double signal = m_signal.update(m_value.line);
+    if (m_signal.ready()) {
+        m_value.signal = signal;
+        m_value.histogram = m_value.line - signal;
+    }
+    return m_value;
+}
+
+// ATR
+
+ATRStream::ATRStream(int period) : m_period(std::max(1, period)) {
+    reset();
+}
+
+void ATRStream::reset() {
+    m_count = 0;
+    m_prevClose = 0.0;
+    m_sum = 0.0;
+    m_value = 0.0;
+}
+
+double ATRStream::update(double high, double low, double close) {
+    double tr = m_count == 0 ? high - low : trueRange(high, low, m_prevClose);
+    m_prevClose = close;
+    ++m_count;
+
+    if (m_count < m_period) {
+        m_sum += tr;
+    } else if (m_count == m_period) {
+        m_sum += tr;
+        m_value = m_sum / m_period;
+    } else {
+        m_value = (m_value * (m_period - 1) + tr) / m_period;
+    }
+    return m_value;
+}
+
+// VWAP
+
+VWAPStream::VWAPStream(int period) : m_period(std::max(1, period)) {
+    reset();
+}
+
+void VWAPStream::reset() {
+    m_count = 0;
+    m_head = 0;
+    m_volume = 0.0;
+    m_volumeUsd = 0.0;
+    m_value = 0.0;
+    m_volumeRing.assign(m_period, 0.0);
+    m_volumeUsdRing.assign(m_period, 0.0);
+}
+
+double VWAPStream::update(double close, double volume, double volumeUsd) {
+    m_volume += volume - m_volumeRing[m_head];
+    m_volumeUsd += volumeUsd - m_volumeUsdRing[m_head];
+    m_volumeRing[m_head] = volume;
+    m_volumeUsdRing[m_head] = volumeUsd;
+    m_head = m_head + 1 == m_volumeRing.size() ? 0 : m_head + 1;
+
+    if (++m_count >= m_period) {
+        m_value = m_volume > 0.0 ? m_volumeUsd / m_volume : close;
+    }
+    return m_value;
+}
+
+// Stochastic
+
+StochasticStream::StochasticStream(int kPeriod, int dPeriod)
+    : m_highest(kPeriod), m_lowest(kPeriod), m_d(dPeriod) {
+    reset();
+}
+
+void StochasticStream::reset() {
+    m_highest.reset();
+    m_lowest.reset();
+    m_d.reset();
+    m_value = {0.0, 0.0};
+}
+
+StochasticValue StochasticStream::update(double high, double low, double close) {
+    double highest = m_highest.push(high);
+    double lowest = m_lowest.push(low);
+    if (!m_highest.ready()) {
+        return m_value;
+    }
+
+    double range = highest - lowest;
+    m_value.k = range > 0.0 ? 100.0 * (close - lowest) / range : 50.0;
+    double d = m_d.update(m_value.k);
+    if (m_d.ready()) {
+        m_value.d = d;
+    }
+    return m_value;
+}
+
+// ADX
+
+ADXStream::ADXStream(int period) : m_period(std::max(1, period)) {
+    reset();
+}
+
+void ADXStream::reset() {
+    m_count = 0;
+    m_dxCount = 0;
+    m_prevHigh = 0.0;
+    m_prevLow = 0.0;
+    m_prevClose = 0.0;
+    m_trSum = 0.0;
+    m_plusSum = 0.0;
+    m_minusSum = 0.0;
+    m_dxSum = 0.0;
+    m_value = {0.0, 0.0, 0.0};
+}
+
+ADXValue ADXStream::update(double high, double low, double close) {
+    ++m_count;
+    if (m_count == 1) {
+        m_prevHigh = high;
+        m_prevLow = low;
+        m_prevClose = close;
+        return m_value;
+    }
+
+    double upMove = high - m_prevHigh;
+    double downMove = m_prevLow - low;
+    double plusDM = (upMove > downMove && upMove > 0.0) ? upMove : 0.0;
+    double minusDM = (downMove > upMove && downMove > 0.0) ? downMove : 0.0;
+    double tr = trueRange(high, low, m_prevClose);
+    m_prevHigh = high;
+    m_prevLow = low;
+    m_prevClose = close;
+
+    // Movements seen so far; the first `period` seed the smoothed sums
+    int moves = m_count - 1;
+    if (moves <= m_period) {
+        m_trSum += tr;
+        m_plusSum += plusDM;
+        m_minusSum += minusDM;
+        if (moves < m_period) {
+            return m_value;
+        }
+    } else {
+        m_trSum = m_trSum - m_trSum / m_period + tr;
+        m_plusSum = m_plusSum - m_plusSum / m_period + plusDM;
+        m_minusSum = m_minusSum - m_minusSum / m_period + minusDM;
+    }
+
+    m_value.plusDI = m_trSum > 0.0 ? 100.0 * m_plusSum / m_trSum : 0.0;
+    m_value.minusDI = m_trSum > 0.0 ? 100.0 * m_minusSum / m_trSum : 0.0;
+    double diSum = m_value.plusDI + m_value.minusDI;
+    double dx = diSum > 0.0 ? 100.0 * std::fabs(m_value.plusDI - m_value.minusDI) / diSum : 0.0;
+
+    ++m_dxCount;
+    if (m_dxCount < m_period) {
+        m_dxSum += dx;
+    } else if (m_dxCount == m_period) {
+        m_dxSum += dx;
+        m_value.adx = m_dxSum / m_period;
+    } else {
+        m_value.adx = (m_value.adx * (m_period - 1) + dx) / m_period;
+    }
+    return m_value;
+}
+
+// Donchian
+
+DonchianStream::DonchianStream(int period) : m_highest(period), m_lowest(period) {
+    reset();
+}
+
+void DonchianStream::reset() {
+    m_highest.reset();
+    m_lowest.reset();
+    m_value = {0.0, 0.0, 0.0};
+}
+
+DonchianValue DonchianStream::update(double high, double low) {
+    double highest = m_highest.push(high);
+    double lowest = m_lowest.push(low);
+    if (m_highest.ready()) {
+        m_value.upper = highest;
+        m_value.lower = lowest;
+        m_value.middle = (highest + lowest) / 2.0;
+    }
+    return m_value;
+}
+
+// OBV
+
+OBVStream::OBVStream() {
+    reset();
+}
+
+void OBVStream::reset() {
+    m_started = false;
+    m_prevClose = 0.0;
+    m_value = 0.0;
+}
+
+double OBVStream::update(double close, double volume) {
+    if (m_started) {
+        if (close > m_prevClose) {
+            m_value += volume;
+        } else if (close < m_prevClose) {
+            m_value -= volume;
+        }
+    }
+    m_started = true;
+    m_prevClose = close;
+    return m_value;
+}
+
+// Batch kernels: one pass of the streaming recurrence per series
+
+std::vector<double> computeEMA(const std::vector<double>& values, int period) {
+    std::vector<double> out(values.size());
+    EMAStream stream(period);
+    for (size_t i = 0; i < values.size(); ++i) {
+        out[i] = stream.update(values[i]);
+    }
+    return out;
+}
+
+MACDSeries computeMACD(const std::vector<double>& close, int fast, int slow, int signal) {
+    size_t n = close.size();
+    MACDSeries series;
+    series.line.resize(n);
+    series.signal.resize(n);
+    series.histogram.resize(n);
+
+    MACDStream stream(fast, slow, signal);
+    for (size_t i = 0; i < n; ++i) {
+        MACDValue value = stream.update(close[i]);
+        series.line[i] = value.line;
+        series.signal[i] = value.signal;
+        series.histogram[i] = value.histogram;
+    }
+    return series;
+}
+
+std::vector<double> computeATR(const OHLCVColumns& bars, int period) {
+    std::vector<double> out(bars.size());
+    ATRStream stream(period);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        out[i] = stream.update(bars.high[i], bars.low[i], bars.close[i]);
+    }
+    return out;
+}
+
+std::vector<double> computeVWAP(const OHLCVColumns& bars, int period) {
+    std::vector<double> out(bars.size());
+    VWAPStream stream(period);
+    for (size_t i = 0; i < bars.size(); ++i) {
+        out[i] = stream.update(bars.close[i], bars.volume[i], bars.volumeUsd[i]);
+    }
+    return out;
+}
+
+StochasticSeries computeStochastic(const OHLCVColumns& bars, int kPeriod, int dPeriod) {
+    size_t n = bars.size();
+    StochasticSeries series;
+    series.k.resize(n);
+    series.d.resize(n);
+
+    StochasticStream stream(kPeriod, dPeriod);
+    for (size_t i = 0; i < n; ++i) {
+        StochasticValue value = stream.update(bars.high[i], bars.low[i], bars.close[i]);
+        series.k[i] = value.k;
+        series.d[i] = value.d;
+    }
+    return series;
+}
+
+ADXSeries computeADX(const OHLCVColumns& bars, int period) {
+    size_t n = bars.size();
+    ADXSeries series;
+    series.adx.resize(n);
+    series.plusDI.resize(n);
+    series.minusDI.resize(n);
+
+    ADXStream stream(period);
+    for (size_t i = 0; i < n; ++i) {
+        ADXValue value = stream.update(bars.high[i], bars.low[i], bars.close[i]);
+        series.adx[i] = value.adx;
+        series.plusDI[i] = value.plusDI;
+        series.minusDI[i] = value.minusDI;
+    }
+    return series;
+}
+
+DonchianSeries computeDonchian(const OHLCVColumns& bars, int period) {
+    size_t n = bars.size();
+    DonchianSeries series;
+    series.upper.resize(n);
+    series.middle.resize(n);
+    series.lower.resize(n);
+
+    DonchianStream stream(period);
+    for (size_t i = 0; i < n; ++i) {
+        DonchianValue value = stream.update(bars.high[i], bars.low[i]);
+        series.upper[i] = value.upper;
+        series.middle[i] = value.middle;
+        series.lower[i] = value.lower;
+    }
+    return series;
+}
+
+std::vector<double> computeOBV(const OHLCVColumns& bars) {
+    std::vector<double> out(bars.size());
+    OBVStream stream;
+    for (size_t i = 0; i < bars.size(); ++i) {
+        out[i] = stream.update(bars.close[i], bars.volume[i]);
+    }
+    return out;
+}
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,152 @@
+#include "data/prefix_sum_index.h"
+#include <cmath>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+// Minimal double-double arithmetic (Dekker/Knuth error-free transforms)
+struct DD {
+    double hi;
+    double lo;
+};
+
+inline DD twoSum(double a, double b) {
+    double s = a + b;
+    double bb = s - a;
+    double e = (a - (s - bb)) + (b - bb);
+    return {s, e};
+}
+
+inline DD quickTwoSum(double a, double b) {
+    double s = a + b;
+    double e = b - (s - a);
+    return {s, e};
+}
+
+inline DD add(const DD& a, double b, double bErr) {
+    DD s = twoSum(a.hi, b);
+    return quickTwoSum(s.hi, s.lo + a.lo + bErr);
+}
+
+inline DD sub(const DD& a, const DD& b) {
+    DD s = twoSum(a.hi, -b.hi);
+    return quickTwoSum(s.hi, s.lo + (a.lo - b.lo));
+}
+
+inline DD mul(const DD& a, double b) {
+    double p = a.hi * b;
+    double e = std::fma(a.hi, b, -p) + a.lo * b;
+    return quickTwoSum(p, e);
+}
+
+inline DD square(const DD& a) {
+    double p = a.hi * a.hi;
+    double e = std::fma(a.hi, a.hi, -p) + 2.0 * a.hi * a.lo;
+    return quickTwoSum(p, e);
+}
+
+} // namespace
+
+void PrefixSumIndex::build(const std::vector<double>& values) {
+    size_t n = values.size();
+    m_sumHi.assign(n + 1, 0.0);
+    m_sumLo.assign(n + 1, 0.0);
+    m_sqHi.assign(n + 1, 0.0);
+    m_sqLo.assign(n + 1, 0.0);
+
+    DD sum{0.0, 0.0};
+    DD sq{0.0, 0.0};
+
+    for (size_t i = 0; i < n; ++i) {
+        double x = values[i];
+
+        // x * x split exactly into product and rounding error
+        double xx = x * x;
+        double xxErr = std::fma(x, x, -xx);
+
+        sum = add(sum, x, 0.0);
+        sq = add(sq, xx, xxErr);
+
+        m_sumHi[i + 1] = sum.hi;
+        m_sumLo[i + 1] = sum.lo;
+        m_sqHi[i + 1] = sq.hi;
+        m_sqLo[i + 1] = sq.lo;
+    }
+}
+
+void PrefixSumIndex::append(double x) {
+    if (m_sumHi.empty()) {
+        m_sumHi.push_back(0.0);
+        m_sumLo.push_back(0.0);
+        m_sqHi.push_back(0.0);
+        m_sqLo.push_back(0.0);
+    }
+
+    double xx = x * x;
+    double xxErr = std::fma(x, x, -xx);
+
+    DD sum = add({m_sumHi.back(), m_sumLo.back()}, x, 0.0);
+    DD sq = add({m_sqHi.back(), m_sqLo.back()}, xx, xxErr);
+
+    m_sumHi.push_back(sum.hi);
+    m_sumLo.push_back(sum.lo);
+    m_sqHi.push_back(sq.hi);
+    m_sqLo.push_back(sq.lo);
+}
+
+size_t PrefixSumIndex::size() const {
+    return m_sumHi.empty() ? 0 : m_sumHi.size() - 1;
+}
+
+bool PrefixSumIndex::empty() const {
+    return size() == 0;
+}
+
+bool PrefixSumIndex::hasWindow(int period, size_t index) const {
+    return period > 0 && index < size() && index + 1 >= static_cast<size_t>(period);
+}
+
+double PrefixSumIndex::windowSum(int period, size_t index) const {
+    if (!hasWindow(period, index)) {
+        return 0.0;
+    }
+
+    size_t end = index + 1;
+    size_t begin = end - period;
+    DD sum = sub({m_sumHi[end], m_sumLo[end]}, {m_sumHi[begin], m_sumLo[begin]});
+    return sum.hi + sum.lo;
+}
+
+double PrefixSumIndex::windowMean(int period, size_t index) const {
+    if (!hasWindow(period, index)) {
+        return 0.0;
+    }
+    return windowSum(period, index) / period;
+}
+
+double PrefixSumIndex::windowVariance(int period, size_t index) const {
+    if (!hasWindow(period, index)) {
+        return 0.0;
+    }
+
+    size_t end = index + 1;
+    size_t begin = end - period;
+    DD sum = sub({m_sumHi[end], m_sumLo[end]}, {m_sumHi[begin], m_sumLo[begin]});
+    DD sq = sub({m_sqHi[end], m_sqLo[end]}, {m_sqHi[begin], m_sqLo[begin]});
+
+    // period^2 * variance = period * sum(x^2) - sum(x)^2, kept in double-double
+    // so the cancellation between the two terms stays exact
+    DD scaled = sub(mul(sq, static_cast<double>(period)), square(sum));
+    double variance = (scaled.hi + scaled.lo) / (static_cast<double>(period) * period);
+
+    return variance > 0.0 ? variance : 0.0;
+}
+
+double PrefixSumIndex::windowStdDev(int period, size_t index) const {
+    return std::sqrt(windowVariance(period, index));
+}
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,187 @@
+#include "data/rolling_window.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace crypto {
+namespace data {
+
+// IndexableSkiplist
+
+IndexableSkiplist::IndexableSkiplist(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1), m_maxLevels(1), m_size(0), m_rng(0x9E3779B97F4A7C15ull) {
+    // Enough levels for O(log n) search at full capacity
+    while ((size_t(1) << m_maxLevels) < m_capacity && m_maxLevels < 32) {
+        ++m_maxLevels;
+    }
+
+    size_t nodes = m_capacity + 1;
+    m_values.assign(nodes, 0.0);
+    m_levels.assign(nodes, 0);
+    m_next.assign(nodes * m_maxLevels, kNil);
+    m_width.assign(nodes * m_maxLevels, 1);
+    m_chain.assign(m_maxLevels, 0);
+    m_steps.assign(m_maxLevels, 0);
+    clear();
+}
+
+void IndexableSkiplist::clear() {
+    m_size = 0;
+    m_levels[0] = m_maxLevels;
+    for (int level = 0; level < m_maxLevels; ++level) {
+        next(0, level) = kNil;
+        width(0, level) = 1;
+    }
+
+    m_free.clear();
+    for (size_t node = m_capacity; node >= 1; --node) {
+        m_free.push_back(static_cast<int32_t>(node));
+    }
+}
+
+int IndexableSkiplist::randomLevel() {
+    // Geometric with p = 1/2 from the trailing one bits of an xorshift draw
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 7;
+    m_rng ^= m_rng << 17;
+    uint64_t bits = m_rng;
+    int level = 1;
+    while ((bits & 1) && level < m_maxLevels) {
+        ++level;
+        bits >>= 1;
+    }
+    return level;
+}
+
+double IndexableSkiplist::nodeValue(int32_t node) const {
+    return node == kNil ? std::numeric_limits<double>::infinity() : m_values[node];
+}
+
+bool IndexableSkiplist::insert(double value) {
+    if (m_free.empty()) {
+        return false;
+    }
+
+    // Last node before the insertion point on each level, and how far it is
+    int32_t node = 0;
+    for (int level = m_maxLevels - 1; level >= 0; --level) {
+        m_steps[level] = 0;
+        while (nodeValue(next(node, level)) <= value) {
+            m_steps[level] += width(node, level);
+            node = next(node, level);
+        }
+        m_chain[level] = node;
+    }
+
+    int32_t created = m_free.back();
+    m_free.pop_back();
+    int levels = randomLevel();
+    m_values[created] = value;
+    m_levels[created] = levels;
+
+    size_t steps = 0;
+    for (int level = 0; level < levels; ++level) {
+        int32_t prev = m_chain[level];
+        next(created, level) = next(prev, level);
+        next(prev, level) = created;
+        width(created, level) = width(prev, level) - steps;
+        width(prev, level) = steps + 1;
+        steps += m_steps[level];
+    }
+    for (int level = levels; level < m_maxLevels; ++level) {
+        width(m_chain[level], level) += 1;
+    }
+
+    ++m_size;
+    return true;
+}
+
+bool IndexableSkiplist::erase(double value) {
+    int32_t node = 0;
+    for (int level = m_maxLevels - 1; level >= 0; --level) {
+        while (nodeValue(next(node, level)) < value) {
+            node = next(node, level);
+        }
+        m_chain[level] = node;
+    }
+
+    int32_t target = next(m_chain[0], 0);
+    if (target == kNil || m_values[target] != value) {
+        return false;
+    }
+
+    for (int level = 0; level < m_levels[target]; ++level) {
+        int32_t prev = m_chain[level];
+        width(prev, level) += width(target, level) - 1;
+        next(prev, level) = next(target, level);
+    }
+    for (int level = m_levels[target]; level < m_maxLevels; ++level) {
+        width(m_chain[level], level) -= 1;
+    }
+
+    m_free.push_back(target);
+    --m_size;
+    return true;
+}
+
+double IndexableSkiplist::select(size_t rank) const {
+    if (rank >= m_size) {
+        return 0.0;
+    }
+
+    int32_t node = 0;
+    size_t remaining = rank + 1;
+    for (int level = m_maxLevels - 1; level >= 0; --level) {
+        while (next(node, level) != kNil && width(node, level) <= remaining) {
+            remaining -= width(node, level);
+            node = next(node, level);
+        }
+    }
+    return m_values[node];
+}
+
+// RollingQuantile
+
+RollingQuantile::RollingQuantile(int period, double quantile)
+    : m_period(period > 0 ? period : 1),
+      m_quantile(std::clamp(quantile, 0.0, 1.0)),
+      m_value(0.0),
+      m_window(period > 0 ? period : 1),
+      m_sorted(period > 0 ? period : 1) {}
+
+void RollingQuantile::reset() {
+    m_window.clear();
+    m_sorted.clear();
+    m_value = 0.0;
+}
+
+double RollingQuantile::push(double value) {
+    if (m_window.full()) {
+        m_sorted.erase(m_window.front());
+    }
+    m_window.push_back(value);
+    m_sorted.insert(value);
+
+    m_value = quantile(m_quantile);
+    return m_value;
+}
+
+double RollingQuantile::quantile(double q) const {
+    size_t n = m_sorted.size();
+    if (n == 0) {
+        return 0.0;
+    }
+
+    double position = std::clamp(q, 0.0, 1.0) * static_cast<double>(n - 1);
+    size_t lower = static_cast<size_t>(std::floor(position));
+    double fraction = position - static_cast<double>(lower);
+    double low = m_sorted.select(lower);
+    if (fraction == 0.0 || lower + 1 >= n) {
+        return low;
+    }
+    double high = m_sorted.select(lower + 1);
+    return low + fraction * (high - low);
+}
+
+} // namespace data
+} // namespace crypto
@@ -0,0 +1,230 @@
+#include "data/synthetic_paths.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace crypto {
+namespace data {
+
+namespace {
+
+constexpr size_t kRegimeWindow = 30;
+constexpr double kStressQuantile = 0.8;
+
+void meanAndDeviation(const std::vector<double>& values, double& mean, double& deviation) {
+    mean = 0.0;
+    deviation = 0.0;
+    if (values.empty()) {
+        return;
+    }
+    for (double value : values) {
+        mean += value;
+    }
+    mean /= values.size();
+    if (values.size() < 2) {
+        return;
+    }
+    double squares = 0.0;
+    for (double value : values) {
+        squares += (value - mean) * (value - mean);
+    }
+    deviation = std::sqrt(squares / (values.size() - 1));
+}
+
+} // namespace
+
+bool parsePathModel(const std::string& name, PathModel& model) {
+    if (name == "gbm") {
+        model = PathModel::GBM;
+    } else if (name == "garch") {
+        model = PathModel::GARCH;
+    } else if (name == "regime") {
+        model = PathModel::RegimeSwitching;
+    } else if (name == "bootstrap") {
+        model = PathModel::BlockBootstrap;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const char* pathModelName(PathModel model) {
+    switch (model) {
+        case PathModel::GBM: return "gbm";
+        case PathModel::GARCH: return "garch";
+        case PathModel::RegimeSwitching: return "regime";
+        case PathModel::BlockBootstrap: return "bootstrap";
+    }
+    return "unknown";
+}
+
+PathGenerator::PathGenerator(const std::vector<OHLCV>& history, double blockSize) : m_history(history) {
+    m_calibration.blockSize = std::max(1.0, blockSize);
+
+    for (size_t i = 1; i < history.size(); ++i) {
+        const OHLCV& bar = history[i];
+        double previous = history[i - 1].close;
+        Shape shape{1.0, 1.0, 1.0, bar.volume_btc};
+        double logReturn = 0.0;
+        // Bars with a non-positive price contribute a flat step
+        if (previous > 0.0 && bar.open > 0.0 && bar.close > 0.0 && bar.low > 0.0) {
+            logReturn = std::log(bar.close / previous);
+            shape.gap = bar.open / previous;
+            shape.upperWick = std::max(1.0, bar.high / std::max(bar.open, bar.close));
+            shape.lowerWick = std::min(1.0, bar.low / std::min(bar.open, bar.close));
+        }
+        m_returns.push_back(logReturn);
+        m_shapes.push_back(shape);
+    }
+
+    PathCalibration& c = m_calibration;
+    meanAndDeviation(m_returns, c.drift, c.volatility);
+    c.garchOmega = c.volatility * c.volatility * (1.0 - c.garchAlpha - c.garchBeta);
+
+    // Label each bar calm or stressed by its trailing realised volatility
+    const size_t n = m_returns.size();
+    std::vector<double> realised(n, 0.0);
+    double sum = 0.0;
+    double squares = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += m_returns[i];
+        squares += m_returns[i] * m_returns[i];
+        if (i >= kRegimeWindow) {
+            sum -= m_returns[i - kRegimeWindow];
+            squares -= m_returns[i - kRegimeWindow] * m_returns[i - kRegimeWindow];
+        }
+        if (i + 1 >= kRegimeWindow) {
+            double mean = sum / kRegimeWindow;
+            realised[i] = std::sqrt(std::max(0.0, squares / kRegimeWindow - mean * mean));
+        }
+    }
+    if (n < kRegimeWindow) {
+        c.calmDrift = c.stressDrift = c.drift;
+        c.calmVolatility = c.volatility;
+        c.stressVolatility = 2.0 * c.volatility;
+        return;
+    }
+
+    std::vector<double> sorted(realised.begin() + (kRegimeWindow - 1), realised.end());
+    auto cut = sorted.begin() + static_cast<size_t>(kStressQuantile * (sorted.size() - 1));
+    std::nth_element(sorted.begin(), cut, sorted.end());
+    const double threshold = *cut;
+
+    std::vector<double> calm;
+    std::vector<double> stress;
+    size_t stays[2] = {0, 0};
+    size_t visits[2] = {0, 0};
+    bool previous = false;
+    for (size_t i = 0; i < n; ++i) {
+        bool stressed = i + 1 >= kRegimeWindow && realised[i] > threshold;
+        (stressed ? stress : calm).push_back(m_returns[i]);
+        if (i > 0) {
+            ++visits[previous];
+            stays[previous] += stressed == previous;
+        }
+        previous = stressed;
+    }
+    meanAndDeviation(calm, c.calmDrift, c.calmVolatility);
+    meanAndDeviation(stress, c.stressDrift, c.stressVolatility);
+    if (stress.size() < 2) {
+        c.stressDrift = c.drift;
+        c.stressVolatility = 2.0 * c.volatility;
+    }
+    if (visits[0] > 0 && stays[0] < visits[0]) {
+        c.calmStay = static_cast<double>(stays[0]) / visits[0];
+    }
+    if (visits[1] > 0 && stays[1] < visits[1]) {
+        c.stressStay = static_cast<double>(stays[1]) / visits[1];
+    }
+}
+
+const PathCalibration& PathGenerator::calibration() const {
+    return m_calibration;
+}
+
+void PathGenerator::generate(PathModel model, uint64_t seed, size_t bars, std::vector<OHLCV>& out) const {
+    const size_t n = m_history.size();
+    if (bars == 0) {
+        bars = n;
+    }
+    out.resize(bars);
+    if (bars == 0 || n == 0) {
+        return;
+    }
+
+    // Timestamps follow the history, then continue at its average spacing
+    const int64_t spacing = n > 1 ? (m_history.back().unix_time - m_history.front().unix_time) / static_cast<int64_t>(n - 1)
+                                  : 86400;
+    for (size_t i = 0; i < bars; ++i) {
+        out[i].unix_time = i < n ? m_history[i].unix_time
+                                 : m_history.back().unix_time + static_cast<int64_t>(i - n + 1) * spacing;
+    }
+
+    out[0] = m_history.front();
+    if (m_shapes.empty()) {
+        for (size_t i = 1; i < bars; ++i) {
+            int64_t time = out[i].unix_time;
+            out[i] = out[0];
+            out[i].unix_time = time;
+        }
+        return;
+    }
+
+    const PathCalibration& c = m_calibration;
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> normal(0.0, 1.0);
+    std::student_t_distribution<double> student(c.tailDof);
+    std::uniform_int_distribution<size_t> pick(0, m_shapes.size() - 1);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const double tailScale = c.tailDof > 2.0 ? std::sqrt((c.tailDof - 2.0) / c.tailDof) : 1.0;
+
+    double variance = c.volatility * c.volatility;   // GARCH state
+    bool stressed = false;                            // Regime state
+    size_t source = pick(rng);                        // Bootstrap position
+
+    for (size_t i = 1; i < bars; ++i) {
+        double logReturn = 0.0;
+        const Shape* shape = nullptr;
+
+        switch (model) {
+            case PathModel::GBM:
+                logReturn = c.drift + c.volatility * normal(rng);
+                break;
+            case PathModel::GARCH: {
+                double shock = std::sqrt(variance) * student(rng) * tailScale;
+                logReturn = c.drift + shock;
+                variance = c.garchOmega + c.garchAlpha * shock * shock + c.garchBeta * variance;
+                break;
+            }
+            case PathModel::RegimeSwitching:
+                logReturn = stressed ? c.stressDrift + c.stressVolatility * normal(rng)
+                                     : c.calmDrift + c.calmVolatility * normal(rng);
+                if (uniform(rng) >= (stressed ? c.stressStay : c.calmStay)) {
+                    stressed = !stressed;
+                }
+                break;
+            case PathModel::BlockBootstrap:
+                if (i > 1 && (uniform(rng) * c.blockSize < 1.0 || ++source >= m_shapes.size())) {
+                    source = pick(rng);
+                }
+                logReturn = m_returns[source];
+                shape = &m_shapes[source];
+                break;
+        }
+        if (!shape) {
+            shape = &m_shapes[pick(rng)];
+        }
+
+        const double previous = out[i - 1].close;
+        OHLCV& bar = out[i];
+        bar.close = previous * std::exp(logReturn);
+        bar.open = previous * shape->gap;
+        bar.high = std::max(bar.open, bar.close) * shape->upperWick;
+        bar.low = std::min(bar.open, bar.close) * shape->lowerWick;
+        bar.volume_btc = shape->volume;
+        bar.volume_usd = shape->volume * bar.close;
+    }
+}
+
+} // namespace data
+} // namespace crypto
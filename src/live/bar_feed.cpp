@@ -0,0 +1,279 @@
+#include "live/bar_feed.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace crypto {
+namespace live {
+
+namespace {
+
+// Pop one complete line off the front of `pending`
+bool takeLine(std::string& pending, std::string& line) {
+    size_t newline = pending.find('\n');
+    if (newline == std::string::npos) {
+        return false;
+    }
+    line.assign(pending, 0, newline);
+    pending.erase(0, newline + 1);
+    if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+    }
+    return true;
+}
+
+// First bar among the complete lines in `pending`. Lines before the
+// column layout is known are sniffed for a header (or a first kline row).
+bool takeBar(std::string& pending, data::CsvSchema& schema, bool& detected, FeedBar& out) {
+    std::string line;
+    while (takeLine(pending, line)) {
+        if (!detected) {
+            if (!data::CsvSchema::detect({line}, schema)) {
+                continue;
+            }
+            detected = true;
+            if (schema.skipLines > 0) {
+                continue;
+            }
+        }
+        if (schema.parseRow(line, out.bar)) {
+            out.received = Clock::now();
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read what is available; 0 at end of file, -1 on error
+ssize_t readChunk(int fd, std::string& pending) {
+    char chunk[16384];
+    while (true) {
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n > 0) {
+            pending.append(chunk, static_cast<size_t>(n));
+        }
+        return n;
+    }
+}
+
+bool sendAll(int fd, const std::string& message) {
+    size_t sent = 0;
+    while (sent < message.size()) {
+        ssize_t n = ::send(fd, message.data() + sent, message.size() - sent, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+// TailFeed
+
+TailFeed::TailFeed(const std::string& path, double idleSeconds)
+    : m_path(path), m_idleSeconds(idleSeconds), m_fd(-1), m_detected(false) {}
+
+TailFeed::~TailFeed() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool TailFeed::open() {
+    m_fd = ::open(m_path.c_str(), O_RDONLY);
+    if (m_fd < 0) {
+        std::cerr << "Error: Could not open " << m_path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool TailFeed::next(FeedBar& out) {
+    auto lastGrowth = Clock::now();
+    while (m_fd >= 0) {
+        if (takeBar(m_pending, m_schema, m_detected, out)) {
+            return true;
+        }
+
+        ssize_t n = readChunk(m_fd, m_pending);
+        if (n > 0) {
+            lastGrowth = Clock::now();
+            continue;
+        }
+        if (n < 0 || std::chrono::duration<double>(Clock::now() - lastGrowth).count() >= m_idleSeconds) {
+            // Writer has gone quiet: a last line may lack its newline
+            m_pending += '\n';
+            bool found = takeBar(m_pending, m_schema, m_detected, out);
+            ::close(m_fd);
+            m_fd = -1;
+            return found;
+        }
+        // At the current end of file; poll for appended lines
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    return false;
+}
+
+std::string TailFeed::describe() const {
+    return "tail " + m_path;
+}
+
+// SocketFeed
+
+SocketFeed::SocketFeed(const std::string& host, int port)
+    : m_host(host), m_port(port), m_fd(-1), m_detected(false) {}
+
+SocketFeed::~SocketFeed() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+}
+
+bool SocketFeed::connect() {
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addresses = nullptr;
+    int status = ::getaddrinfo(m_host.c_str(), std::to_string(m_port).c_str(), &hints, &addresses);
+    if (status != 0) {
+        std::cerr << "Error: Could not resolve " << m_host << ": " << ::gai_strerror(status) << std::endl;
+        return false;
+    }
+
+    for (addrinfo* address = addresses; address && m_fd < 0; address = address->ai_next) {
+        int fd = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        if (::connect(fd, address->ai_addr, address->ai_addrlen) == 0) {
+            m_fd = fd;
+        } else {
+            ::close(fd);
+        }
+    }
+    ::freeaddrinfo(addresses);
+
+    if (m_fd < 0) {
+        std::cerr << "Error: Could not connect to " << m_host << ":" << m_port << std::endl;
+        return false;
+    }
+    int on = 1;
+    ::setsockopt(m_fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    return true;
+}
+
+bool SocketFeed::next(FeedBar& out) {
+    while (m_fd >= 0) {
+        if (takeBar(m_pending, m_schema, m_detected, out)) {
+            return true;
+        }
+        if (readChunk(m_fd, m_pending) <= 0) {
+            m_pending += '\n';
+            bool found = takeBar(m_pending, m_schema, m_detected, out);
+            ::close(m_fd);
+            m_fd = -1;
+            return found;
+        }
+    }
+    return false;
+}
+
+std::string SocketFeed::describe() const {
+    return "tcp " + m_host + ":" + std::to_string(m_port);
+}
+
+// ReplayServer
+
+ReplayServer::ReplayServer(std::vector<data::OHLCV> bars, double barsPerSecond)
+    : m_bars(std::move(bars)), m_barsPerSecond(barsPerSecond), m_listenFd(-1), m_port(0) {}
+
+ReplayServer::~ReplayServer() {
+    if (m_listenFd >= 0) {
+        ::close(m_listenFd);
+    }
+}
+
+bool ReplayServer::listen(int port) {
+    m_listenFd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (m_listenFd < 0) {
+        std::cerr << "Error: socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int on = 1;
+    ::setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (::bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(m_listenFd, 1) != 0) {
+        std::cerr << "Error: Could not listen on port " << port << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    ::getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    m_port = ntohs(address.sin_port);
+    return true;
+}
+
+int ReplayServer::getPort() const {
+    return m_port;
+}
+
+bool ReplayServer::serve() {
+    int client = ::accept(m_listenFd, nullptr, nullptr);
+    if (client < 0) {
+        std::cerr << "Error: accept: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int on = 1;
+    ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+    // Unpaced replays batch lines into larger writes
+    bool paced = m_barsPerSecond > 0.0;
+    auto start = Clock::now();
+    std::string batch = std::string(data::CsvSchema::kCanonicalHeader) + "\n";
+    bool ok = true;
+    for (size_t i = 0; i < m_bars.size() && ok; ++i) {
+        if (paced) {
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(static_cast<double>(i) / m_barsPerSecond)));
+        }
+        batch += data::DataLoader::formatBar(m_bars[i]);
+        batch += '\n';
+        if (paced || batch.size() >= 16384) {
+            ok = sendAll(client, batch);
+            batch.clear();
+        }
+    }
+    if (ok && !batch.empty()) {
+        ok = sendAll(client, batch);
+    }
+
+    ::close(client);
+    return ok;
+}
+
+} // namespace live
+} // namespace crypto
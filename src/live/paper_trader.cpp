@@ -0,0 +1,196 @@
+#include "live/paper_trader.h"
+#include "utils/thread_affinity.h"
+#include <iomanip>
+#include <iostream>
+#include <thread>
+
+namespace crypto {
+namespace live {
+
+namespace {
+
+uint64_t nanosSince(Clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+}
+
+const char* const kRoles[] = {"feed", "decision", "broker"};
+
+} // namespace
+
+PaperTrader::PaperTrader(const PaperConfig& config, std::vector<std::shared_ptr<strategies::Strategy>> strategies)
+    : m_config(config), m_strategies(std::move(strategies)),
+      m_broker(m_strategies.size(), config.initialCapital, config.positionSize, config.slippageBps, config.feeBps),
+      m_orders(m_strategies.size(), 0), m_pinning(3), m_seconds(0.0) {}
+
+void PaperTrader::pin(size_t role, const char* name) {
+    if (m_config.cpus.empty()) {
+        return;
+    }
+    // Fewer CPUs than threads: wrap around
+    int cpu = m_config.cpus[role % m_config.cpus.size()];
+    bool pinned = utils::pinCurrentThread(cpu);
+    m_pinning[role] = std::string(name) + " -> cpu " + std::to_string(cpu) + (pinned ? "" : " (failed)");
+}
+
+bool PaperTrader::run(BarFeed& feed) {
+    m_source = feed.describe();
+    std::cout << "Paper trading " << m_strategies.size() << " strategies from " << m_source << std::endl;
+
+    utils::BoundedQueue<FeedBar> bars(m_config.queueDepth);
+    utils::BoundedQueue<BarDecisions> decisions(m_config.queueDepth);
+
+    auto start = Clock::now();
+    std::thread feedThread([&] { feedLoop(feed, bars); });
+    std::thread decisionThread([&] { decisionLoop(bars, decisions); });
+    std::thread brokerThread([&] { brokerLoop(decisions); });
+    feedThread.join();
+    decisionThread.join();
+    brokerThread.join();
+    m_seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (m_bars.empty()) {
+        std::cerr << "Error: No bars received from " << m_source << std::endl;
+        return false;
+    }
+    if (m_config.compareBacktest) {
+        runBacktestComparison();
+    }
+    return true;
+}
+
+void PaperTrader::feedLoop(BarFeed& feed, utils::BoundedQueue<FeedBar>& bars) {
+    pin(0, kRoles[0]);
+    FeedBar item;
+    while (feed.next(item)) {
+        if (!bars.push(item)) {
+            break;
+        }
+    }
+    bars.close();
+}
+
+void PaperTrader::decisionLoop(utils::BoundedQueue<FeedBar>& bars, utils::BoundedQueue<BarDecisions>& decisions) {
+    pin(1, kRoles[1]);
+
+    std::vector<std::unique_ptr<strategies::SignalStream>> streams;
+    for (const auto& strategy : m_strategies) {
+        streams.push_back(strategy->createSignalStream());
+    }
+
+    FeedBar item;
+    while (bars.pop(item)) {
+        size_t index = m_bars.size();
+        BarDecisions step{item.bar.close, {}};
+        for (size_t s = 0; s < streams.size(); ++s) {
+            strategies::Signal signal = streams[s]->update(item.bar);
+            if (signal != strategies::HOLD) {
+                step.orders.push_back({s, signal, index, item.bar.close, item.received});
+                ++m_orders[s];
+            }
+        }
+        m_decisionLatency.record(nanosSince(item.received));
+
+        m_bars.push_back(item.bar);
+        decisions.push(std::move(step));
+    }
+    decisions.close();
+}
+
+void PaperTrader::brokerLoop(utils::BoundedQueue<BarDecisions>& decisions) {
+    pin(2, kRoles[2]);
+    BarDecisions step;
+    while (decisions.pop(step)) {
+        for (const auto& order : step.orders) {
+            Fill fill;
+            if (m_broker.submit(order, fill)) {
+                m_fillLatency.record(nanosSince(order.received));
+            }
+        }
+        m_broker.mark(step.close);
+    }
+}
+
+void PaperTrader::runBacktestComparison() {
+    data::DataLoader loader("");
+    loader.setData(m_bars);
+    m_backtestEquity.clear();
+    for (const auto& strategy : m_strategies) {
+        for (const auto& request : strategy->requiredIndicators()) {
+            loader.addIndicator(request);
+        }
+        strategy->setVerbose(false);
+        strategy->backtest(loader, m_config.initialCapital, m_config.positionSize);
+        const auto& equity = strategy->getEquityCurve();
+        m_backtestEquity.push_back(equity.empty() ? m_config.initialCapital : equity.back());
+    }
+}
+
+const utils::LatencyHistogram& PaperTrader::getDecisionLatency() const {
+    return m_decisionLatency;
+}
+
+const utils::LatencyHistogram& PaperTrader::getFillLatency() const {
+    return m_fillLatency;
+}
+
+void PaperTrader::printReport() const {
+    std::cout << "\n============= Paper Trading =============\n";
+    std::cout << m_bars.size() << " bars from " << m_source << " in " << m_seconds << "s ("
+              << (m_seconds > 0.0 ? m_bars.size() / m_seconds : 0.0) << " bars/s)\n";
+
+    std::string pinning;
+    for (const auto& entry : m_pinning) {
+        if (!entry.empty()) {
+            pinning += (pinning.empty() ? "" : ", ") + entry;
+        }
+    }
+    std::cout << "Threads: " << (pinning.empty() ? "not pinned" : pinning) << "\n\n";
+
+    std::cout << std::left << std::setw(20) << "Latency (us)"
+              << std::right << std::setw(10) << "Count"
+              << std::setw(10) << "p50"
+              << std::setw(10) << "p99"
+              << std::setw(10) << "p999"
+              << std::setw(10) << "Max"
+              << std::setw(10) << "Mean" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+    auto row = [](const char* name, const utils::LatencyHistogram& histogram) {
+        std::cout << std::left << std::setw(20) << name
+                  << std::right << std::setw(10) << histogram.count()
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(10) << histogram.percentile(0.50) / 1000.0
+                  << std::setw(10) << histogram.percentile(0.99) / 1000.0
+                  << std::setw(10) << histogram.percentile(0.999) / 1000.0
+                  << std::setw(10) << histogram.max() / 1000.0
+                  << std::setw(10) << histogram.mean() / 1000.0 << std::endl;
+    };
+    row("bar -> decision", m_decisionLatency);
+    row("bar -> fill", m_fillLatency);
+
+    std::cout << "\n" << std::left << std::setw(30) << "Strategy"
+              << std::right << std::setw(10) << "Orders"
+              << std::setw(10) << "Fills"
+              << std::setw(10) << "Rejected"
+              << std::setw(10) << "Trades"
+              << std::setw(18) << "Paper Equity"
+              << std::setw(18) << "Backtest Equity" << std::endl;
+    std::cout << std::string(106, '-') << std::endl;
+    for (size_t s = 0; s < m_strategies.size(); ++s) {
+        std::cout << std::left << std::setw(30) << m_strategies[s]->getName()
+                  << std::right << std::setw(10) << m_orders[s]
+                  << std::setw(10) << m_broker.getFillCount(s)
+                  << std::setw(10) << m_broker.getRejectCount(s)
+                  << std::setw(10) << m_broker.getTrades(s).size()
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(18) << m_broker.getEquity(s);
+        if (s < m_backtestEquity.size()) {
+            std::cout << std::setw(18) << m_backtestEquity[s];
+        }
+        std::cout << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+} // namespace live
+} // namespace crypto
@@ -0,0 +1,75 @@
+#include "live/simulated_broker.h"
+
+namespace crypto {
+namespace live {
+
+SimulatedBroker::SimulatedBroker(size_t accounts, double initialCapital, double positionSize,
+                                 double slippageBps, double feeBps)
+    : m_accounts(accounts, Account{initialCapital, 0.0, 0, 0.0, 0.0, 0, 0, {}}),
+      m_positionSize(positionSize), m_slippage(slippageBps / 10000.0), m_fee(feeBps / 10000.0), m_mark(0.0) {}
+
+bool SimulatedBroker::submit(const Order& order, Fill& fill) {
+    if (order.account >= m_accounts.size()) {
+        return false;
+    }
+    Account& account = m_accounts[order.account];
+    fill = Fill{order.account, order.side, order.barIndex, order.price, 0.0, 0.0};
+
+    if (order.side == strategies::BUY && account.units == 0.0) {
+        fill.price = order.price * (1.0 + m_slippage);
+        double amount = account.cash * m_positionSize;
+        fill.fee = amount * m_fee;
+        fill.units = (amount - fill.fee) / fill.price;
+
+        account.cash -= amount;
+        account.units = fill.units;
+        account.entryIndex = order.barIndex;
+        account.entryPrice = fill.price;
+        account.entryCost = amount;
+    } else if (order.side == strategies::SELL && account.units > 0.0) {
+        fill.price = order.price * (1.0 - m_slippage);
+        fill.units = account.units;
+        double proceeds = account.units * fill.price;
+        fill.fee = proceeds * m_fee;
+        proceeds -= fill.fee;
+
+        double profit = proceeds - account.entryCost;
+        account.trades.push_back({account.entryIndex, order.barIndex, account.entryPrice, fill.price,
+                                  profit, profit / account.entryCost * 100.0, 1});
+        account.cash += proceeds;
+        account.units = 0.0;
+    } else {
+        ++account.rejects;
+        return false;
+    }
+
+    ++account.fills;
+    return true;
+}
+
+void SimulatedBroker::mark(double close) {
+    m_mark = close;
+}
+
+double SimulatedBroker::getEquity(size_t account) const {
+    return m_accounts[account].cash + m_accounts[account].units * m_mark;
+}
+
+const std::vector<strategies::Trade>& SimulatedBroker::getTrades(size_t account) const {
+    return m_accounts[account].trades;
+}
+
+size_t SimulatedBroker::getFillCount(size_t account) const {
+    return m_accounts[account].fills;
+}
+
+size_t SimulatedBroker::getRejectCount(size_t account) const {
+    return m_accounts[account].rejects;
+}
+
+size_t SimulatedBroker::getAccountCount() const {
+    return m_accounts.size();
+}
+
+} // namespace live
+} // namespace crypto
@@ -1,19 +1,307 @@
 #include "backtester/backtester.h"
-#include "strategies/sma_strategy.h"
-#include "strategies/rsi_strategy.h"
-#include "strategies/bollinger_bands_strategy.h"
+#include "backtester/run_engine.h"
+#include "backtester/compressed_backtest.h"
+#include "backtester/stress_test.h"
+#include "strategies/strategy_factory.h"
+#include "backtester/golden_harness.h"
+#include "live/paper_trader.h"
+#include "utils/memory_accounting.h"
+#include "utils/thread_affinity.h"
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <filesystem>
+#include <thread>
+#include <vector>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [data.csv|DIR] [options]\n"
+              << "  A directory loads every .csv file in it as one series\n"
+              << "  --spec FILE          Run the experiment described by a JSON run spec\n"
+              << "                       (see configs/default.json)\n"
+              << "  --indicator-cache DIR\n"
+              << "                       Persist indicators under DIR and reuse them on later runs\n"
+              << "  --outliers MODE      Bad prints found when loading: flag (default), repair or off\n"
+              << "  --grid TYPE:RANGES   Sweep a parameter grid, e.g. sma:5..50/5,50..200/25\n"
+              << "                       (repeatable; types: sma, rsi, bb, ensemble)\n"
+              << "  --workers N          Worker processes for sweeps (default: CPU count)\n"
+              << "  --shard-size N       Parameter sets per shard (default: auto)\n"
+              << "  --retries N          Retries for a shard whose worker dies (default: 2)\n"
+              << "  --record-golden DIR  Record reference outputs and ns/bar budgets\n"
+              << "  --verify-golden DIR  Compare against recorded outputs and budgets\n"
+              << "  --tolerance X        Relative tolerance for golden comparisons (default: 1e-9)\n"
+              << "  --compressed         Backtest the default strategies (or --grid) from a compressed\n"
+              << "                       copy of the bars, freeing the uncompressed ones first\n"
+              << "  --stress MODELS      Backtest the default strategies (or --grid) on synthetic paths:\n"
+              << "                       gbm, garch, regime, bootstrap, or all (comma-separated)\n"
+              << "  --paths N            Synthetic paths per model (default: 1000)\n"
+              << "  --seed N             Seed of the first path (default: 42)\n"
+              << "  --block N            Mean bootstrap block length in bars (default: 20)\n"
+              << "  --threads N          Threads for --stress (default: one per hardware thread)\n"
+              << "  --mem-report FILE    Report heap use per component, peak RSS and startup\n"
+              << "                       milestones at exit, and write them to FILE as JSON\n"
+              << "  --paper SOURCE       Paper-trade the default strategies (or --grid) on live bars:\n"
+              << "                       replay (serve the data file over loopback TCP),\n"
+              << "                       tcp:HOST:PORT, or a CSV file to follow as it grows\n"
+              << "  --replay-serve PORT  Act as a stand-in exchange serving the data file on PORT\n"
+              << "  --rate N             Bars per second for replays (default: unthrottled)\n"
+              << "  --pin CPUS           Pin paper-trading threads to CPUs, e.g. 2,3,4 or 2-4\n"
+              << "  --slippage-bps X     Paper broker slippage (default: 0)\n"
+              << "  --fee-bps X          Paper broker fee per side (default: 0)\n";
+}
+
+// Prints and writes the memory report however main() returns
+struct MemoryReport {
+    std::string path;
+    
+    ~MemoryReport() {
+        if (path.empty()) {
+            return;
+        }
+        crypto::utils::markMilestone("finished");
+        crypto::utils::printMemoryReport(std::cout);
+        if (crypto::utils::writeMemoryReport(path)) {
+            std::cout << "Memory report written to " << path << std::endl;
+        }
+    }
+};
+
+// Serve `dataPath` as the stand-in exchange on `port`
+bool serveReplay(const std::string& dataPath, int port, double rate) {
+    crypto::data::DataLoader loader(dataPath);
+    if (!loader.loadData()) {
+        return false;
+    }
+    crypto::live::ReplayServer server(loader.getData(), rate);
+    if (!server.listen(port)) {
+        return false;
+    }
+    std::cout << "Serving " << loader.getData().size() << " bars on 127.0.0.1:" << server.getPort() << std::endl;
+    return server.serve();
+}
+
+// Compress the loaded bars, release them, and backtest from the compressed copy
+bool runCompressed(const std::string& dataPath, const crypto::data::ValidationConfig& validation,
+                   const std::vector<crypto::strategies::StrategySpec>& specs) {
+    crypto::data::CompressedBars bars;
+    {
+        crypto::data::DataLoader loader(dataPath);
+        loader.setValidation(validation);
+        if (!loader.loadData()) {
+            return false;
+        }
+        bars = crypto::data::CompressedBars::compress(loader.getData());
+    }
+    std::cout << "Compressed " << bars.size() << " bars from " << bars.rawBytes() / 1024 << " KB to "
+              << bars.bytes() / 1024 << " KB (" << static_cast<double>(bars.rawBytes()) / bars.bytes() << "x)\n\n";
+
+    auto defaults = crypto::backtester::defaultRunSpec(dataPath);
+    std::vector<std::shared_ptr<crypto::strategies::Strategy>> strategies;
+    for (const auto& spec : specs) {
+        strategies.push_back(crypto::strategies::createStrategy(spec));
+        strategies.back()->setPositionConfig(defaults.position);
+    }
+    auto results = crypto::backtester::backtestCompressed(strategies, bars, defaults.initialCapital, defaults.positionSize);
+    for (size_t s = 0; s < strategies.size(); ++s) {
+        const auto& metrics = results[s].metrics;
+        std::cout << strategies[s]->getName() << ": return " << metrics.totalReturn << "%, Sharpe "
+                  << metrics.sharpeRatio << ", max drawdown " << metrics.maxDrawdown << "%, "
+                  << metrics.totalTrades << " trades, final equity $" << results[s].finalEquity << "\n";
+    }
+    return true;
+}
+
+// Distributions of each strategy's metrics over synthetic paths
+bool runStress(const std::string& dataPath, const crypto::data::ValidationConfig& validation,
+               const std::vector<crypto::strategies::StrategySpec>& specs, crypto::backtester::StressOptions options) {
+    crypto::data::DataLoader loader(dataPath);
+    loader.setValidation(validation);
+    if (!loader.loadData()) {
+        return false;
+    }
+
+    auto defaults = crypto::backtester::defaultRunSpec(dataPath);
+    options.initialCapital = defaults.initialCapital;
+    options.positionSize = defaults.positionSize;
+    options.position = defaults.position;
+
+    crypto::backtester::StressTester tester(loader.getData(), options);
+    tester.run(specs);
+    tester.printSummary(std::cout);
+    return tester.exportResults(".");
+}
+
+bool runPaper(const std::string& source, const std::string& dataPath, double rate,
+              const std::vector<crypto::strategies::StrategySpec>& specs, const crypto::live::PaperConfig& config) {
+    std::vector<std::shared_ptr<crypto::strategies::Strategy>> strategies;
+    for (const auto& spec : specs) {
+        strategies.push_back(crypto::strategies::createStrategy(spec));
+    }
+    crypto::live::PaperTrader trader(config, strategies);
+
+    bool ok = false;
+    if (source == "replay") {
+        // Exchange and trader in one process, still talking over a socket
+        crypto::data::DataLoader loader(dataPath);
+        if (!loader.loadData()) {
+            return false;
+        }
+        crypto::live::ReplayServer server(loader.getData(), rate);
+        if (!server.listen(0)) {
+            return false;
+        }
+        std::thread exchange([&server] { server.serve(); });
+        crypto::live::SocketFeed feed("127.0.0.1", server.getPort());
+        ok = feed.connect() && trader.run(feed);
+        exchange.join();
+    } else if (source.rfind("tcp:", 0) == 0) {
+        size_t colon = source.rfind(':');
+        crypto::live::SocketFeed feed(source.substr(4, colon - 4), std::stoi(source.substr(colon + 1)));
+        ok = feed.connect() && trader.run(feed);
+    } else {
+        crypto::live::TailFeed feed(source);
+        ok = feed.open() && trader.run(feed);
+    }
+
+    if (ok) {
+        trader.printReport();
+    }
+    return ok;
+}
+
+} // namespace
 
 int main(int argc, char* argv[]) {
     std::cout << "===== Cryptocurrency Trading Strategy Backtester =====\n\n";
     
-    // Get data path
+    // Parse command line
     std::string dataPath = "data/btc_historical.csv";
-    if (argc > 1) {
-        dataPath = argv[1];
+    std::vector<crypto::strategies::StrategySpec> grid;
+    crypto::backtester::SweepOptions sweepOptions;
+    crypto::backtester::GoldenOptions goldenOptions;
+    std::string goldenMode;
+    std::string specPath;
+    std::string indicatorCache;
+    std::string outlierMode;
+    std::string paperSource;
+    bool compressed = false;
+    int replayPort = -1;
+    double replayRate = 0.0;
+    crypto::live::PaperConfig paperConfig;
+    std::string stressModels;
+    crypto::backtester::StressOptions stressOptions;
+    MemoryReport memoryReport;
+    sweepOptions.workers = std::max(1u, std::thread::hardware_concurrency());
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--spec" && hasValue) {
+            specPath = argv[++i];
+        } else if (arg == "--indicator-cache" && hasValue) {
+            indicatorCache = argv[++i];
+        } else if (arg == "--outliers" && hasValue) {
+            outlierMode = argv[++i];
+        } else if (arg == "--grid" && hasValue) {
+            if (!crypto::strategies::parseGrid(argv[++i], grid)) {
+                return 1;
+            }
+        } else if (arg == "--workers" && hasValue) {
+            sweepOptions.workers = std::stoi(argv[++i]);
+        } else if (arg == "--shard-size" && hasValue) {
+            sweepOptions.shardSize = std::stoul(argv[++i]);
+        } else if (arg == "--retries" && hasValue) {
+            sweepOptions.maxRetries = std::stoi(argv[++i]);
+        } else if ((arg == "--record-golden" || arg == "--verify-golden") && hasValue) {
+            goldenMode = arg;
+            goldenOptions.goldenDir = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            goldenOptions.tolerance = std::stod(argv[++i]);
+        } else if (arg == "--compressed") {
+            compressed = true;
+        } else if (arg == "--stress" && hasValue) {
+            stressModels = argv[++i];
+        } else if (arg == "--paths" && hasValue) {
+            stressOptions.paths = std::stoul(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            stressOptions.seed = std::stoull(argv[++i]);
+        } else if (arg == "--block" && hasValue) {
+            stressOptions.blockSize = std::stod(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            stressOptions.threads = std::stoul(argv[++i]);
+        } else if (arg == "--mem-report" && hasValue) {
+            memoryReport.path = argv[++i];
+            crypto::utils::enableMemoryAccounting();
+        } else if (arg == "--paper" && hasValue) {
+            paperSource = argv[++i];
+        } else if (arg == "--replay-serve" && hasValue) {
+            replayPort = std::stoi(argv[++i]);
+        } else if (arg == "--rate" && hasValue) {
+            replayRate = std::stod(argv[++i]);
+        } else if (arg == "--pin" && hasValue) {
+            if (!crypto::utils::parseCpuList(argv[++i], paperConfig.cpus)) {
+                std::cerr << "Invalid CPU list: " << argv[i] << std::endl;
+                return 1;
+            }
+        } else if (arg == "--slippage-bps" && hasValue) {
+            paperConfig.slippageBps = std::stod(argv[++i]);
+        } else if (arg == "--fee-bps" && hasValue) {
+            paperConfig.feeBps = std::stod(argv[++i]);
+        } else if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            dataPath = arg;
+        }
+    }
+    
+    crypto::data::ValidationConfig validation;
+    if (!outlierMode.empty() && !crypto::data::parseOutlierAction(outlierMode, validation.outliers)) {
+        std::cerr << "Invalid outlier mode: " << outlierMode << std::endl;
+        return 1;
+    }
+    
+    if (!stressModels.empty()) {
+        std::stringstream names(stressModels == "all" ? "gbm,garch,regime,bootstrap" : stressModels);
+        std::string name;
+        while (std::getline(names, name, ',')) {
+            crypto::data::PathModel model;
+            if (!crypto::data::parsePathModel(name, model)) {
+                std::cerr << "Invalid stress model: " << name << std::endl;
+                return 1;
+            }
+            stressOptions.models.push_back(model);
+        }
+    }
+    
+    // Declarative run: datasets, strategies and outputs come from the spec
+    if (!specPath.empty()) {
+        crypto::backtester::RunSpec spec;
+        if (!crypto::backtester::loadRunSpec(specPath, spec)) {
+            return 1;
+        }
+        if (!indicatorCache.empty()) {
+            spec.indicatorCache = indicatorCache;
+        }
+        if (!outlierMode.empty()) {
+            spec.validation.outliers = validation.outliers;
+        }
+        crypto::backtester::RunEngine engine(spec);
+        return engine.run() ? 0 : 1;
+    }
+    
+    // Live paper trading from a socket or a growing file needs no data file
+    if (!paperSource.empty() && paperSource != "replay") {
+        auto specs = grid.empty() ? crypto::backtester::defaultRunSpec(dataPath).strategies : grid;
+        return runPaper(paperSource, dataPath, replayRate, specs, paperConfig) ? 0 : 1;
     }
     
     // Check if data file exists
@@ -23,29 +311,56 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    // Initialize backtester
-    crypto::backtester::Backtester backtester(dataPath);
+    // Stand-in exchange for another process's --paper tcp:HOST:PORT
+    if (replayPort >= 0) {
+        return serveReplay(dataPath, replayPort, replayRate) ? 0 : 1;
+    }
     
-    // Create strategies
-    auto smaStrategy1 = std::make_shared<crypto::strategies::SMAStrategy>(20, 50);
-    auto smaStrategy2 = std::make_shared<crypto::strategies::SMAStrategy>(50, 200);
-    auto rsiStrategy = std::make_shared<crypto::strategies::RSIStrategy>(14, 30, 70);
-    auto bbStrategy = std::make_shared<crypto::strategies::BollingerBandsStrategy>(20, 2.0);
+    if (paperSource == "replay") {
+        auto specs = grid.empty() ? crypto::backtester::defaultRunSpec(dataPath).strategies : grid;
+        return runPaper(paperSource, dataPath, replayRate, specs, paperConfig) ? 0 : 1;
+    }
+    
+    // Golden-result regression harness
+    if (!goldenMode.empty()) {
+        goldenOptions.dataPath = dataPath;
+        bool ok = goldenMode == "--record-golden" ? crypto::backtester::recordGolden(goldenOptions)
+                                                  : crypto::backtester::verifyGolden(goldenOptions);
+        return ok ? 0 : 1;
+    }
     
-    // Add strategies to backtester
-    backtester.addStrategy(smaStrategy1);
-    backtester.addStrategy(smaStrategy2);
-    backtester.addStrategy(rsiStrategy);
-    backtester.addStrategy(bbStrategy);
+    if (!stressOptions.models.empty()) {
+        auto specs = grid.empty() ? crypto::backtester::defaultRunSpec(dataPath).strategies : grid;
+        return runStress(dataPath, validation, specs, stressOptions) ? 0 : 1;
+    }
     
-    // Run backtest
-    backtester.run(10000.0, 0.95);  // Initial capital of $10,000, invest 95% of capital per trade
+    if (compressed) {
+        auto specs = grid.empty() ? crypto::backtester::defaultRunSpec(dataPath).strategies : grid;
+        return runCompressed(dataPath, validation, specs) ? 0 : 1;
+    }
     
-    // Compare strategies
-    backtester.compareStrategies();
+    // Parameter sweep mode
+    if (!grid.empty()) {
+        crypto::backtester::Backtester backtester(dataPath, validation);
+        if (!backtester.isLoaded()) {
+            return 1;
+        }
+        backtester.setIndicatorCache(indicatorCache);
+        sweepOptions.initialCapital = 10000.0;
+        sweepOptions.positionSize = 0.95;
+        auto results = backtester.runSweep(grid, sweepOptions);
+        backtester.exportSweepResults(results, ".");
+        return results.size() == grid.size() ? 0 : 1;
+    }
     
-    // Export results for visualization
-    backtester.exportResults(".");
+    // Default experiment, equivalent to configs/default.json
+    auto spec = crypto::backtester::defaultRunSpec(dataPath);
+    spec.indicatorCache = indicatorCache;
+    spec.validation = validation;
+    crypto::backtester::RunEngine engine(spec);
+    if (!engine.run()) {
+        return 1;
+    }
     
     std::cout << "\nBacktest complete. Results have been exported.\n";
     std::cout << "To visualize the results, run the visualize_results.py script.\n";
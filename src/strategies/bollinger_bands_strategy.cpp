@@ -4,44 +4,96 @@
 namespace crypto {
 namespace strategies {
 
+namespace {
+
+// Same band crossings as generateSignals, on a close index grown bar by bar
+class BandCrossStream : public SignalStream {
+public:
+    BandCrossStream(int period, double stdDev)
+        : m_period(period), m_stdDev(stdDev), m_prevClose(0.0), m_prevLower(0.0), m_prevUpper(0.0) {}
+
+    Signal update(const data::OHLCV& bar) override {
+        m_closes.append(bar.close);
+        size_t i = m_closes.size() - 1;
+        double lower = 0.0;
+        double upper = 0.0;
+        if (m_closes.hasWindow(m_period, i)) {
+            double mean = m_closes.windowMean(m_period, i);
+            double deviation = m_closes.windowStdDev(m_period, i);
+            lower = mean - m_stdDev * deviation;
+            upper = mean + m_stdDev * deviation;
+        }
+
+        Signal signal = HOLD;
+        if (i >= 1 && i >= static_cast<size_t>(m_period)) {
+            if (bar.close > lower && m_prevClose <= m_prevLower) {
+                signal = BUY;
+            } else if (bar.close < upper && m_prevClose >= m_prevUpper) {
+                signal = SELL;
+            }
+        }
+        m_prevClose = bar.close;
+        m_prevLower = lower;
+        m_prevUpper = upper;
+        return signal;
+    }
+
+private:
+    int m_period;
+    double m_stdDev;
+    data::PrefixSumIndex m_closes;
+    double m_prevClose;
+    double m_prevLower;
+    double m_prevUpper;
+};
+
+} // namespace
+
 BollingerBandsStrategy::BollingerBandsStrategy(int period, double stdDev) 
     : Strategy("Bollinger Bands " + std::to_string(period) + " (" + std::to_string(stdDev) + ")"),
       m_period(period), m_stdDev(stdDev) {}
 
-std::vector<Signal> BollingerBandsStrategy::generateSignals(const data::DataLoader& data) {
+SignalEvents BollingerBandsStrategy::generateSignals(const data::DataLoader& data) {
     const auto& priceData = data.getData();
-    std::vector<Signal> signals(priceData.size(), HOLD);
-    
-    // Get Bollinger Bands
-    std::vector<double> upperBand = data.getBollingerUpper(m_period);
-    std::vector<double> lowerBand = data.getBollingerLower(m_period);
+    SignalEvents signals(priceData.size());
     
-    // Check if indicators are available
-    if (upperBand.empty() || lowerBand.empty()) {
-        std::cerr << "Error: Bollinger Band indicators not available for " << m_name 
-                  << ". Make sure they were calculated." << std::endl;
+    // Bands come straight from the close prefix-sum index, so any band
+    // width works without a materialised (period-keyed) band vector
+    if (data.getCloseIndex().size() != priceData.size()) {
+        std::cerr << "Error: Close price index not available for " << m_name << "." << std::endl;
         return signals;
     }
     
-    // Generate signals based on price touching bands
-    for (size_t i = 1; i < priceData.size(); ++i) {
-        // Skip if not enough data for indicators
-        if (i < static_cast<size_t>(m_period)) {
-            continue;
-        }
+    // Generate signals based on price touching bands, from the first bar
+    // whose previous bar has a full window, so no bar needs a warmup check
+    size_t start = data.commonValidStart({{data::IndicatorKind::BollingerBands, m_period, m_stdDev}});
+    for (size_t i = start + 1; i < priceData.size(); ++i) {
+        double lower = data.getBollingerLowerAt(m_period, m_stdDev, i);
+        double prevLower = data.getBollingerLowerAt(m_period, m_stdDev, i - 1);
+        double upper = data.getBollingerUpperAt(m_period, m_stdDev, i);
+        double prevUpper = data.getBollingerUpperAt(m_period, m_stdDev, i - 1);
         
         // Buy signal: price crosses above lower band
-        if (priceData[i].close > lowerBand[i] && priceData[i-1].close <= lowerBand[i-1]) {
-            signals[i] = BUY;
+        if (priceData[i].close > lower && priceData[i-1].close <= prevLower) {
+            signals.add(i, BUY);
         }
         // Sell signal: price crosses below upper band
-        else if (priceData[i].close < upperBand[i] && priceData[i-1].close >= upperBand[i-1]) {
-            signals[i] = SELL;
+        else if (priceData[i].close < upper && priceData[i-1].close >= prevUpper) {
+            signals.add(i, SELL);
         }
     }
     
     return signals;
 }
 
+std::vector<data::IndicatorRequest> BollingerBandsStrategy::requiredIndicators() const {
+    // Bands are read from the close prefix-sum index, nothing to materialise
+    return {};
+}
+
+std::unique_ptr<SignalStream> BollingerBandsStrategy::createSignalStream() const {
+    return std::make_unique<BandCrossStream>(m_period, m_stdDev);
+}
+
 } // namespace strategies
 } // namespace crypto
\ No newline at end of file
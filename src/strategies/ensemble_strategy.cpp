@@ -0,0 +1,223 @@
+#include "strategies/ensemble_strategy.h"
+#include <algorithm>
+#include <set>
+
+namespace crypto {
+namespace strategies {
+
+namespace {
+
+// The mask operators applied to one bar: every node sees every bar, leaves
+// run their strategy's stream and within nodes remember the last signal bars
+class EnsembleStream : public SignalStream {
+public:
+    // Nodes point into the stream's own copy of the expression
+    explicit EnsembleStream(const SignalExpr& expression) : m_expression(expression), m_index(0) {
+        build(m_root, m_expression);
+    }
+
+    Signal update(const data::OHLCV& bar) override {
+        Bits bits = evaluate(m_root, bar);
+        ++m_index;
+        if (bits.buy == bits.sell) {
+            return HOLD;    // Neither, or conflicting
+        }
+        return bits.buy ? BUY : SELL;
+    }
+
+private:
+    struct Bits {
+        bool buy;
+        bool sell;
+    };
+
+    struct Node {
+        const SignalExpr* expr = nullptr;
+        std::unique_ptr<SignalStream> leaf;
+        long lastBuy = -1;
+        long lastSell = -1;
+        std::vector<Node> children;
+    };
+
+    void build(Node& node, const SignalExpr& expr) {
+        node.expr = &expr;
+        if (expr.op == SignalExpr::Op::Leaf) {
+            auto strategy = createStrategy(expr.spec);
+            if (strategy) {
+                node.leaf = strategy->createSignalStream();
+            }
+        }
+        node.children.resize(expr.children.size());
+        for (size_t c = 0; c < expr.children.size(); ++c) {
+            build(node.children[c], expr.children[c]);
+        }
+    }
+
+    Bits evaluate(Node& node, const data::OHLCV& bar) {
+        std::vector<Bits> children;
+        children.reserve(node.children.size());
+        for (auto& child : node.children) {
+            children.push_back(evaluate(child, bar));
+        }
+
+        const SignalExpr& expr = *node.expr;
+        switch (expr.op) {
+            case SignalExpr::Op::Leaf: {
+                Signal signal = node.leaf ? node.leaf->update(bar) : HOLD;
+                return {signal == BUY, signal == SELL};
+            }
+            case SignalExpr::Op::And:
+            case SignalExpr::Op::Or: {
+                bool isAnd = expr.op == SignalExpr::Op::And;
+                Bits bits = children[0];
+                for (size_t c = 1; c < children.size(); ++c) {
+                    if (isAnd) {
+                        bits = {bits.buy && children[c].buy, bits.sell && children[c].sell};
+                    } else {
+                        bool buy = bits.buy || children[c].buy;
+                        bool sell = bits.sell || children[c].sell;
+                        bits = {buy && !sell, sell && !buy};
+                    }
+                }
+                return bits;
+            }
+            case SignalExpr::Op::Not:
+                return {children[0].sell, children[0].buy};
+            case SignalExpr::Op::Within: {
+                long index = static_cast<long>(m_index);
+                if (children[0].buy) node.lastBuy = index;
+                if (children[0].sell) node.lastSell = index;
+                return {node.lastBuy >= 0 && index - node.lastBuy <= expr.window,
+                        node.lastSell >= 0 && index - node.lastSell <= expr.window};
+            }
+            case SignalExpr::Op::Vote: {
+                long buyVotes = 0;
+                long sellVotes = 0;
+                for (size_t c = 0; c < children.size(); ++c) {
+                    int weight = c < expr.weights.size() ? std::max(0, expr.weights[c]) : 1;
+                    buyVotes += children[c].buy ? weight : 0;
+                    sellVotes += children[c].sell ? weight : 0;
+                }
+                bool buy = buyVotes >= expr.threshold;
+                bool sell = sellVotes >= expr.threshold;
+                return {buy && !sell, sell && !buy};
+            }
+        }
+        return {false, false};
+    }
+
+    SignalExpr m_expression;
+    Node m_root;
+    size_t m_index;
+};
+
+} // namespace
+
+// SignalCache
+
+std::shared_ptr<const SignalMask> SignalCache::get(const StrategySpec& spec, const data::DataLoader& data) {
+    std::string key = formatSpec(spec);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_masks.find(key);
+        if (it != m_masks.end()) {
+            ++m_hits;
+            return it->second;
+        }
+    }
+
+    // Generate outside the lock; if two threads race, the first insert wins
+    std::shared_ptr<const SignalMask> mask;
+    auto strategy = createStrategy(spec);
+    if (strategy) {
+        strategy->setVerbose(false);
+        mask = std::make_shared<const SignalMask>(SignalMask::fromEvents(strategy->generateSignals(data)));
+    } else {
+        mask = std::make_shared<const SignalMask>(data.getData().size());
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_misses;
+    return m_masks.emplace(key, mask).first->second;
+}
+
+size_t SignalCache::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_masks.size();
+}
+
+size_t SignalCache::getHits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t SignalCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+// EnsembleStrategy
+
+EnsembleStrategy::EnsembleStrategy(const SignalExpr& expression, std::shared_ptr<SignalCache> cache)
+    : Strategy("Ensemble " + expression.toString()),
+      m_expression(expression), m_cache(cache ? cache : std::make_shared<SignalCache>()) {}
+
+SignalEvents EnsembleStrategy::generateSignals(const data::DataLoader& data) {
+    return evaluate(m_expression, data).toEvents();
+}
+
+SignalMask EnsembleStrategy::evaluate(const SignalExpr& node, const data::DataLoader& data) {
+    switch (node.op) {
+        case SignalExpr::Op::Leaf:
+            return *m_cache->get(node.spec, data);
+        case SignalExpr::Op::And:
+        case SignalExpr::Op::Or: {
+            SignalMask result = evaluate(node.children[0], data);
+            for (size_t c = 1; c < node.children.size(); ++c) {
+                SignalMask next = evaluate(node.children[c], data);
+                result = node.op == SignalExpr::Op::And ? maskAnd(result, next) : maskOr(result, next);
+            }
+            return result;
+        }
+        case SignalExpr::Op::Not:
+            return maskNot(evaluate(node.children[0], data));
+        case SignalExpr::Op::Within:
+            return maskWithin(evaluate(node.children[0], data), node.window);
+        case SignalExpr::Op::Vote: {
+            std::vector<SignalMask> masks;
+            masks.reserve(node.children.size());
+            for (const auto& child : node.children) {
+                masks.push_back(evaluate(child, data));
+            }
+            std::vector<const SignalMask*> pointers;
+            for (const auto& mask : masks) {
+                pointers.push_back(&mask);
+            }
+            return maskVote(pointers, node.weights, node.threshold);
+        }
+    }
+    return SignalMask(data.getData().size());
+}
+
+std::unique_ptr<SignalStream> EnsembleStrategy::createSignalStream() const {
+    return std::make_unique<EnsembleStream>(m_expression);
+}
+
+std::vector<data::IndicatorRequest> EnsembleStrategy::requiredIndicators() const {
+    std::vector<StrategySpec> leaves;
+    m_expression.collectLeaves(leaves);
+
+    std::set<data::IndicatorRequest> unique;
+    for (const auto& leaf : leaves) {
+        auto strategy = createStrategy(leaf);
+        if (strategy) {
+            for (const auto& request : strategy->requiredIndicators()) {
+                unique.insert(request);
+            }
+        }
+    }
+    return std::vector<data::IndicatorRequest>(unique.begin(), unique.end());
+}
+
+} // namespace strategies
+} // namespace crypto
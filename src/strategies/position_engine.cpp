@@ -0,0 +1,221 @@
+#include "strategies/position_engine.h"
+#include <algorithm>
+#include <cmath>
+
+namespace crypto {
+namespace strategies {
+
+PositionEngine::PositionEngine(const PositionConfig& config, double initialCapital, double positionSize)
+    : m_config(config), m_initialCapital(initialCapital), m_positionSize(positionSize),
+      m_cash(initialCapital), m_held(0.0), m_costBasis(0.0), m_entries(0),
+      m_firstEntryIndex(0), m_firstEntryPrice(0.0),
+      m_wins(0), m_winSum(0.0), m_lossSum(0.0), m_prevClose(0.0), m_buys(0), m_sells(0) {
+    m_config.maxEntries = std::max(1, m_config.maxEntries);
+}
+
+void PositionEngine::run(const std::vector<double>& closes, const SignalEvents& signals) {
+    size_t n = std::min(closes.size(), signals.length());
+
+    reset();
+    // Every bar is written exactly once below, by the segment fills
+    m_units.resize(n);
+    m_cashCurve.resize(n);
+    if (n > 0) {
+        m_units[0] = 0.0;
+        m_cashCurve[0] = m_initialCapital;
+    }
+
+    if (m_config.sizing == SizingRule::VolatilityTarget) {
+        std::vector<double> returns(n, 0.0);
+        for (size_t i = 1; i < n; ++i) {
+            if (closes[i] > 0.0 && closes[i-1] > 0.0) {
+                returns[i] = std::log(closes[i] / closes[i-1]);
+            }
+        }
+        m_returns.build(returns);
+    }
+
+    size_t last = 0;   // Units and cash are final up to and including `last`
+    for (size_t e = 0; e < signals.count(); ++e) {
+        size_t i = signals.indexAt(e);
+        if (i == 0) {
+            continue;
+        }
+        if (i >= n) {
+            break;
+        }
+
+        // Carry the position over the quiet bars since the last event
+        std::fill(m_units.begin() + last + 1, m_units.begin() + i, m_held);
+        std::fill(m_cashCurve.begin() + last + 1, m_cashCurve.begin() + i, m_cash);
+
+        act(i, closes[i], signals.signalAt(e));
+        m_units[i] = m_held;
+        m_cashCurve[i] = m_cash;
+        last = i;
+    }
+
+    if (n > 0) {
+        std::fill(m_units.begin() + last + 1, m_units.end(), m_held);
+        std::fill(m_cashCurve.begin() + last + 1, m_cashCurve.end(), m_cash);
+    }
+}
+
+void PositionEngine::reset() {
+    m_cash = m_initialCapital;
+    m_held = 0.0;
+    m_costBasis = 0.0;
+    m_entries = 0;
+    m_wins = 0;
+    m_winSum = 0.0;
+    m_lossSum = 0.0;
+    m_buys = 0;
+    m_sells = 0;
+    m_prevClose = 0.0;
+    m_trades.clear();
+    m_units.clear();
+    m_cashCurve.clear();
+    m_returns = data::PrefixSumIndex();
+}
+
+void PositionEngine::step(size_t index, double close, Signal signal) {
+    if (m_config.sizing == SizingRule::VolatilityTarget) {
+        // Appending gives the same prefixes run() builds over the whole series
+        double logReturn = 0.0;
+        if (index > 0 && close > 0.0 && m_prevClose > 0.0) {
+            logReturn = std::log(close / m_prevClose);
+        }
+        m_returns.append(logReturn);
+        m_prevClose = close;
+    }
+    if (index > 0 && signal != HOLD) {
+        act(index, close, signal);
+    }
+}
+
+void PositionEngine::act(size_t index, double price, Signal signal) {
+    int direction = signal == BUY ? 1 : -1;
+    int current = m_held > 0.0 ? 1 : (m_held < 0.0 ? -1 : 0);
+
+    // A signal counts once whether it exits, enters or reverses
+    bool acted = false;
+    if (current == -direction) {
+        close(index, price);
+        acted = true;
+        if (m_config.mode == PositionMode::LongShort) {
+            open(direction, index, price);
+        }
+    } else if (direction == 1 || m_config.mode == PositionMode::LongShort) {
+        if (m_entries < m_config.maxEntries) {
+            acted = open(direction, index, price);
+        }
+    }
+    if (acted) {
+        if (direction == 1) m_buys++; else m_sells++;
+    }
+}
+
+void PositionEngine::markToMarket(const std::vector<double>& closes, std::vector<double>& equity) const {
+    size_t n = m_units.size();
+    equity.resize(n);
+
+    const double* cash = m_cashCurve.data();
+    const double* units = m_units.data();
+    const double* close = closes.data();
+    double* out = equity.data();
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = cash[i] + units[i] * close[i];
+    }
+}
+
+bool PositionEngine::open(int direction, size_t index, double price) {
+    double equity = m_cash + m_held * price;
+    if (equity <= 0.0 || price <= 0.0) {
+        return false;
+    }
+
+    // Each entry gets an equal share of the sized position
+    double amount = equity * m_positionSize * sizingScale(index) / m_config.maxEntries;
+    double room = m_config.leverage * equity - std::fabs(m_held) * price;
+    amount = std::min(amount, room);
+    if (!(amount > 0.0)) {
+        return false;
+    }
+
+    double units = direction * (amount / price);
+    m_cash -= direction * amount;
+    m_costBasis += units * price;
+    m_held += units;
+
+    if (m_entries == 0) {
+        m_firstEntryIndex = index;
+        m_firstEntryPrice = price;
+    }
+    m_entries++;
+    return true;
+}
+
+void PositionEngine::close(size_t index, double price) {
+    double value = m_held * price;
+    m_cash += value;
+
+    Trade trade;
+    trade.direction = m_held > 0.0 ? 1 : -1;
+    trade.entryIndex = m_firstEntryIndex;
+    trade.exitIndex = index;
+    trade.entryPrice = m_entries == 1 ? m_firstEntryPrice : m_costBasis / m_held;
+    trade.exitPrice = price;
+    trade.profit = value - m_costBasis;
+    trade.profitPercent = trade.direction * (trade.exitPrice / trade.entryPrice - 1.0) * 100.0;
+    m_trades.push_back(trade);
+
+    if (trade.profitPercent > 0.0) {
+        m_wins++;
+        m_winSum += trade.profitPercent;
+    } else {
+        m_lossSum -= trade.profitPercent;
+    }
+
+    m_held = 0.0;
+    m_costBasis = 0.0;
+    m_entries = 0;
+}
+
+double PositionEngine::sizingScale(size_t index) const {
+    switch (m_config.sizing) {
+        case SizingRule::VolatilityTarget: {
+            if (!m_returns.hasWindow(m_config.volatilityWindow, index)) {
+                return 1.0;
+            }
+            double realised = m_returns.windowStdDev(m_config.volatilityWindow, index) * std::sqrt(m_config.periodsPerYear);
+            if (realised <= 0.0) {
+                return m_config.leverage;
+            }
+            return std::min(m_config.targetVolatility / realised, m_config.leverage);
+        }
+        case SizingRule::Kelly: {
+            int closed = static_cast<int>(m_trades.size());
+            if (closed < std::max(1, m_config.kellyMinTrades)) {
+                return 1.0;
+            }
+            int losses = closed - m_wins;
+            if (m_wins == 0) {
+                return 0.0;
+            }
+            if (losses == 0 || m_lossSum <= 0.0) {
+                return m_config.kellyFraction;
+            }
+            // f* = p - q / b with b the average win over the average loss
+            double p = static_cast<double>(m_wins) / closed;
+            double b = (m_winSum / m_wins) / (m_lossSum / losses);
+            double kelly = std::clamp(p - (1.0 - p) / b, 0.0, 1.0);
+            return m_config.kellyFraction * kelly;
+        }
+        case SizingRule::Fixed:
+        default:
+            return 1.0;
+    }
+}
+
+} // namespace strategies
+} // namespace crypto
@@ -4,43 +4,110 @@
 namespace crypto {
 namespace strategies {
 
+namespace {
+
+// DataLoader::addRSI's recurrence one bar at a time (simple-average seed,
+// then Wilder smoothing), followed by generateSignals' level crossings
+class RSICrossStream : public SignalStream {
+public:
+    RSICrossStream(int period, double oversold, double overbought)
+        : m_period(period), m_oversold(oversold), m_overbought(overbought),
+          m_index(0), m_prevClose(0.0), m_avgGain(0.0), m_avgLoss(0.0), m_prevRSI(0.0) {}
+
+    Signal update(const data::OHLCV& bar) override {
+        size_t i = m_index++;
+        double rsi = 0.0;
+        if (i > 0) {
+            double change = bar.close - m_prevClose;
+            double gain = change > 0 ? change : 0.0;
+            double loss = change > 0 ? 0.0 : -change;
+            size_t period = static_cast<size_t>(m_period);
+
+            if (i <= period) {
+                m_avgGain += gain;
+                m_avgLoss += loss;
+            } else {
+                m_avgGain = (m_avgGain * (m_period - 1) + gain) / m_period;
+                m_avgLoss = (m_avgLoss * (m_period - 1) + loss) / m_period;
+            }
+            if (i == period) {
+                m_avgGain /= m_period;
+                m_avgLoss /= m_period;
+            }
+            if (i >= period) {
+                double rs = (m_avgLoss == 0) ? 100.0 : m_avgGain / m_avgLoss;
+                rsi = 100.0 - (100.0 / (1.0 + rs));
+            }
+        }
+        m_prevClose = bar.close;
+
+        Signal signal = HOLD;
+        if (i >= static_cast<size_t>(m_period + 1)) {
+            if (rsi > m_oversold && m_prevRSI <= m_oversold) {
+                signal = BUY;
+            } else if (rsi < m_overbought && m_prevRSI >= m_overbought) {
+                signal = SELL;
+            }
+        }
+        m_prevRSI = rsi;
+        return signal;
+    }
+
+private:
+    int m_period;
+    double m_oversold;
+    double m_overbought;
+    size_t m_index;
+    double m_prevClose;
+    double m_avgGain;
+    double m_avgLoss;
+    double m_prevRSI;
+};
+
+} // namespace
+
 RSIStrategy::RSIStrategy(int period, double oversold, double overbought) 
     : Strategy("RSI " + std::to_string(period) + " (" + std::to_string(static_cast<int>(oversold)) + 
                 "/" + std::to_string(static_cast<int>(overbought)) + ")"),
       m_period(period), m_oversold(oversold), m_overbought(overbought) {}
 
-std::vector<Signal> RSIStrategy::generateSignals(const data::DataLoader& data) {
+SignalEvents RSIStrategy::generateSignals(const data::DataLoader& data) {
     const auto& priceData = data.getData();
-    std::vector<Signal> signals(priceData.size(), HOLD);
+    SignalEvents signals(priceData.size());
     
-    // Get RSI
-    std::vector<double> rsi = data.getRSI(m_period);
+    // Stored RSI, read in place
+    const std::vector<double>* series = data.findIndicator({data::IndicatorKind::RSI, m_period, 0.0});
     
     // Check if indicator is available
-    if (rsi.empty()) {
+    if (!series) {
         std::cerr << "Error: RSI indicator not available for " << m_name << ". Make sure it was calculated." << std::endl;
         return signals;
     }
+    const std::vector<double>& rsi = *series;
     
-    // Generate signals based on RSI levels
-    for (size_t i = 1; i < priceData.size(); ++i) {
-        // Skip if not enough data for indicator
-        if (i < static_cast<size_t>(m_period + 1)) {
-            continue;
-        }
-        
+    // Generate signals based on RSI levels, from the first bar whose previous
+    // bar has an RSI, so no bar needs a warmup check
+    for (size_t i = data.commonValidStart(requiredIndicators()) + 1; i < priceData.size(); ++i) {
         // Buy signal: RSI crosses above oversold level
         if (rsi[i] > m_oversold && rsi[i-1] <= m_oversold) {
-            signals[i] = BUY;
+            signals.add(i, BUY);
         }
         // Sell signal: RSI crosses below overbought level
         else if (rsi[i] < m_overbought && rsi[i-1] >= m_overbought) {
-            signals[i] = SELL;
+            signals.add(i, SELL);
         }
     }
     
     return signals;
 }
 
+std::vector<data::IndicatorRequest> RSIStrategy::requiredIndicators() const {
+    return {{data::IndicatorKind::RSI, m_period, 0.0}};
+}
+
+std::unique_ptr<SignalStream> RSIStrategy::createSignalStream() const {
+    return std::make_unique<RSICrossStream>(m_period, m_oversold, m_overbought);
+}
+
 } // namespace strategies
 } // namespace crypto
\ No newline at end of file
@@ -0,0 +1,467 @@
+#include "strategies/signal_algebra.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <sstream>
+
+namespace crypto {
+namespace strategies {
+
+namespace {
+
+constexpr size_t kMaxExpansions = 1000000;
+
+// Clear the bits past `length` in the last word so shifts never leak them
+void trimTail(std::vector<uint64_t>& bits, size_t length) {
+    size_t used = length % 64;
+    if (used != 0 && !bits.empty()) {
+        bits.back() &= (uint64_t(1) << used) - 1;
+    }
+}
+
+// Move every bit `shift` bars later
+std::vector<uint64_t> shiftLater(const std::vector<uint64_t>& bits, size_t shift) {
+    std::vector<uint64_t> out(bits.size(), 0);
+    size_t wordShift = shift / 64;
+    unsigned bitShift = static_cast<unsigned>(shift % 64);
+    for (size_t w = wordShift; w < bits.size(); ++w) {
+        uint64_t value = bits[w - wordShift] << bitShift;
+        if (bitShift != 0 && w > wordShift) {
+            value |= bits[w - wordShift - 1] >> (64 - bitShift);
+        }
+        out[w] = value;
+    }
+    return out;
+}
+
+// OR of the series shifted by 0..bars, with O(log bars) shifts by doubling
+void dilate(std::vector<uint64_t>& bits, size_t length, int bars) {
+    size_t covered = 1;
+    size_t target = static_cast<size_t>(bars) + 1;
+    while (covered < target) {
+        size_t shift = std::min(covered, target - covered);
+        std::vector<uint64_t> shifted = shiftLater(bits, shift);
+        for (size_t w = 0; w < bits.size(); ++w) {
+            bits[w] |= shifted[w];
+        }
+        covered += shift;
+    }
+    trimTail(bits, length);
+}
+
+// Bit-sliced >=: for each of 64 lanes, is the counter held in `planes`
+// (least significant first) at least `threshold`?
+uint64_t atLeast(const std::vector<uint64_t>& planes, int threshold) {
+    if (threshold <= 0) {
+        return ~uint64_t(0);
+    }
+    if (planes.size() < 31 && threshold >= (1 << planes.size())) {
+        return 0;
+    }
+
+    uint64_t greater = 0;
+    uint64_t equal = ~uint64_t(0);
+    for (size_t b = planes.size(); b-- > 0;) {
+        if ((threshold >> b) & 1) {
+            equal &= planes[b];
+        } else {
+            greater |= equal & planes[b];
+            equal &= ~planes[b];
+        }
+    }
+    return greater | equal;
+}
+
+// Ripple-carry add of a one-bit-per-lane value at bit position `plane`
+void addAt(std::vector<uint64_t>& planes, size_t plane, uint64_t value) {
+    for (size_t b = plane; b < planes.size() && value != 0; ++b) {
+        uint64_t carry = planes[b] & value;
+        planes[b] ^= value;
+        value = carry;
+    }
+}
+
+std::string formatNumber(double value) {
+    std::ostringstream out;
+    out.precision(12);
+    out << value;
+    return out.str();
+}
+
+// Parsed expression whose leaves may still hold several parameter sets
+struct ExprTemplate {
+    SignalExpr::Op op = SignalExpr::Op::Leaf;
+    std::vector<StrategySpec> alternatives;
+    int window = 0;
+    int threshold = 0;
+    std::vector<int> weights;
+    std::vector<ExprTemplate> children;
+};
+
+class ExprParser {
+public:
+    explicit ExprParser(const std::string& text) : m_text(text), m_pos(0) {}
+
+    bool parse(ExprTemplate& root) {
+        if (!parseNode(root)) {
+            return false;
+        }
+        skipSpace();
+        if (m_pos != m_text.size()) {
+            return fail("unexpected text");
+        }
+        return true;
+    }
+
+    const std::string& error() const { return m_error; }
+
+private:
+    bool fail(const std::string& message) {
+        m_error = message + " at position " + std::to_string(m_pos) + " in '" + m_text + "'";
+        return false;
+    }
+
+    void skipSpace() {
+        while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+            ++m_pos;
+        }
+    }
+
+    bool expect(char c) {
+        skipSpace();
+        if (m_pos >= m_text.size() || m_text[m_pos] != c) {
+            return fail(std::string("expected '") + c + "'");
+        }
+        ++m_pos;
+        return true;
+    }
+
+    bool peek(char c) {
+        skipSpace();
+        return m_pos < m_text.size() && m_text[m_pos] == c;
+    }
+
+    std::string identifier() {
+        skipSpace();
+        size_t start = m_pos;
+        while (m_pos < m_text.size() && std::isalpha(static_cast<unsigned char>(m_text[m_pos]))) {
+            ++m_pos;
+        }
+        return m_text.substr(start, m_pos - start);
+    }
+
+    bool integer(int& value) {
+        skipSpace();
+        size_t start = m_pos;
+        while (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) {
+            ++m_pos;
+        }
+        if (start == m_pos) {
+            return fail("expected an integer");
+        }
+        value = std::stoi(m_text.substr(start, m_pos - start));
+        return true;
+    }
+
+    bool parseNode(ExprTemplate& node) {
+        std::string name = identifier();
+        if (name.empty()) {
+            return fail("expected an operator or strategy");
+        }
+        if (!expect('(')) {
+            return false;
+        }
+
+        if (name == "and" || name == "or") {
+            node.op = name == "and" ? SignalExpr::Op::And : SignalExpr::Op::Or;
+            do {
+                node.children.emplace_back();
+                if (!parseNode(node.children.back())) {
+                    return false;
+                }
+            } while (peek(',') && expect(','));
+            if (node.children.size() < 2) {
+                return fail(name + " needs at least two operands");
+            }
+        } else if (name == "not") {
+            node.op = SignalExpr::Op::Not;
+            node.children.emplace_back();
+            if (!parseNode(node.children.back())) {
+                return false;
+            }
+        } else if (name == "within") {
+            node.op = SignalExpr::Op::Within;
+            node.children.emplace_back();
+            if (!integer(node.window) || !expect(',') || !parseNode(node.children.back())) {
+                return false;
+            }
+        } else if (name == "vote") {
+            node.op = SignalExpr::Op::Vote;
+            if (!integer(node.threshold) || node.threshold < 1) {
+                return fail("vote needs a threshold of at least 1");
+            }
+            while (peek(',') && expect(',')) {
+                int weight = 1;
+                skipSpace();
+                if (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) {
+                    if (!integer(weight) || !expect('*')) {
+                        return false;
+                    }
+                }
+                node.weights.push_back(weight);
+                node.children.emplace_back();
+                if (!parseNode(node.children.back())) {
+                    return false;
+                }
+            }
+            if (node.children.empty()) {
+                return fail("vote needs operands");
+            }
+        } else {
+            // Strategy leaf: the fields are parseGrid ranges
+            size_t close = m_text.find(')', m_pos);
+            if (close == std::string::npos) {
+                return fail("unterminated strategy parameters");
+            }
+            std::string fields = m_text.substr(m_pos, close - m_pos);
+            fields.erase(std::remove_if(fields.begin(), fields.end(),
+                                        [](unsigned char c) { return std::isspace(c); }), fields.end());
+            m_pos = close;
+            node.op = SignalExpr::Op::Leaf;
+            if (!parseGrid(name + ":" + fields, node.alternatives)) {
+                return fail("invalid strategy " + name);
+            }
+            if (node.alternatives.empty()) {
+                return fail("no valid parameters for " + name);
+            }
+        }
+        return expect(')');
+    }
+
+    const std::string& m_text;
+    size_t m_pos;
+    std::string m_error;
+};
+
+void collectTemplateLeaves(ExprTemplate& node, std::vector<ExprTemplate*>& leaves) {
+    if (node.op == SignalExpr::Op::Leaf) {
+        leaves.push_back(&node);
+    }
+    for (auto& child : node.children) {
+        collectTemplateLeaves(child, leaves);
+    }
+}
+
+SignalExpr instantiate(const ExprTemplate& node, const std::vector<size_t>& choice, size_t& leaf) {
+    SignalExpr expr;
+    expr.op = node.op;
+    expr.window = node.window;
+    expr.threshold = node.threshold;
+    expr.weights = node.weights;
+    if (node.op == SignalExpr::Op::Leaf) {
+        expr.spec = node.alternatives[choice[leaf++]];
+    }
+    for (const auto& child : node.children) {
+        expr.children.push_back(instantiate(child, choice, leaf));
+    }
+    return expr;
+}
+
+} // namespace
+
+// SignalMask
+
+SignalMask::SignalMask(size_t length)
+    : m_length(length), m_buy((length + 63) / 64, 0), m_sell((length + 63) / 64, 0) {}
+
+SignalMask SignalMask::fromEvents(const SignalEvents& events) {
+    SignalMask mask(events.length());
+    for (size_t e = 0; e < events.count(); ++e) {
+        size_t index = events.indexAt(e);
+        if (index >= mask.m_length) {
+            continue;
+        }
+        auto& bits = events.signalAt(e) == BUY ? mask.m_buy : mask.m_sell;
+        bits[index / 64] |= uint64_t(1) << (index % 64);
+    }
+    return mask;
+}
+
+SignalEvents SignalMask::toEvents() const {
+    SignalEvents events(m_length);
+    for (size_t w = 0; w < m_buy.size(); ++w) {
+        uint64_t conflict = m_buy[w] & m_sell[w];
+        uint64_t buy = m_buy[w] & ~conflict;
+        uint64_t any = (m_buy[w] | m_sell[w]) & ~conflict;
+        while (any != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctzll(any));
+            events.add(w * 64 + bit, ((buy >> bit) & 1) ? BUY : SELL);
+            any &= any - 1;
+        }
+    }
+    return events;
+}
+
+SignalMask maskAnd(const SignalMask& a, const SignalMask& b) {
+    SignalMask out(std::min(a.length(), b.length()));
+    for (size_t w = 0; w < out.words(); ++w) {
+        out.buy()[w] = a.buy()[w] & b.buy()[w];
+        out.sell()[w] = a.sell()[w] & b.sell()[w];
+    }
+    return out;
+}
+
+SignalMask maskOr(const SignalMask& a, const SignalMask& b) {
+    SignalMask out(std::min(a.length(), b.length()));
+    for (size_t w = 0; w < out.words(); ++w) {
+        uint64_t buy = a.buy()[w] | b.buy()[w];
+        uint64_t sell = a.sell()[w] | b.sell()[w];
+        uint64_t conflict = buy & sell;
+        out.buy()[w] = buy & ~conflict;
+        out.sell()[w] = sell & ~conflict;
+    }
+    return out;
+}
+
+SignalMask maskNot(const SignalMask& a) {
+    SignalMask out(a.length());
+    out.buy() = a.sell();
+    out.sell() = a.buy();
+    return out;
+}
+
+SignalMask maskWithin(const SignalMask& a, int bars) {
+    SignalMask out = a;
+    if (bars > 0) {
+        dilate(out.buy(), out.length(), bars);
+        dilate(out.sell(), out.length(), bars);
+    }
+    return out;
+}
+
+SignalMask maskVote(const std::vector<const SignalMask*>& masks, const std::vector<int>& weights, int threshold) {
+    if (masks.empty()) {
+        return SignalMask();
+    }
+
+    size_t length = masks[0]->length();
+    long total = 0;
+    for (size_t m = 0; m < masks.size(); ++m) {
+        length = std::min(length, masks[m]->length());
+        total += m < weights.size() ? std::max(0, weights[m]) : 1;
+    }
+
+    // Enough bit planes to hold the largest possible sum
+    size_t planes = 1;
+    while ((1L << planes) <= total) {
+        ++planes;
+    }
+
+    SignalMask out(length);
+    std::vector<uint64_t> buyCount(planes);
+    std::vector<uint64_t> sellCount(planes);
+    for (size_t w = 0; w < out.words(); ++w) {
+        std::fill(buyCount.begin(), buyCount.end(), 0);
+        std::fill(sellCount.begin(), sellCount.end(), 0);
+        for (size_t m = 0; m < masks.size(); ++m) {
+            int weight = m < weights.size() ? std::max(0, weights[m]) : 1;
+            for (size_t b = 0; weight >> b; ++b) {
+                if ((weight >> b) & 1) {
+                    addAt(buyCount, b, masks[m]->buy()[w]);
+                    addAt(sellCount, b, masks[m]->sell()[w]);
+                }
+            }
+        }
+        uint64_t buy = atLeast(buyCount, threshold);
+        uint64_t sell = atLeast(sellCount, threshold);
+        uint64_t conflict = buy & sell;
+        out.buy()[w] = buy & ~conflict;
+        out.sell()[w] = sell & ~conflict;
+    }
+    trimTail(out.buy(), length);
+    trimTail(out.sell(), length);
+    return out;
+}
+
+// SignalExpr
+
+std::string SignalExpr::toString() const {
+    std::string text;
+    switch (op) {
+        case Op::Leaf:
+            text = spec.type + "(";
+            for (size_t p = 0; p < spec.params.size(); ++p) {
+                text += (p ? ", " : "") + formatNumber(spec.params[p]);
+            }
+            return text + ")";
+        case Op::And:
+        case Op::Or:
+            text = op == Op::And ? "and(" : "or(";
+            for (size_t c = 0; c < children.size(); ++c) {
+                text += (c ? ", " : "") + children[c].toString();
+            }
+            return text + ")";
+        case Op::Not:
+            return "not(" + children[0].toString() + ")";
+        case Op::Within:
+            return "within(" + std::to_string(window) + ", " + children[0].toString() + ")";
+        case Op::Vote:
+            text = "vote(" + std::to_string(threshold);
+            for (size_t c = 0; c < children.size(); ++c) {
+                text += ", ";
+                if (weights[c] != 1) {
+                    text += std::to_string(weights[c]) + "*";
+                }
+                text += children[c].toString();
+            }
+            return text + ")";
+    }
+    return text;
+}
+
+void SignalExpr::collectLeaves(std::vector<StrategySpec>& leaves) const {
+    if (op == Op::Leaf) {
+        leaves.push_back(spec);
+    }
+    for (const auto& child : children) {
+        child.collectLeaves(leaves);
+    }
+}
+
+bool parseSignalExpression(const std::string& text, std::vector<SignalExpr>& expressions) {
+    ExprTemplate root;
+    ExprParser parser(text);
+    if (!parser.parse(root)) {
+        std::cerr << "Error: " << parser.error() << std::endl;
+        return false;
+    }
+
+    std::vector<ExprTemplate*> leaves;
+    collectTemplateLeaves(root, leaves);
+
+    size_t combinations = 1;
+    for (const auto* leaf : leaves) {
+        combinations *= leaf->alternatives.size();
+        if (combinations > kMaxExpansions) {
+            std::cerr << "Error: '" << text << "' expands to more than " << kMaxExpansions << " combinations" << std::endl;
+            return false;
+        }
+    }
+
+    // Odometer over each leaf's parameter sets
+    std::vector<size_t> choice(leaves.size(), 0);
+    for (size_t n = 0; n < combinations; ++n) {
+        size_t leaf = 0;
+        expressions.push_back(instantiate(root, choice, leaf));
+        for (size_t l = leaves.size(); l-- > 0;) {
+            if (++choice[l] < leaves[l]->alternatives.size()) {
+                break;
+            }
+            choice[l] = 0;
+        }
+    }
+    return true;
+}
+
+} // namespace strategies
+} // namespace crypto
@@ -0,0 +1,32 @@
+#include "strategies/signal_events.h"
+#include <algorithm>
+
+namespace crypto {
+namespace strategies {
+
+Signal SignalEvents::at(size_t index) const {
+    auto it = std::lower_bound(m_indices.begin(), m_indices.end(), static_cast<uint32_t>(index));
+    if (it == m_indices.end() || *it != index) {
+        return HOLD;
+    }
+    return static_cast<Signal>(m_signals[it - m_indices.begin()]);
+}
+
+std::vector<Signal> SignalEvents::toDense() const {
+    std::vector<Signal> dense(m_length, HOLD);
+    for (size_t e = 0; e < m_indices.size(); ++e) {
+        dense[m_indices[e]] = static_cast<Signal>(m_signals[e]);
+    }
+    return dense;
+}
+
+SignalEvents SignalEvents::fromDense(const std::vector<Signal>& signals) {
+    SignalEvents events(signals.size());
+    for (size_t i = 0; i < signals.size(); ++i) {
+        events.add(i, signals[i]);
+    }
+    return events;
+}
+
+} // namespace strategies
+} // namespace crypto
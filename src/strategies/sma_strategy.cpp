@@ -1,46 +1,94 @@
 #include "strategies/sma_strategy.h"
+#include <algorithm>
 #include <iostream>
 
 namespace crypto {
 namespace strategies {
 
+namespace {
+
+// Same crossover test as generateSignals, with the SMAs read from a close
+// index that grows one bar at a time
+class SMACrossStream : public SignalStream {
+public:
+    SMACrossStream(int shortPeriod, int longPeriod)
+        : m_shortPeriod(shortPeriod), m_longPeriod(longPeriod), m_prevShort(0.0), m_prevLong(0.0) {}
+
+    Signal update(const data::OHLCV& bar) override {
+        m_closes.append(bar.close);
+        size_t i = m_closes.size() - 1;
+        double shortSMA = m_closes.windowMean(m_shortPeriod, i);
+        double longSMA = m_closes.windowMean(m_longPeriod, i);
+
+        Signal signal = HOLD;
+        if (i >= 1 && i >= static_cast<size_t>(std::max(m_shortPeriod, m_longPeriod))) {
+            if (shortSMA > longSMA && m_prevShort <= m_prevLong) {
+                signal = BUY;
+            } else if (shortSMA < longSMA && m_prevShort >= m_prevLong) {
+                signal = SELL;
+            }
+        }
+        m_prevShort = shortSMA;
+        m_prevLong = longSMA;
+        return signal;
+    }
+
+private:
+    int m_shortPeriod;
+    int m_longPeriod;
+    data::PrefixSumIndex m_closes;
+    double m_prevShort;
+    double m_prevLong;
+};
+
+} // namespace
+
 SMAStrategy::SMAStrategy(int shortPeriod, int longPeriod) 
     : Strategy("SMA Crossover " + std::to_string(shortPeriod) + "/" + std::to_string(longPeriod)),
       m_shortPeriod(shortPeriod), m_longPeriod(longPeriod) {}
 
-std::vector<Signal> SMAStrategy::generateSignals(const data::DataLoader& data) {
+SignalEvents SMAStrategy::generateSignals(const data::DataLoader& data) {
     const auto& priceData = data.getData();
-    std::vector<Signal> signals(priceData.size(), HOLD);
+    SignalEvents signals(priceData.size());
     
-    // Get SMAs
-    std::vector<double> shortSMA = data.getSMA(m_shortPeriod);
-    std::vector<double> longSMA = data.getSMA(m_longPeriod);
+    // Stored SMAs, read in place
+    data::IndicatorSeries shortSeries = data.findSeries({data::IndicatorKind::SMA, m_shortPeriod, 0.0});
+    data::IndicatorSeries longSeries = data.findSeries({data::IndicatorKind::SMA, m_longPeriod, 0.0});
     
     // Check if indicators are available
-    if (shortSMA.empty() || longSMA.empty()) {
+    if (!shortSeries.values || !longSeries.values) {
         std::cerr << "Error: SMA indicators not available for " << m_name << ". Make sure they were calculated." << std::endl;
         return signals;
     }
+    const std::vector<double>& shortSMA = *shortSeries.values;
+    const std::vector<double>& longSMA = *longSeries.values;
     
-    // Generate signals based on crossovers
-    for (size_t i = 1; i < priceData.size(); ++i) {
-        // Skip if not enough data for indicators
-        if (i < static_cast<size_t>(m_longPeriod)) {
-            continue;
-        }
-        
+    // Generate signals based on crossovers, from the first bar whose previous
+    // bar has both SMAs, so no bar needs a warmup check
+    for (size_t i = data.commonValidStart(requiredIndicators()) + 1; i < priceData.size(); ++i) {
         // Buy signal: short SMA crosses above long SMA
         if (shortSMA[i] > longSMA[i] && shortSMA[i-1] <= longSMA[i-1]) {
-            signals[i] = BUY;
+            signals.add(i, BUY);
         }
         // Sell signal: short SMA crosses below long SMA
         else if (shortSMA[i] < longSMA[i] && shortSMA[i-1] >= longSMA[i-1]) {
-            signals[i] = SELL;
+            signals.add(i, SELL);
         }
     }
     
     return signals;
 }
 
+std::vector<data::IndicatorRequest> SMAStrategy::requiredIndicators() const {
+    return {
+        {data::IndicatorKind::SMA, m_shortPeriod, 0.0},
+        {data::IndicatorKind::SMA, m_longPeriod, 0.0}
+    };
+}
+
+std::unique_ptr<SignalStream> SMAStrategy::createSignalStream() const {
+    return std::make_unique<SMACrossStream>(m_shortPeriod, m_longPeriod);
+}
+
 } // namespace strategies
 } // namespace crypto
\ No newline at end of file
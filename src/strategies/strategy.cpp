@@ -1,4 +1,5 @@
 #include "strategies/strategy.h"
+#include "utils/memory_accounting.h"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -8,8 +9,8 @@ namespace crypto {
 namespace strategies {
 
 Strategy::Strategy(const std::string& name) 
-    : m_name(name), m_totalReturn(0.0), m_annualReturn(0.0), 
-      m_sharpeRatio(0.0), m_maxDrawdown(0.0), m_winRate(0.0), m_totalTrades(0) {}
+    : m_name(name), m_verbose(true), m_lazyResults(false), m_replayData(nullptr),
+      m_replayCapital(0.0), m_replayPositionSize(0.0), m_materialized(true) {}
 
 void Strategy::backtest(const data::DataLoader& data, double initialCapital, double positionSize) {
     const auto& priceData = data.getData();
@@ -19,166 +20,219 @@ void Strategy::backtest(const data::DataLoader& data, double initialCapital, dou
         return;
     }
     
-    std::cout << "Backtesting " << m_name << "..." << std::endl;
-    
-    // Generate signals if not already generated
-    if (m_signals.empty()) {
-        m_signals = generateSignals(data);
+    if (m_verbose) {
+        std::cout << "Backtesting " << m_name << "..." << std::endl;
     }
     
-    // Reset equity curve and trades
-    m_equityCurve.clear();
-    m_equityCurve.resize(priceData.size(), initialCapital);
-    m_trades.clear();
+    prepareSignals(data);
     
-    double cash = initialCapital;
-    double btcHoldings = 0.0;
-    
-    size_t lastBuyIndex = 0;
     int totalBuySignals = 0;
     int totalSellSignals = 0;
-    
-    for (size_t i = 1; i < priceData.size(); ++i) {
-        // By default, carry over yesterday's equity
-        m_equityCurve[i] = m_equityCurve[i-1];
-        
-        // Check for buy signal
-        if (m_signals[i] == BUY && btcHoldings == 0.0) {
-            double amount = cash * positionSize;
-            btcHoldings = amount / priceData[i].close;
-            cash -= amount;
-            
-            lastBuyIndex = i;
-            totalBuySignals++;
+    double finalEquity = initialCapital;
+    backtester::MetricsAccumulator metrics(initialCapital);
+    
+    if (m_lazyResults) {
+        // Step the engine bar by bar and keep nothing per bar; the same
+        // decisions and equity expression as the full pass below
+        utils::MemoryScope scope(utils::MemoryTag::Trades);
+        PositionEngine engine(m_positionConfig, initialCapital, positionSize);
+        engine.reset();
+        size_t event = 0;
+        for (size_t i = 0; i < priceData.size(); ++i) {
+            Signal signal = HOLD;
+            if (event < m_signals.count() && m_signals.indexAt(event) == i) {
+                signal = m_signals.signalAt(event++);
+            }
+            double close = priceData[i].close;
+            engine.step(i, close, signal);
+            if (i == 0) {
+                metrics.update(initialCapital, false);
+            } else {
+                finalEquity = engine.cash() + engine.heldUnits() * close;
+                metrics.update(finalEquity, engine.heldUnits() != 0.0);
+            }
         }
-        // Check for sell signal
-        else if (m_signals[i] == SELL && btcHoldings > 0.0) {
-            double amount = btcHoldings * priceData[i].close;
-            cash += amount;
-            
-            // Record the trade
-            Trade trade;
-            trade.entryIndex = lastBuyIndex;
-            trade.exitIndex = i;
-            trade.entryPrice = priceData[lastBuyIndex].close;
-            trade.exitPrice = priceData[i].close;
-            trade.profit = amount - (btcHoldings * trade.entryPrice);
-            trade.profitPercent = (trade.exitPrice / trade.entryPrice - 1.0) * 100.0;
-            
-            m_trades.push_back(trade);
-            
-            btcHoldings = 0.0;
-            totalSellSignals++;
+        for (const auto& trade : engine.getTrades()) {
+            metrics.addTrade(trade.profit);
         }
+        totalBuySignals = engine.getBuyCount();
+        totalSellSignals = engine.getSellCount();
         
-        // Update equity curve
-        m_equityCurve[i] = cash + (btcHoldings * priceData[i].close);
-    }
-    
-    // If we still have BTC at the end, calculate final equity
-    if (btcHoldings > 0.0) {
-        double finalEquity = cash + (btcHoldings * priceData.back().close);
-        m_equityCurve.back() = finalEquity;
-    }
-    
-    // Calculate performance metrics
-    m_totalReturn = (m_equityCurve.back() / initialCapital - 1.0) * 100.0;
-    
-    // Calculate annualized return assuming 365 days per year
-    double days = static_cast<double>(priceData.size());
-    double years = days / 365.0;
-    m_annualReturn = (std::pow(1.0 + m_totalReturn / 100.0, 1.0 / years) - 1.0) * 100.0;
-    
-    // Calculate max drawdown
-    double peak = initialCapital;
-    double maxDrawdown = 0.0;
-    
-    for (const auto& equity : m_equityCurve) {
-        if (equity > peak) {
-            peak = equity;
+        std::lock_guard<std::mutex> lock(m_replayMutex);
+        m_equityCurve = std::vector<double>();
+        m_trades = std::vector<Trade>();
+        m_replayData = &data;
+        m_replayCapital = initialCapital;
+        m_replayPositionSize = positionSize;
+        m_materialized = false;
+    } else {
+        // Event pass decides positions; equity is marked to market in one sweep
+        utils::MemoryScope scope(utils::MemoryTag::Equity);
+        std::vector<double> closes(priceData.size());
+        for (size_t i = 0; i < priceData.size(); ++i) {
+            closes[i] = priceData[i].close;
         }
         
-        double drawdown = (peak - equity) / peak * 100.0;
-        if (drawdown > maxDrawdown) {
-            maxDrawdown = drawdown;
-        }
-    }
-    m_maxDrawdown = maxDrawdown;
-    
-    // Calculate win rate
-    m_totalTrades = static_cast<int>(m_trades.size());
-    int winningTrades = 0;
-    
-    for (const auto& trade : m_trades) {
-        if (trade.profit > 0.0) {
-            winningTrades++;
+        PositionEngine engine(m_positionConfig, initialCapital, positionSize);
+        engine.run(closes, m_signals);
+        engine.markToMarket(closes, m_equityCurve);
+        {
+            utils::MemoryScope tradesScope(utils::MemoryTag::Trades);
+            m_trades = engine.getTrades();
         }
-    }
-    
-    m_winRate = m_totalTrades > 0 ? static_cast<double>(winningTrades) / m_totalTrades * 100.0 : 0.0;
-    
-    // Calculate Sharpe ratio (assuming daily data and risk-free rate of 0)
-    if (m_equityCurve.size() > 1) {
-        std::vector<double> dailyReturns;
+        totalBuySignals = engine.getBuyCount();
+        totalSellSignals = engine.getSellCount();
+        finalEquity = m_equityCurve.back();
+        
+        // Metrics are accumulated bar by bar over the finished curve
+        const auto& units = engine.getUnits();
+        metrics.update(initialCapital, false);
         for (size_t i = 1; i < m_equityCurve.size(); ++i) {
-            dailyReturns.push_back(m_equityCurve[i] / m_equityCurve[i-1] - 1.0);
+            metrics.update(m_equityCurve[i], units[i] != 0.0);
         }
-        
-        double meanReturn = std::accumulate(dailyReturns.begin(), dailyReturns.end(), 0.0) / dailyReturns.size();
-        
-        double variance = 0.0;
-        for (const auto& ret : dailyReturns) {
-            variance += (ret - meanReturn) * (ret - meanReturn);
+        for (const auto& trade : m_trades) {
+            metrics.addTrade(trade.profit);
         }
-        variance /= dailyReturns.size();
-        
-        double stdDev = std::sqrt(variance);
-        
-        // Annualize Sharpe ratio (assuming 252 trading days per year)
-        m_sharpeRatio = stdDev > 0 ? (meanReturn / stdDev) * std::sqrt(252.0) : 0.0;
+        m_replayData = nullptr;
+        m_materialized = true;
     }
     
+    m_metrics = metrics.finalize();
+    utils::markMilestone("first backtest");
+    
     // Print summary
+    if (!m_verbose) {
+        return;
+    }
+    
     std::cout << "=== " << m_name << " Performance ===\n";
-    std::cout << "Total Return: " << m_totalReturn << "%\n";
-    std::cout << "Annual Return: " << m_annualReturn << "%\n";
-    std::cout << "Max Drawdown: " << m_maxDrawdown << "%\n";
-    std::cout << "Win Rate: " << m_winRate << "% (" << winningTrades << "/" << m_totalTrades << ")\n";
-    std::cout << "Sharpe Ratio: " << m_sharpeRatio << "\n";
+    std::cout << "Total Return: " << m_metrics.totalReturn << "%\n";
+    std::cout << "Annual Return: " << m_metrics.annualReturn << "%\n";
+    std::cout << "Max Drawdown: " << m_metrics.maxDrawdown << "% (" << m_metrics.maxDrawdownDuration << " bars)\n";
+    std::cout << "Win Rate: " << m_metrics.winRate << "% (" << m_metrics.totalTrades << " trades)\n";
+    std::cout << "Sharpe Ratio: " << m_metrics.sharpeRatio << ", Sortino: " << m_metrics.sortinoRatio
+              << ", Calmar: " << m_metrics.calmarRatio << "\n";
+    std::cout << "Exposure: " << m_metrics.exposure << "%\n";
     std::cout << "Buy Signals: " << totalBuySignals << ", Sell Signals: " << totalSellSignals << "\n";
-    std::cout << "Final Equity: $" << m_equityCurve.back() << " (Initial: $" << initialCapital << ")\n";
+    std::cout << "Final Equity: $" << finalEquity << " (Initial: $" << initialCapital << ")\n";
     std::cout << std::string(40, '-') << std::endl;
 }
 
+void Strategy::prepareSignals(const data::DataLoader& data) {
+    // Generate signals if not already generated for this series
+    if (m_signals.length() != data.getData().size()) {
+        utils::MemoryScope scope(utils::MemoryTag::Signals);
+        m_signals = generateSignals(data);
+    }
+}
+
+void Strategy::setVerbose(bool verbose) {
+    m_verbose = verbose;
+}
+
+void Strategy::setLazyResults(bool lazy) {
+    m_lazyResults = lazy;
+}
+
+bool Strategy::hasLazyResults() const {
+    return m_lazyResults;
+}
+
+void Strategy::releaseResults() {
+    std::lock_guard<std::mutex> lock(m_replayMutex);
+    if (m_replayData) {
+        m_equityCurve = std::vector<double>();
+        m_trades = std::vector<Trade>();
+        m_materialized = false;
+    }
+}
+
+void Strategy::materializeResults() const {
+    std::lock_guard<std::mutex> lock(m_replayMutex);
+    if (m_materialized || !m_replayData) {
+        return;
+    }
+    
+    // The full pass of backtest(), from the kept signal events
+    utils::MemoryScope scope(utils::MemoryTag::Equity);
+    const auto& priceData = m_replayData->getData();
+    std::vector<double> closes(priceData.size());
+    for (size_t i = 0; i < priceData.size(); ++i) {
+        closes[i] = priceData[i].close;
+    }
+    PositionEngine engine(m_positionConfig, m_replayCapital, m_replayPositionSize);
+    engine.run(closes, m_signals);
+    engine.markToMarket(closes, m_equityCurve);
+    {
+        utils::MemoryScope tradesScope(utils::MemoryTag::Trades);
+        m_trades = engine.getTrades();
+    }
+    m_materialized = true;
+}
+
+void Strategy::setPositionConfig(const PositionConfig& config) {
+    m_positionConfig = config;
+}
+
+const PositionConfig& Strategy::getPositionConfig() const {
+    return m_positionConfig;
+}
+
 double Strategy::getTotalReturn() const {
-    return m_totalReturn;
+    return m_metrics.totalReturn;
 }
 
 double Strategy::getAnnualReturn() const {
-    return m_annualReturn;
+    return m_metrics.annualReturn;
 }
 
 double Strategy::getSharpeRatio() const {
-    return m_sharpeRatio;
+    return m_metrics.sharpeRatio;
 }
 
 double Strategy::getMaxDrawdown() const {
-    return m_maxDrawdown;
+    return m_metrics.maxDrawdown;
 }
 
 double Strategy::getWinRate() const {
-    return m_winRate;
+    return m_metrics.winRate;
 }
 
 int Strategy::getTotalTrades() const {
-    return m_totalTrades;
+    return m_metrics.totalTrades;
+}
+
+double Strategy::getSortinoRatio() const {
+    return m_metrics.sortinoRatio;
+}
+
+double Strategy::getCalmarRatio() const {
+    return m_metrics.calmarRatio;
+}
+
+double Strategy::getVolatility() const {
+    return m_metrics.volatility;
+}
+
+int Strategy::getMaxDrawdownDuration() const {
+    return m_metrics.maxDrawdownDuration;
+}
+
+double Strategy::getExposure() const {
+    return m_metrics.exposure;
+}
+
+const backtester::PerformanceMetrics& Strategy::getMetrics() const {
+    return m_metrics;
 }
 
 const std::vector<double>& Strategy::getEquityCurve() const {
+    materializeResults();
     return m_equityCurve;
 }
 
 const std::vector<Trade>& Strategy::getTrades() const {
+    materializeResults();
     return m_trades;
 }
 
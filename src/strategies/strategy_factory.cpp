@@ -0,0 +1,208 @@
+#include "strategies/strategy_factory.h"
+#include "strategies/sma_strategy.h"
+#include "strategies/rsi_strategy.h"
+#include "strategies/bollinger_bands_strategy.h"
+#include "strategies/ensemble_strategy.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace crypto {
+namespace strategies {
+
+namespace {
+
+size_t paramCount(const std::string& type) {
+    if (type == "sma" || type == "bb") {
+        return 2;
+    }
+    if (type == "rsi") {
+        return 3;
+    }
+    return 0;
+}
+
+// Parse "v" or "start..end/step" into a list of values
+bool parseRange(const std::string& field, std::vector<double>& values) {
+    try {
+        size_t dots = field.find("..");
+        if (dots == std::string::npos) {
+            values.push_back(std::stod(field));
+            return true;
+        }
+
+        size_t slash = field.find('/', dots);
+        double start = std::stod(field.substr(0, dots));
+        double end = std::stod(field.substr(dots + 2, slash == std::string::npos ? std::string::npos : slash - dots - 2));
+        double step = slash == std::string::npos ? 1.0 : std::stod(field.substr(slash + 1));
+
+        if (step <= 0.0 || end < start) {
+            return false;
+        }
+
+        // Count steps up front so fractional steps do not drift past `end`
+        long steps = static_cast<long>(std::floor((end - start) / step + 1e-9));
+        for (long k = 0; k <= steps; ++k) {
+            values.push_back(start + k * step);
+        }
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+} // namespace
+
+bool isValidSpec(const StrategySpec& spec) {
+    if (spec.type == "ensemble") {
+        std::vector<SignalExpr> expressions;
+        return spec.params.empty() && parseSignalExpression(spec.expression, expressions) && expressions.size() == 1;
+    }
+
+    size_t expected = paramCount(spec.type);
+    if (expected == 0 || spec.params.size() != expected) {
+        return false;
+    }
+
+    const auto& p = spec.params;
+    if (spec.type == "sma") {
+        return p[0] >= 1 && p[0] < p[1];
+    }
+    if (spec.type == "rsi") {
+        return p[0] >= 1 && p[1] < p[2];
+    }
+    if (spec.type == "bb") {
+        return p[0] >= 2 && p[1] > 0.0;
+    }
+    return false;
+}
+
+std::shared_ptr<Strategy> createStrategy(const StrategySpec& spec) {
+    return createStrategy(spec, nullptr);
+}
+
+std::shared_ptr<Strategy> createStrategy(const StrategySpec& spec, std::shared_ptr<SignalCache> cache) {
+    if (spec.type == "ensemble") {
+        std::vector<SignalExpr> expressions;
+        if (!spec.params.empty() || !parseSignalExpression(spec.expression, expressions) || expressions.size() != 1) {
+            return nullptr;
+        }
+        return std::make_shared<EnsembleStrategy>(expressions[0], cache);
+    }
+
+    if (!isValidSpec(spec)) {
+        return nullptr;
+    }
+
+    const auto& p = spec.params;
+    if (spec.type == "sma") {
+        return std::make_shared<SMAStrategy>(static_cast<int>(p[0]), static_cast<int>(p[1]));
+    }
+    if (spec.type == "rsi") {
+        return std::make_shared<RSIStrategy>(static_cast<int>(p[0]), p[1], p[2]);
+    }
+    if (spec.type == "bb") {
+        return std::make_shared<BollingerBandsStrategy>(static_cast<int>(p[0]), p[1]);
+    }
+    return nullptr;
+}
+
+std::string formatSpec(const StrategySpec& spec) {
+    std::ostringstream out;
+    out.precision(17);
+    out << spec.type;
+    if (spec.type == "ensemble") {
+        out << " " << spec.expression;
+    }
+    for (double param : spec.params) {
+        out << " " << param;
+    }
+    return out.str();
+}
+
+bool parseSpec(const std::string& text, StrategySpec& spec) {
+    std::istringstream in(text);
+    spec = StrategySpec();
+
+    if (!(in >> spec.type)) {
+        return false;
+    }
+
+    // The expression is the rest of the line
+    if (spec.type == "ensemble") {
+        std::getline(in >> std::ws, spec.expression);
+        return !spec.expression.empty();
+    }
+
+    double param;
+    while (in >> param) {
+        spec.params.push_back(param);
+    }
+    return in.eof() && paramCount(spec.type) == spec.params.size();
+}
+
+bool parseGrid(const std::string& grid, std::vector<StrategySpec>& specs) {
+    size_t colon = grid.find(':');
+    if (colon == std::string::npos) {
+        std::cerr << "Error: Grid '" << grid << "' must look like type:range,range,..." << std::endl;
+        return false;
+    }
+
+    std::string type = grid.substr(0, colon);
+    if (type == "ensemble") {
+        std::vector<SignalExpr> expressions;
+        if (!parseSignalExpression(grid.substr(colon + 1), expressions)) {
+            return false;
+        }
+        for (const auto& expression : expressions) {
+            specs.push_back({type, {}, expression.toString()});
+        }
+        return true;
+    }
+
+    std::vector<std::vector<double>> axes;
+
+    std::stringstream ss(grid.substr(colon + 1));
+    std::string field;
+    while (std::getline(ss, field, ',')) {
+        std::vector<double> values;
+        if (!parseRange(field, values)) {
+            std::cerr << "Error: Invalid range '" << field << "' in grid " << grid << std::endl;
+            return false;
+        }
+        axes.push_back(values);
+    }
+
+    if (axes.size() != paramCount(type)) {
+        std::cerr << "Error: Grid " << grid << " needs " << paramCount(type)
+                  << " parameters for strategy type '" << type << "'" << std::endl;
+        return false;
+    }
+
+    // Cartesian product, skipping combinations that make no sense
+    std::vector<size_t> cursor(axes.size(), 0);
+    while (true) {
+        StrategySpec spec{type, {}};
+        for (size_t a = 0; a < axes.size(); ++a) {
+            spec.params.push_back(axes[a][cursor[a]]);
+        }
+        if (isValidSpec(spec)) {
+            specs.push_back(spec);
+        }
+
+        size_t a = axes.size();
+        while (a > 0) {
+            --a;
+            if (++cursor[a] < axes[a].size()) {
+                break;
+            }
+            cursor[a] = 0;
+            if (a == 0) {
+                return true;
+            }
+        }
+    }
+}
+
+} // namespace strategies
+} // namespace crypto
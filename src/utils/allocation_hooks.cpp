@@ -0,0 +1,73 @@
+// Replacement global operator new/delete charging every allocation to the
+// calling thread's MemoryTag. Linked into the backtester executable only
+// (see CMakeLists.txt): a library must not replace its host's allocator.
+// Aligned overloads keep the standard implementation and go uncounted.
+#include "utils/memory_accounting.h"
+#include <new>
+
+namespace {
+
+const bool g_registered = (crypto::utils::setAllocationHooksLinked(), true);
+
+void* allocateOrThrow(std::size_t size) {
+    while (true) {
+        if (void* pointer = crypto::utils::trackedAllocate(size)) {
+            return pointer;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* allocateOrNull(std::size_t size) noexcept {
+    try {
+        return allocateOrThrow(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+} // namespace
+
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateOrNull(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocateOrNull(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    crypto::utils::trackedFree(pointer);
+}
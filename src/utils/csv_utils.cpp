@@ -6,6 +6,17 @@
 namespace crypto {
 namespace utils {
 
+std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"") == std::string::npos) {
+        return text;
+    }
+    std::string quoted = "\"";
+    for (char c : text) {
+        quoted += c == '"' ? "\"\"" : std::string(1, c);
+    }
+    return quoted + "\"";
+}
+
 std::vector<std::vector<std::string>> readCSV(const std::string& filename, char delimiter, bool skipHeader) {
     std::vector<std::vector<std::string>> result;
     std::ifstream file(filename);
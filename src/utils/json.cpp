@@ -0,0 +1,318 @@
+#include "utils/json.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace crypto {
+namespace utils {
+
+class JsonParser {
+public:
+    explicit JsonParser(const std::string& text) : m_text(text), m_pos(0) {}
+
+    bool parseDocument(JsonValue& value, std::string& error) {
+        if (!parseValue(value, 0)) {
+            error = m_error;
+            return false;
+        }
+        skipWhitespace();
+        if (m_pos != m_text.size()) {
+            fail("unexpected trailing characters");
+            error = m_error;
+            return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr int kMaxDepth = 64;
+
+    bool fail(const std::string& message) {
+        // Report a 1-based line:column for the offending character
+        size_t line = 1;
+        size_t column = 1;
+        for (size_t i = 0; i < m_pos && i < m_text.size(); ++i) {
+            if (m_text[i] == '\n') {
+                ++line;
+                column = 1;
+            } else {
+                ++column;
+            }
+        }
+        m_error = message + " at line " + std::to_string(line) + ", column " + std::to_string(column);
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                ++m_pos;
+            } else {
+                break;
+            }
+        }
+    }
+
+    bool consume(const char* literal) {
+        size_t length = std::char_traits<char>::length(literal);
+        if (m_text.compare(m_pos, length, literal) == 0) {
+            m_pos += length;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseValue(JsonValue& value, int depth) {
+        if (depth > kMaxDepth) {
+            return fail("nesting too deep");
+        }
+
+        skipWhitespace();
+        if (m_pos >= m_text.size()) {
+            return fail("unexpected end of input");
+        }
+
+        char c = m_text[m_pos];
+        if (c == '{') {
+            return parseObject(value, depth);
+        }
+        if (c == '[') {
+            return parseArray(value, depth);
+        }
+        if (c == '"') {
+            value.m_type = JsonValue::Type::String;
+            return parseString(value.m_string);
+        }
+        if (consume("true")) {
+            value.m_type = JsonValue::Type::Bool;
+            value.m_bool = true;
+            return true;
+        }
+        if (consume("false")) {
+            value.m_type = JsonValue::Type::Bool;
+            value.m_bool = false;
+            return true;
+        }
+        if (consume("null")) {
+            value.m_type = JsonValue::Type::Null;
+            return true;
+        }
+        return parseNumber(value);
+    }
+
+    bool parseNumber(JsonValue& value) {
+        const char* begin = m_text.c_str() + m_pos;
+        char* end = nullptr;
+        double number = std::strtod(begin, &end);
+        if (end == begin) {
+            return fail("expected a value");
+        }
+        m_pos += static_cast<size_t>(end - begin);
+        value.m_type = JsonValue::Type::Number;
+        value.m_number = number;
+        return true;
+    }
+
+    bool parseString(std::string& out) {
+        ++m_pos;  // Opening quote
+        out.clear();
+
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+
+            if (m_pos >= m_text.size()) {
+                break;
+            }
+            char escape = m_text[m_pos++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    if (m_pos + 4 > m_text.size()) {
+                        return fail("truncated unicode escape");
+                    }
+                    std::string hex = m_text.substr(m_pos, 4);
+                    char* end = nullptr;
+                    unsigned code = static_cast<unsigned>(std::strtoul(hex.c_str(), &end, 16));
+                    if (end != hex.c_str() + 4) {
+                        return fail("invalid unicode escape");
+                    }
+                    m_pos += 4;
+                    // UTF-8 encode (basic multilingual plane only)
+                    if (code < 0x80) {
+                        out += static_cast<char>(code);
+                    } else if (code < 0x800) {
+                        out += static_cast<char>(0xC0 | (code >> 6));
+                        out += static_cast<char>(0x80 | (code & 0x3F));
+                    } else {
+                        out += static_cast<char>(0xE0 | (code >> 12));
+                        out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                        out += static_cast<char>(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default:
+                    return fail("invalid escape sequence");
+            }
+        }
+        return fail("unterminated string");
+    }
+
+    bool parseArray(JsonValue& value, int depth) {
+        ++m_pos;  // [
+        value.m_type = JsonValue::Type::Array;
+
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+            ++m_pos;
+            return true;
+        }
+
+        while (true) {
+            JsonValue element;
+            if (!parseValue(element, depth + 1)) {
+                return false;
+            }
+            value.m_array.push_back(std::move(element));
+
+            skipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                ++m_pos;
+            } else if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                ++m_pos;
+                return true;
+            } else {
+                return fail("expected ',' or ']'");
+            }
+        }
+    }
+
+    bool parseObject(JsonValue& value, int depth) {
+        ++m_pos;  // {
+        value.m_type = JsonValue::Type::Object;
+
+        skipWhitespace();
+        if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+            ++m_pos;
+            return true;
+        }
+
+        while (true) {
+            skipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                return fail("expected a member name");
+            }
+            std::string key;
+            if (!parseString(key)) {
+                return false;
+            }
+
+            skipWhitespace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != ':') {
+                return fail("expected ':'");
+            }
+            ++m_pos;
+
+            JsonValue member;
+            if (!parseValue(member, depth + 1)) {
+                return false;
+            }
+            value.m_object.emplace_back(std::move(key), std::move(member));
+
+            skipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                ++m_pos;
+            } else if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                ++m_pos;
+                return true;
+            } else {
+                return fail("expected ',' or '}'");
+            }
+        }
+    }
+
+    const std::string& m_text;
+    size_t m_pos;
+    std::string m_error;
+};
+
+bool JsonValue::asBool(bool fallback) const {
+    return m_type == Type::Bool ? m_bool : fallback;
+}
+
+double JsonValue::asNumber(double fallback) const {
+    return m_type == Type::Number ? m_number : fallback;
+}
+
+std::string JsonValue::asString(const std::string& fallback) const {
+    return m_type == Type::String ? m_string : fallback;
+}
+
+const std::vector<JsonValue>& JsonValue::asArray() const {
+    return m_array;
+}
+
+const std::vector<std::pair<std::string, JsonValue>>& JsonValue::asObject() const {
+    return m_object;
+}
+
+bool JsonValue::has(const std::string& key) const {
+    for (const auto& member : m_object) {
+        if (member.first == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const {
+    static const JsonValue null;
+    for (const auto& member : m_object) {
+        if (member.first == key) {
+            return member.second;
+        }
+    }
+    return null;
+}
+
+bool JsonValue::parse(const std::string& text, JsonValue& value, std::string& error) {
+    value = JsonValue();
+    JsonParser parser(text);
+    return parser.parseDocument(value, error);
+}
+
+bool readJsonFile(const std::string& filename, JsonValue& value) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+
+    std::string error;
+    if (!JsonValue::parse(buffer.str(), value, error)) {
+        std::cerr << "Error: " << filename << ": " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace utils
+} // namespace crypto
@@ -0,0 +1,86 @@
+#include "utils/latency_histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace crypto {
+namespace utils {
+
+// One linear run of sub-buckets below 2^kSubBits, then one per remaining exponent
+LatencyHistogram::LatencyHistogram() : m_buckets(size_t(64 - kSubBits + 1) << kSubBits, 0), m_count(0), m_min(0), m_max(0), m_sum(0.0) {}
+
+size_t LatencyHistogram::bucketFor(uint64_t nanos) {
+    const uint64_t subBuckets = uint64_t(1) << kSubBits;
+    if (nanos < subBuckets) {
+        return static_cast<size_t>(nanos);
+    }
+    // Top kSubBits + 1 significant bits select the bucket
+    unsigned exponent = 63u - static_cast<unsigned>(__builtin_clzll(nanos));
+    unsigned shift = exponent - kSubBits;
+    uint64_t sub = (nanos >> shift) - subBuckets;
+    return static_cast<size_t>(subBuckets + uint64_t(shift) * subBuckets + sub);
+}
+
+uint64_t LatencyHistogram::bucketValue(size_t bucket) {
+    const size_t subBuckets = size_t(1) << kSubBits;
+    if (bucket < subBuckets) {
+        return bucket;
+    }
+    unsigned shift = static_cast<unsigned>((bucket - subBuckets) / subBuckets);
+    uint64_t sub = (bucket - subBuckets) % subBuckets;
+    uint64_t lower = (subBuckets + sub) << shift;
+    // Middle of the bucket's range
+    return lower + ((uint64_t(1) << shift) - 1) / 2;
+}
+
+void LatencyHistogram::record(uint64_t nanos) {
+    ++m_buckets[bucketFor(nanos)];
+    m_min = m_count == 0 ? nanos : std::min(m_min, nanos);
+    m_max = std::max(m_max, nanos);
+    m_sum += static_cast<double>(nanos);
+    ++m_count;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.m_count == 0) {
+        return;
+    }
+    for (size_t b = 0; b < m_buckets.size(); ++b) {
+        m_buckets[b] += other.m_buckets[b];
+    }
+    m_min = m_count == 0 ? other.m_min : std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+    m_sum += other.m_sum;
+    m_count += other.m_count;
+}
+
+void LatencyHistogram::reset() {
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_min = 0;
+    m_max = 0;
+    m_sum = 0.0;
+}
+
+double LatencyHistogram::mean() const {
+    return m_count ? m_sum / static_cast<double>(m_count) : 0.0;
+}
+
+uint64_t LatencyHistogram::percentile(double q) const {
+    if (m_count == 0) {
+        return 0;
+    }
+    q = std::min(1.0, std::max(0.0, q));
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(m_count))));
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < m_buckets.size(); ++b) {
+        seen += m_buckets[b];
+        if (seen >= rank) {
+            return std::min(m_max, std::max(m_min, bucketValue(b)));
+        }
+    }
+    return m_max;
+}
+
+} // namespace utils
+} // namespace crypto
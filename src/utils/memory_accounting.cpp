@@ -0,0 +1,258 @@
+#include "utils/memory_accounting.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <vector>
+
+namespace crypto {
+namespace utils {
+
+namespace {
+
+// Precedes every tracked block; 16 bytes keeps the block max-aligned
+struct AllocationHeader {
+    uint64_t size;
+    uint32_t tag;
+    uint32_t counted;
+};
+static_assert(sizeof(AllocationHeader) == 16, "header must preserve malloc alignment");
+
+struct TagCounters {
+    std::atomic<int64_t> live{0};
+    std::atomic<int64_t> peak{0};
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> bytes{0};
+};
+
+// Constant-initialised, so usable by allocations during static initialisation
+std::atomic<bool> g_enabled{false};
+std::atomic<bool> g_hooksLinked{false};
+TagCounters g_counters[kNumMemoryTags];
+TagCounters g_total;
+thread_local MemoryTag t_tag = MemoryTag::Other;
+
+const auto g_start = std::chrono::steady_clock::now();
+
+struct Milestone {
+    std::string name;
+    double seconds;
+    size_t rssBytes;
+    int64_t heapBytes;
+};
+std::mutex g_milestoneMutex;
+std::vector<Milestone> g_milestones;
+
+void charge(TagCounters& counters, int64_t size) {
+    int64_t live = counters.live.fetch_add(size, std::memory_order_relaxed) + size;
+    int64_t peak = counters.peak.load(std::memory_order_relaxed);
+    while (live > peak && !counters.peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    counters.allocations.fetch_add(1, std::memory_order_relaxed);
+    counters.bytes.fetch_add(static_cast<uint64_t>(size), std::memory_order_relaxed);
+}
+
+// A "Vm...:  1234 kB" line of /proc/self/status, in bytes
+size_t statusBytes(const char* key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    const std::string prefix = std::string(key) + ":";
+    while (std::getline(status, line)) {
+        if (line.compare(0, prefix.size(), prefix) == 0) {
+            std::istringstream fields(line.substr(prefix.size()));
+            size_t kilobytes = 0;
+            fields >> kilobytes;
+            return kilobytes * 1024;
+        }
+    }
+    return 0;
+}
+
+double megabytes(double bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+} // namespace
+
+const char* memoryTagName(MemoryTag tag) {
+    switch (tag) {
+        case MemoryTag::Other: return "other";
+        case MemoryTag::Bars: return "bars";
+        case MemoryTag::Indicators: return "indicators";
+        case MemoryTag::Signals: return "signals";
+        case MemoryTag::Equity: return "equity";
+        case MemoryTag::Trades: return "trades";
+    }
+    return "unknown";
+}
+
+MemoryScope::MemoryScope(MemoryTag tag) : m_previous(t_tag) {
+    t_tag = tag;
+}
+
+MemoryScope::~MemoryScope() {
+    t_tag = m_previous;
+}
+
+void enableMemoryAccounting() {
+    g_enabled.store(true, std::memory_order_relaxed);
+}
+
+bool memoryAccountingEnabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+MemoryCounters memoryCounters(MemoryTag tag) {
+    const TagCounters& counters = g_counters[static_cast<int>(tag)];
+    MemoryCounters result;
+    result.liveBytes = counters.live.load(std::memory_order_relaxed);
+    result.peakBytes = counters.peak.load(std::memory_order_relaxed);
+    result.allocations = counters.allocations.load(std::memory_order_relaxed);
+    result.allocatedBytes = counters.bytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+bool allocationHooksLinked() {
+    return g_hooksLinked.load(std::memory_order_relaxed);
+}
+
+void setAllocationHooksLinked() {
+    g_hooksLinked.store(true, std::memory_order_relaxed);
+}
+
+void* trackedAllocate(size_t size) noexcept {
+    auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+    if (!header) {
+        return nullptr;
+    }
+    header->size = size;
+    header->tag = static_cast<uint32_t>(t_tag);
+    header->counted = g_enabled.load(std::memory_order_relaxed);
+    if (header->counted) {
+        charge(g_counters[header->tag], static_cast<int64_t>(size));
+        charge(g_total, static_cast<int64_t>(size));
+    }
+    return header + 1;
+}
+
+void trackedFree(void* pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+    auto* header = static_cast<AllocationHeader*>(pointer) - 1;
+    if (header->counted) {
+        int64_t size = static_cast<int64_t>(header->size);
+        g_counters[header->tag].live.fetch_sub(size, std::memory_order_relaxed);
+        g_total.live.fetch_sub(size, std::memory_order_relaxed);
+    }
+    std::free(header);
+}
+
+size_t currentRssBytes() {
+    return statusBytes("VmRSS");
+}
+
+size_t peakRssBytes() {
+    return statusBytes("VmHWM");
+}
+
+void markMilestone(const std::string& name) {
+    if (!memoryAccountingEnabled()) {
+        return;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - g_start).count();
+    std::lock_guard<std::mutex> lock(g_milestoneMutex);
+    for (const auto& milestone : g_milestones) {
+        if (milestone.name == name) {
+            return;
+        }
+    }
+    g_milestones.push_back({name, seconds, currentRssBytes(), g_total.live.load(std::memory_order_relaxed)});
+}
+
+void printMemoryReport(std::ostream& out) {
+    out << "\n============= Memory Report =============\n";
+    if (allocationHooksLinked()) {
+        out << std::left << std::setw(14) << "Component"
+            << std::right << std::setw(14) << "Live (MB)"
+            << std::setw(14) << "Peak (MB)"
+            << std::setw(16) << "Allocations"
+            << std::setw(18) << "Allocated (MB)" << std::endl;
+        out << std::string(76, '-') << std::endl;
+        out << std::fixed << std::setprecision(2);
+        for (int t = 0; t < kNumMemoryTags; ++t) {
+            MemoryCounters counters = memoryCounters(static_cast<MemoryTag>(t));
+            out << std::left << std::setw(14) << memoryTagName(static_cast<MemoryTag>(t))
+                << std::right << std::setw(14) << megabytes(counters.liveBytes)
+                << std::setw(14) << megabytes(counters.peakBytes)
+                << std::setw(16) << counters.allocations
+                << std::setw(18) << megabytes(counters.allocatedBytes) << std::endl;
+        }
+        out << std::left << std::setw(14) << "heap"
+            << std::right << std::setw(14) << megabytes(g_total.live.load())
+            << std::setw(14) << megabytes(g_total.peak.load())
+            << std::setw(16) << g_total.allocations.load()
+            << std::setw(18) << megabytes(g_total.bytes.load()) << std::endl;
+    } else {
+        out << "Allocation hooks not linked; reporting resident memory only" << std::endl;
+        out << std::fixed << std::setprecision(2);
+    }
+
+    out << "Peak RSS " << megabytes(peakRssBytes()) << " MB, current RSS " << megabytes(currentRssBytes())
+        << " MB" << std::endl;
+
+    std::lock_guard<std::mutex> lock(g_milestoneMutex);
+    if (!g_milestones.empty()) {
+        out << "Startup:" << std::endl;
+        for (const auto& milestone : g_milestones) {
+            out << "  " << std::left << std::setw(20) << milestone.name << std::right
+                << std::setprecision(3) << std::setw(10) << milestone.seconds << "s"
+                << std::setprecision(2) << std::setw(10) << megabytes(milestone.rssBytes) << " MB RSS"
+                << std::setw(10) << megabytes(milestone.heapBytes) << " MB heap" << std::endl;
+        }
+    }
+    out.unsetf(std::ios::fixed);
+    out << std::setprecision(6);
+}
+
+bool writeMemoryReport(const std::string& path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cerr << "Failed to open file for writing: " << path << std::endl;
+        return false;
+    }
+
+    out << "{\n  \"allocationHooks\": " << (allocationHooksLinked() ? "true" : "false") << ",\n"
+        << "  \"peakRssBytes\": " << peakRssBytes() << ",\n"
+        << "  \"currentRssBytes\": " << currentRssBytes() << ",\n"
+        << "  \"heap\": {\"liveBytes\": " << g_total.live.load() << ", \"peakBytes\": " << g_total.peak.load()
+        << ", \"allocations\": " << g_total.allocations.load() << ", \"allocatedBytes\": " << g_total.bytes.load()
+        << "},\n  \"components\": [\n";
+    for (int t = 0; t < kNumMemoryTags; ++t) {
+        MemoryCounters counters = memoryCounters(static_cast<MemoryTag>(t));
+        out << "    {\"name\": \"" << memoryTagName(static_cast<MemoryTag>(t)) << "\", \"liveBytes\": "
+            << counters.liveBytes << ", \"peakBytes\": " << counters.peakBytes << ", \"allocations\": "
+            << counters.allocations << ", \"allocatedBytes\": " << counters.allocatedBytes << "}"
+            << (t + 1 < kNumMemoryTags ? "," : "") << "\n";
+    }
+    out << "  ],\n  \"milestones\": [\n";
+
+    std::lock_guard<std::mutex> lock(g_milestoneMutex);
+    out << std::setprecision(9);
+    for (size_t m = 0; m < g_milestones.size(); ++m) {
+        const auto& milestone = g_milestones[m];
+        out << "    {\"name\": \"" << milestone.name << "\", \"seconds\": " << milestone.seconds
+            << ", \"rssBytes\": " << milestone.rssBytes << ", \"heapBytes\": " << milestone.heapBytes << "}"
+            << (m + 1 < g_milestones.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+    return true;
+}
+
+} // namespace utils
+} // namespace crypto
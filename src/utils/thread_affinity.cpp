@@ -0,0 +1,108 @@
+#include "utils/thread_affinity.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace crypto {
+namespace utils {
+
+bool pinCurrentThread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return false;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+bool pinCurrentThread(const std::vector<int>& cpus) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) {
+            return false;
+        }
+        CPU_SET(cpu, &set);
+    }
+    return !cpus.empty() && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpus;
+    return false;
+#endif
+}
+
+namespace {
+
+std::vector<NumaNode> readNumaNodes() {
+    std::vector<NumaNode> nodes;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0 || name.size() == 4 ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string list;
+        NumaNode node{std::stoi(name.substr(4)), {}};
+        // Memory-only nodes have an empty cpulist
+        if (std::getline(file, list) && !list.empty() && parseCpuList(list, node.cpus)) {
+            nodes.push_back(node);
+        }
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+
+    if (nodes.empty()) {
+        NumaNode all{0, {}};
+        for (unsigned cpu = 0; cpu < std::max(1u, std::thread::hardware_concurrency()); ++cpu) {
+            all.cpus.push_back(static_cast<int>(cpu));
+        }
+        nodes.push_back(all);
+    }
+    return nodes;
+}
+
+} // namespace
+
+const std::vector<NumaNode>& numaNodes() {
+    static const std::vector<NumaNode> nodes = readNumaNodes();
+    return nodes;
+}
+
+bool parseCpuList(const std::string& text, std::vector<int>& cpus) {
+    std::stringstream ss(text);
+    std::string field;
+    try {
+        while (std::getline(ss, field, ',')) {
+            size_t dash = field.find('-');
+            int first = std::stoi(field.substr(0, dash));
+            int last = dash == std::string::npos ? first : std::stoi(field.substr(dash + 1));
+            if (first < 0 || last < first) {
+                return false;
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(cpu);
+            }
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return !cpus.empty();
+}
+
+} // namespace utils
+} // namespace crypto
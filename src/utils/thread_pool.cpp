@@ -0,0 +1,256 @@
+#include "utils/thread_pool.h"
+#include "utils/thread_affinity.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace crypto {
+namespace utils {
+
+namespace {
+
+// The pool and worker index of the calling thread, if it is a worker
+thread_local const ThreadPool* t_pool = nullptr;
+thread_local size_t t_worker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads)
+    : m_nextWorker(0), m_queued(0), m_pending(0), m_stopping(false),
+      m_statsStart(std::chrono::steady_clock::now()) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Workers fill the nodes in contiguous runs, in proportion
+    const auto& nodes = numaNodes();
+    m_nodeWorkers.resize(nodes.size());
+    for (size_t i = 0; i < threads; ++i) {
+        m_workers.push_back(std::make_unique<Worker>());
+        size_t node = i * nodes.size() / threads;
+        m_workers.back()->node = static_cast<int>(node);
+        m_nodeWorkers[node].push_back(i);
+    }
+
+    for (size_t i = 0; i < threads; ++i) {
+        m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_taskReady.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    // A worker keeps what it spawns; others deal round-robin
+    size_t worker = t_pool == this ? t_worker : m_nextWorker++ % m_workers.size();
+    push(worker, std::move(task));
+}
+
+void ThreadPool::submit(std::function<void()> task, int node) {
+    if (node < 0 || static_cast<size_t>(node) >= m_nodeWorkers.size() || m_nodeWorkers[node].empty()) {
+        submit(std::move(task));
+        return;
+    }
+    const auto& local = m_nodeWorkers[node];
+    size_t worker = t_pool == this && m_workers[t_worker]->node == node ? t_worker
+                                                                        : local[m_nextWorker++ % local.size()];
+    push(worker, std::move(task));
+}
+
+void ThreadPool::push(size_t worker, std::function<void()> task) {
+    ++m_pending;
+    {
+        std::lock_guard<std::mutex> lock(m_workers[worker]->mutex);
+        m_workers[worker]->tasks.push_back(std::move(task));
+    }
+    ++m_queued;
+    // Taking the lock orders this against a worker checking m_queued before it sleeps
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+    }
+    m_taskReady.notify_one();
+}
+
+bool ThreadPool::popLocal(size_t worker, std::function<void()>& task) {
+    Worker& self = *m_workers[worker];
+    std::lock_guard<std::mutex> lock(self.mutex);
+    if (self.tasks.empty()) {
+        return false;
+    }
+    task = std::move(self.tasks.back());
+    self.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(size_t thief, std::function<void()>& task) {
+    const size_t count = m_workers.size();
+    const int home = m_workers[thief]->node;
+
+    // Same node first, then the rest, each scan starting after the thief
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t step = 1; step < count; ++step) {
+            Worker& victim = *m_workers[(thief + step) % count];
+            if ((victim.node == home) != (pass == 0)) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_pending == 0; });
+}
+
+size_t ThreadPool::size() const {
+    return m_threads.size();
+}
+
+size_t ThreadPool::nodeCount() const {
+    return m_nodeWorkers.size();
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    t_pool = this;
+    t_worker = index;
+    Worker& self = *m_workers[index];
+    if (m_nodeWorkers.size() > 1) {
+        pinCurrentThread(numaNodes()[self.node].cpus);
+    }
+
+    while (true) {
+        std::function<void()> task;
+        bool stolen = false;
+        if (!popLocal(index, task)) {
+            stolen = steal(index, task);
+            if (!stolen) {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_taskReady.wait(lock, [this] { return m_stopping || m_queued > 0; });
+                if (m_stopping && m_queued == 0) {
+                    return;  // Stopping and drained
+                }
+                continue;
+            }
+        }
+        --m_queued;
+
+        auto start = std::chrono::steady_clock::now();
+        task();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        self.busyNs.fetch_add(static_cast<uint64_t>(ns.count()), std::memory_order_relaxed);
+        self.tasksRun.fetch_add(1, std::memory_order_relaxed);
+        if (stolen) {
+            self.stolen.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (--m_pending == 0) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_idle.notify_all();
+        }
+    }
+}
+
+std::vector<WorkerStats> ThreadPool::stats() const {
+    std::vector<WorkerStats> result(m_workers.size());
+    for (size_t i = 0; i < m_workers.size(); ++i) {
+        const Worker& worker = *m_workers[i];
+        result[i].node = worker.node;
+        result[i].tasks = worker.tasksRun.load(std::memory_order_relaxed);
+        result[i].stolen = worker.stolen.load(std::memory_order_relaxed);
+        result[i].busySeconds = worker.busyNs.load(std::memory_order_relaxed) * 1e-9;
+    }
+    return result;
+}
+
+void ThreadPool::resetStats() {
+    for (auto& worker : m_workers) {
+        worker->tasksRun = 0;
+        worker->stolen = 0;
+        worker->busyNs = 0;
+    }
+    m_statsStart = std::chrono::steady_clock::now();
+}
+
+double ThreadPool::utilisation() const {
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_statsStart).count();
+    if (wall <= 0.0 || m_workers.empty()) {
+        return 0.0;
+    }
+    double busy = 0.0;
+    for (const auto& worker : stats()) {
+        busy += worker.busySeconds;
+    }
+    return busy / (wall * m_workers.size());
+}
+
+void ThreadPool::printStats(std::ostream& out) const {
+    auto workers = stats();
+    uint64_t tasks = 0;
+    uint64_t stolen = 0;
+    for (const auto& worker : workers) {
+        tasks += worker.tasks;
+        stolen += worker.stolen;
+    }
+    out << "Scheduler: " << workers.size() << " workers on " << nodeCount() << " NUMA node"
+        << (nodeCount() == 1 ? "" : "s") << ", " << tasks << " tasks (" << stolen << " stolen), utilisation "
+        << std::fixed << std::setprecision(1) << utilisation() * 100.0 << "%\n";
+    for (size_t i = 0; i < workers.size(); ++i) {
+        out << "  worker " << std::setw(3) << i << "  node " << workers[i].node
+            << std::setw(8) << workers[i].tasks << " tasks" << std::setw(8) << workers[i].stolen << " stolen"
+            << std::setw(10) << std::setprecision(3) << workers[i].busySeconds << "s busy\n";
+    }
+    out << std::defaultfloat << std::setprecision(6) << std::flush;
+}
+
+TaskGroup::TaskGroup(ThreadPool& pool) : m_pool(pool), m_pending(0) {}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void TaskGroup::submit(std::function<void()> task, int node) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    auto wrapped = [this, task = std::move(task)] {
+        task();
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) {
+            m_done.notify_all();
+        }
+    };
+    if (node >= 0) {
+        m_pool.submit(std::move(wrapped), node);
+    } else {
+        m_pool.submit(std::move(wrapped));
+    }
+}
+
+void TaskGroup::wait() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+}
+
+bool TaskGroup::waitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_done.wait_for(lock, timeout, [this] { return m_pending == 0; });
+}
+
+} // namespace utils
+} // namespace crypto